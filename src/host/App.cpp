@@ -4,6 +4,8 @@
 #include <memory>
 #include <numeric>
 
+#include "ArchiveJsonStream.hpp"
+#include "ReadingsJsonStream.hpp"
 #include "WifiConfigurator.hpp"
 #include "common/MacAddr.hpp"
 #include "common/logger.hpp"
@@ -13,6 +15,8 @@ void App::init()
 {
     logger::init();
     initConfiguration();
+    applyConfiguration();
+    m_readingsStorage.restoreFromLog();
     initPeripherals();
     initWifi();
 }
@@ -34,7 +38,7 @@ void App::update()
             constexpr auto timeoutMs = 3000;
             logger::logWrn("Can't connect to wifi, reboot in 3s");
             m_arduinoAdp->delay(timeoutMs);
-            m_espAdp->restart();
+            restart();
         }
         break;
     case Mode::HOSTING_WIFI_CONFIGURATOR:
@@ -51,9 +55,21 @@ void App::update()
     m_wifiButton.update();
     m_wifiConfigurator.update();
     m_wifiConfigurationTimer.update();
+    m_archiveCompactionTimer.update();
 
+    m_espNow->update();
     m_pairingManager->update();
+    m_confStorage->update();
+    if (m_confStorage->getConfigVersion() != m_appliedConfigVersion)
+    {
+        applyConfiguration();
+    }
     m_ledIndicator->update();
+
+    if (m_restartRequested)
+    {
+        restart();
+    }
 }
 
 void App::startWebWifiConfiguration()
@@ -71,19 +87,27 @@ void App::startWebWifiConfiguration()
         [this](const std::string &ssid, const std::string &pass)
         {
             m_confStorage->setWifiConfig(ssid, pass);
-            m_confStorage->save();
-            m_espAdp->restart();
+            m_confStorage->requestSave();
+            m_restartRequested = true;
         });
 
     m_wifiConfigurationTimer.setCallback(
         [this]
         {
             logger::logInf("Wifi configuration timeout. Reboot...");
-            m_espAdp->restart();
+            restart();
         });
     m_wifiConfigurationTimer.start(m_wifiConfigServerTimeoutMillis);
 }
 
+void App::restart()
+{
+    // Requested configuration and readings waiting for a full batch would be lost otherwise
+    m_confStorage->flush();
+    m_readingsLog->flush();
+    m_espAdp->restart();
+}
+
 void App::initConfiguration()
 {
     logger::logDbg("Loading configuration");
@@ -93,14 +117,21 @@ void App::initConfiguration()
     }
 }
 
+// Settings changed through the web page are picked up by the main loop, which owns the readings
+void App::applyConfiguration()
+{
+    m_appliedConfigVersion = m_confStorage->getConfigVersion();
+    m_readingsStorage.setOutlierThreshold(m_confStorage->getOutlierThreshold());
+}
+
 void App::initPeripherals()
 {
     auto factoryReset = [this]
     {
         logger::logWrn("Reset to factory settings!");
         m_confStorage->setDefault();
-        m_confStorage->save();
-        m_espAdp->restart();
+        m_confStorage->requestSave();
+        restart();
     };
     m_pairAndResetButton.onLongClick(3000, factoryReset);
     m_wifiButton.onClick([this] { startWebWifiConfiguration(); });
@@ -131,17 +162,41 @@ void App::startServices()
 
     m_webPageMain = std::make_unique<WebPageMain>(
         m_arduinoAdp, std::make_shared<WebServer>(m_confStorage->getServerPort()),
-        std::make_unique<Resources>(), m_confStorage);
+        std::make_unique<Resources>(), m_confStorage, esp_random());
 
     auto newReadingCallback = [this](float temp, float hum, IDType identifier)
     {
-        m_readingsStorage.addReading(identifier, temp, hum, m_timeClient->getEpochTime());
+        auto epochTime = m_timeClient->getEpochTime();
+        m_readingsStorage.addReading(identifier, temp, hum, epochTime);
         auto reading = m_readingsStorage.getLastReadingAsJsonStr(identifier);
         m_webPageMain->sendEvent(reading.c_str(), "newReading", m_arduinoAdp->millis());
     };
 
     m_espNow->init(newReadingCallback);
-    m_webPageMain->startServer([this](const std::size_t &identifier)
-                               { return m_readingsStorage.getReadingsAsJsonStr(identifier); });
+    m_webPageMain->startServer(
+        [this](const ReadingsQuery &query)
+        { return m_readingsStorage.getReadings(query); },
+        [this](IDType identifier) { return m_readingsStorage.getStatsAsJsonStr(identifier); },
+        [this](IDType identifier) { return m_readingsStorage.getQuantilesAsJsonStr(identifier); },
+        [this](IDType identifier) { return m_readingsStorage.getHeatmapAsJsonStr(identifier); },
+        [this](const ReadingsQuery &query) -> IWebRequest::Filler
+        {
+            auto stream = std::make_shared<ReadingsJsonStream>(m_readingsStorage, query);
+            return [stream](uint8_t *buffer, std::size_t maxLen)
+            { return stream->fill(buffer, maxLen); };
+        },
+        [this](const ReadingsQuery &query) { return m_readingsStorage.getReadingsETag(query); },
+        [this](const ReadingsQuery &query) -> IWebRequest::Filler
+        {
+            auto stream = std::make_shared<ArchiveJsonStream>(*m_readingsArchive, query);
+            return [stream](uint8_t *buffer, std::size_t maxLen)
+            { return stream->fill(buffer, maxLen); };
+        });
     m_pairAndResetButton.onClick([this] { m_pairingManager->enablePairingForPeriod(); });
+
+    // Closed segments of the readings log are archived a few records per tick, in the background
+    // of normal operation
+    m_archiveCompactionTimer.setCallback(
+        [this] { m_readingsArchive->compact(m_timeClient->getEpochTime()); });
+    m_archiveCompactionTimer.start(m_archiveCompactionPeriodMs, true);
 }
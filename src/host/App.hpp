@@ -4,6 +4,7 @@
 #include <NTPClient.h>
 #include <WiFiUdp.h>
 
+#include <atomic>
 #include <memory>
 
 #include "BoardSettings.hpp"
@@ -12,6 +13,8 @@
 #include "EspNowPairingManager.hpp"
 #include "EspNowServer.hpp"
 #include "LedIndicator.hpp"
+#include "ReadingsArchive.hpp"
+#include "ReadingsLog.hpp"
 #include "ReadingsStorage.hpp"
 #include "Resources.hpp"
 #include "Timer.hpp"
@@ -61,6 +64,7 @@ public:
 
 private:
     void startWebWifiConfiguration();
+    void restart();
 
     constexpr static auto m_wifiConfigServerTimeoutMillis = 1000 * 60 * 3;  // 3 minutes
     constexpr static auto m_resetToFactorySettings = 1000 * 10;             // 10 seconds
@@ -68,6 +72,7 @@ private:
     constexpr static auto m_onErrorWaitBeforeRebootMs = 1000;
     constexpr static auto m_delayBetweenConnectionRetiresMs = 1000;
     constexpr static auto m_connectionRetriesBeforeRebootMs = 10;
+    constexpr static auto m_archiveCompactionPeriodMs = 1000 * 5;  // 5 seconds
 
     Mode m_mode = Mode::INITIALIZATION;
     State m_state = State::INITIALIZATION_BASIC_COMPONENTS;
@@ -83,7 +88,7 @@ private:
     std::shared_ptr<EspNowPairingManager> m_pairingManager{
         std::make_unique<EspNowPairingManager>(m_confStorage, m_arduinoAdp, m_ledIndicator)};
     std::unique_ptr<EspNowServer> m_espNow{std::make_unique<EspNowServer>(
-        std::make_unique<EspNow32Adp>(), m_pairingManager, m_wifiAdp, m_confStorage)};
+        std::make_unique<EspNow32Adp>(), m_pairingManager, m_wifiAdp, m_confStorage, m_arduinoAdp)};
     std::shared_ptr<NTPClient> m_timeClient{std::make_shared<NTPClient>(m_ntpUDP)};
     std::shared_ptr<WifiConfiguratorWebServer> m_webWifiConfig{
         std::make_shared<WifiConfiguratorWebServer>(
@@ -92,16 +97,26 @@ private:
             std::make_unique<Resources>(),
             m_arduinoAdp)};
 
+    std::shared_ptr<ReadingsLog> m_readingsLog{
+        std::make_shared<ReadingsLog>(m_internalFS, "/readings")};
+    std::shared_ptr<ReadingsArchive> m_readingsArchive{
+        std::make_shared<ReadingsArchive>(m_internalFS, m_readingsLog, "/archive-")};
+
     std::unique_ptr<WebPageMain> m_webPageMain{};
     WiFiUDP m_ntpUDP{};
-    ReadingsStorage m_readingsStorage{};
+    ReadingsStorage m_readingsStorage{m_readingsLog};
 
     Button m_wifiButton{m_arduinoAdp, boardSettings::wifiButtonPin};
     Button m_pairAndResetButton{m_arduinoAdp, boardSettings::pairButtonPin};
     Timer m_wifiConfigurationTimer{m_arduinoAdp};
+    Timer m_archiveCompactionTimer{m_arduinoAdp};
     WiFiConfigurator m_wifiConfigurator{m_arduinoAdp, m_wifiAdp};
+    uint32_t m_appliedConfigVersion{0};
+    // Set by web handlers, the main loop owns the log and the configuration writes
+    std::atomic<bool> m_restartRequested{false};
 
     void initConfiguration();
+    void applyConfiguration();
     void initPeripherals();
     void initWifi();
     void startServices();
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+
+#include "CompressedBlock.hpp"
+#include "common/types.hpp"
+
+// Layout of archive files: a day of readings in chunks appended one after another. A chunk is
+// CompressedBlocks, then a sparse index with one entry per block sorted by sensor and time, then
+// a footer. Readers find the last footer at the very end of the file and walk back chunk by chunk.
+// Offsets are relative to the start of the chunk.
+namespace archive_format
+{
+constexpr uint32_t magic = 0x57414854;  // "THAW"
+
+struct IndexEntry
+{
+    IDType identifier;
+    uint32_t firstEpoch;
+    uint32_t lastEpoch;
+    uint32_t offset;
+    uint16_t count;
+    uint16_t bytes;
+};
+
+struct Footer
+{
+    uint32_t magic;
+    uint32_t day;
+    uint32_t entries;
+    uint32_t indexOffset;
+    uint32_t chunkBytes;
+    // Position in the readings log right after the last archived record
+    uint32_t logSequence;
+    uint32_t logRecord;
+};
+
+constexpr std::size_t indexEntrySize
+    = sizeof(uint64_t) + 3 * sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint16_t);
+constexpr std::size_t footerSize = 7 * sizeof(uint32_t);
+
+template <typename T>
+void store(uint8_t *&cursor, T value)
+{
+    std::memcpy(cursor, &value, sizeof(value));
+    cursor += sizeof(value);  // NOLINT
+}
+
+template <typename T>
+T load(const uint8_t *&cursor)
+{
+    T value{};
+    std::memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);  // NOLINT
+    return value;
+}
+
+inline void encode(const IndexEntry &entry, uint8_t *buffer)
+{
+    store(buffer, static_cast<uint64_t>(entry.identifier));
+    store(buffer, entry.firstEpoch);
+    store(buffer, entry.lastEpoch);
+    store(buffer, entry.offset);
+    store(buffer, entry.count);
+    store(buffer, entry.bytes);
+}
+
+inline IndexEntry decodeIndexEntry(const uint8_t *buffer)
+{
+    IndexEntry entry{};
+    entry.identifier = static_cast<IDType>(load<uint64_t>(buffer));
+    entry.firstEpoch = load<uint32_t>(buffer);
+    entry.lastEpoch = load<uint32_t>(buffer);
+    entry.offset = load<uint32_t>(buffer);
+    entry.count = load<uint16_t>(buffer);
+    entry.bytes = load<uint16_t>(buffer);
+    return entry;
+}
+
+inline void encode(const Footer &footer, uint8_t *buffer)
+{
+    store(buffer, footer.magic);
+    store(buffer, footer.day);
+    store(buffer, footer.entries);
+    store(buffer, footer.indexOffset);
+    store(buffer, footer.chunkBytes);
+    store(buffer, footer.logSequence);
+    store(buffer, footer.logRecord);
+}
+
+inline Footer decodeFooter(const uint8_t *buffer)
+{
+    Footer footer{};
+    footer.magic = load<uint32_t>(buffer);
+    footer.day = load<uint32_t>(buffer);
+    footer.entries = load<uint32_t>(buffer);
+    footer.indexOffset = load<uint32_t>(buffer);
+    footer.chunkBytes = load<uint32_t>(buffer);
+    footer.logSequence = load<uint32_t>(buffer);
+    footer.logRecord = load<uint32_t>(buffer);
+    return footer;
+}
+
+// Binary search for the first block of the sensor which ends at or after the range start
+template <typename EntryAt>
+std::size_t firstEntryOf(IDType identifier, uint32_t from, std::size_t entries, EntryAt entryAt)
+{
+    std::size_t lower = 0;
+    std::size_t upper = entries;
+    while (lower < upper)
+    {
+        auto middle = lower + (upper - lower) / 2;
+        auto entry = entryAt(middle);
+        if (entry.identifier < identifier
+            || (entry.identifier == identifier && entry.lastEpoch < from))
+        {
+            lower = middle + 1;
+        }
+        else
+        {
+            upper = middle;
+        }
+    }
+    return lower;
+}
+
+// Visits readings of the block from the closed time range, returns their number
+template <typename ReadCb>
+std::size_t visitBlock(const CompressedBlock::View &block, uint32_t from, uint32_t to,
+                       const ReadCb &readCb)
+{
+    std::size_t visited = 0;
+    for (const auto &reading : block)
+    {
+        if (reading.epochTime > to)
+        {
+            break;
+        }
+
+        if (reading.epochTime >= from)
+        {
+            readCb(reading.epochTime, reading.temperature, reading.humidity);
+            ++visited;
+        }
+    }
+    return visited;
+}
+}  // namespace archive_format
@@ -0,0 +1,92 @@
+#include "ArchiveJsonStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <nlohmann/json.hpp>
+
+ArchiveJsonStream::ArchiveJsonStream(const ReadingsArchive &archive, const ReadingsQuery &query)
+    : m_archive(archive)
+    , m_identifier(query.identifier)
+{
+    // Only the archived days are walked, whatever the requested range
+    auto [first, last] = archive.timeRange();
+    m_next = std::max(query.from.value_or(0), first);
+    m_to = std::min(query.to.value_or(last), last);
+}
+
+std::size_t ArchiveJsonStream::fill(uint8_t *buffer, std::size_t maxLen)
+{
+    std::size_t written = 0;
+    while (written < maxLen)
+    {
+        if (m_pendingOffset == m_pending.size())
+        {
+            if (m_stage == Stage::DONE)
+            {
+                break;
+            }
+            produce();
+            continue;
+        }
+
+        auto len = std::min(maxLen - written, m_pending.size() - m_pendingOffset);
+        std::memcpy(buffer + written, m_pending.data() + m_pendingOffset, len);  // NOLINT
+        m_pendingOffset += len;
+        written += len;
+    }
+    return written;
+}
+
+// Replaces the written text with the next part of the response
+void ArchiveJsonStream::produce()
+{
+    m_pending.clear();
+    m_pendingOffset = 0;
+
+    switch (m_stage)
+    {
+    case Stage::HEADER:
+        m_pending = R"({"identifier":)" + std::to_string(m_identifier) + R"(,"values":[)";
+        m_stage = m_next <= m_to ? Stage::VALUES : Stage::FOOTER;
+        break;
+    case Stage::VALUES:
+        produceValues();
+        break;
+    case Stage::FOOTER:
+        m_pending = "]}";
+        m_stage = Stage::DONE;
+        break;
+    case Stage::DONE:
+        break;
+    }
+}
+
+void ArchiveJsonStream::produceValues()
+{
+    auto append = [this](unsigned long epochTime, float temperature, float humidity)
+    {
+        if (m_read++ != 0)
+        {
+            m_pending += ',';
+        }
+
+        // Hundredths, as they are archived, without the noise of a float widened to a double
+        auto hundredths = [](float value)
+        { return static_cast<double>(CompressedBlock::quantize(value)) / 100; };
+        m_pending += nlohmann::json::array({epochTime, hundredths(temperature),
+                                            hundredths(humidity)})
+                         .dump();
+    };
+
+    for (std::size_t windows = 0; windows < windowsPerProduce && m_pending.empty(); ++windows)
+    {
+        auto windowEnd = m_to - m_next < windowSeconds ? m_to : m_next + windowSeconds - 1;
+        m_archive.read(m_identifier, m_next, windowEnd, append);
+        if (windowEnd == m_to)
+        {
+            m_stage = Stage::FOOTER;
+            return;
+        }
+        m_next = windowEnd + 1;
+    }
+}
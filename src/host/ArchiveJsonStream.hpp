@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ReadingsArchive.hpp"
+#include "ReadingsQuery.hpp"
+
+// Pull-based writer of archived readings of one sensor, as {"identifier":N,"values":[[epoch,
+// temperature,humidity],...]}. The archive is read an hour at a time, so memory stays at an hour
+// of readings whatever the length of the selected range.
+class ArchiveJsonStream
+{
+public:
+    constexpr static unsigned long windowSeconds = 60 * 60;
+    // Bounds the work of a single call when the archive has a long gap
+    constexpr static std::size_t windowsPerProduce = 24;
+
+    ArchiveJsonStream(const ReadingsArchive &archive, const ReadingsQuery &query);
+
+    // Returns the number of bytes written, zero once the whole response was written
+    std::size_t fill(uint8_t *buffer, std::size_t maxLen);
+
+private:
+    enum class Stage
+    {
+        HEADER,
+        VALUES,
+        FOOTER,
+        DONE
+    };
+
+    const ReadingsArchive &m_archive;
+    IDType m_identifier;
+    unsigned long m_next;
+    unsigned long m_to;
+    std::size_t m_read{0};
+    Stage m_stage{Stage::HEADER};
+    std::string m_pending;
+    std::size_t m_pendingOffset{0};
+
+    void produce();
+    void produceValues();
+};
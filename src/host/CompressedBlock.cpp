@@ -0,0 +1,309 @@
+#include "CompressedBlock.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr std::size_t bitsInByte = 8;
+constexpr std::size_t epochBits = 32;
+constexpr std::size_t rawValueBits = 16;
+constexpr auto centiPerUnit = 100.0F;
+
+// Prefix code classes: '0' means no change, then '10', '110', '1110' with a small payload and
+// '1111' with a full-width payload
+struct CodeClass
+{
+    uint32_t prefix;
+    std::size_t prefixBits;
+    std::size_t payloadBits;
+};
+
+// Payload widths are tuned for sensors reporting in a steady period with a few seconds of jitter
+// and values changing by a few hundredths between readings
+constexpr std::array<CodeClass, 3> timestampClasses{
+    {{0b10, 2, 4}, {0b110, 3, 9}, {0b1110, 4, 12}}};
+constexpr std::array<CodeClass, 3> valueClasses{{{0b10, 2, 3}, {0b110, 3, 6}, {0b1110, 4, 10}}};
+constexpr uint32_t fallbackPrefix = 0b1111;
+constexpr std::size_t fallbackPrefixBits = 4;
+
+bool fitsInBits(int64_t value, std::size_t bits)
+{
+    const auto limit = int64_t{1} << (bits - 1);
+    return value >= -limit && value < limit;
+}
+
+int32_t signExtend(uint32_t value, std::size_t bits)
+{
+    const auto signBit = uint32_t{1} << (bits - 1);
+    return static_cast<int32_t>((value ^ signBit) - signBit);
+}
+
+uint32_t lowBits(int32_t value, std::size_t bits)
+{
+    return static_cast<uint32_t>(value) & ((uint64_t{1} << bits) - 1);
+}
+}  // namespace
+
+CompressedBlock::Iterator::Iterator(const uint8_t *data, uint16_t count, uint16_t index)
+    : m_data(data)
+    , m_count(count)
+    , m_index(index)
+{
+    if (m_index < m_count)
+    {
+        decodeCurrent();
+    }
+}
+
+CompressedBlock::Iterator &CompressedBlock::Iterator::operator++()
+{
+    ++m_index;
+    if (m_index < m_count)
+    {
+        decodeCurrent();
+    }
+    return *this;
+}
+
+CompressedBlock::Iterator CompressedBlock::Iterator::operator++(int)
+{
+    Iterator tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+void CompressedBlock::Iterator::decodeCurrent()
+{
+    if (m_index == 0)
+    {
+        m_current.epochTime = readBits(m_data, m_bitPos, epochBits);
+        m_temperature = static_cast<int16_t>(readBits(m_data, m_bitPos, rawValueBits));
+        m_humidity = static_cast<int16_t>(readBits(m_data, m_bitPos, rawValueBits));
+    }
+    else
+    {
+        m_delta += readTimestamp(m_data, m_bitPos);
+        m_current.epochTime += m_delta;
+        m_temperature = readValue(m_data, m_bitPos, m_temperature);
+        m_humidity = readValue(m_data, m_bitPos, m_humidity);
+    }
+
+    m_current.temperature = dequantize(m_temperature);
+    m_current.humidity = dequantize(m_humidity);
+}
+
+bool CompressedBlock::append(uint32_t epochTime, float temperature, float humidity)
+{
+    auto quantizedTemperature = quantize(temperature);
+    auto quantizedHumidity = quantize(humidity);
+
+    if (m_count == 0)
+    {
+        writeBits(epochTime, epochBits);
+        writeBits(static_cast<uint16_t>(quantizedTemperature), rawValueBits);
+        writeBits(static_cast<uint16_t>(quantizedHumidity), rawValueBits);
+        m_firstEpoch = epochTime;
+    }
+    else
+    {
+        auto delta = static_cast<int64_t>(epochTime) - m_lastEpoch;
+        auto deltaOfDelta = delta - m_lastDelta;
+        auto temperatureDelta = int32_t{quantizedTemperature} - m_lastTemperature;
+        auto humidityDelta = int32_t{quantizedHumidity} - m_lastHumidity;
+
+        auto requiredBits = timestampBits(deltaOfDelta) + valueBits(temperatureDelta)
+                            + valueBits(humidityDelta);
+        if (m_bitPos + requiredBits > capacityBits || !fitsInBits(deltaOfDelta, epochBits))
+        {
+            return false;
+        }
+
+        writeTimestamp(static_cast<int32_t>(deltaOfDelta));
+        writeValue(temperatureDelta, quantizedTemperature);
+        writeValue(humidityDelta, quantizedHumidity);
+        m_lastDelta = static_cast<int32_t>(delta);
+    }
+
+    ++m_count;
+    m_lastEpoch = epochTime;
+    m_lastTemperature = quantizedTemperature;
+    m_lastHumidity = quantizedHumidity;
+    return true;
+}
+
+void CompressedBlock::clear()
+{
+    *this = CompressedBlock();
+}
+
+CompressedBlock::Iterator CompressedBlock::begin() const
+{
+    return {m_data.data(), m_count, 0};
+}
+
+CompressedBlock::Iterator CompressedBlock::end() const
+{
+    return {m_data.data(), m_count, m_count};
+}
+
+int16_t CompressedBlock::quantize(float value)
+{
+    constexpr long limit = std::numeric_limits<int16_t>::max();
+    return static_cast<int16_t>(std::clamp(std::lround(value * centiPerUnit), -limit, limit));
+}
+
+float CompressedBlock::dequantize(int16_t value)
+{
+    return static_cast<float>(value) / centiPerUnit;
+}
+
+std::size_t CompressedBlock::timestampBits(int64_t deltaOfDelta)
+{
+    if (deltaOfDelta == 0)
+    {
+        return 1;
+    }
+
+    for (const auto &codeClass : timestampClasses)
+    {
+        if (fitsInBits(deltaOfDelta, codeClass.payloadBits))
+        {
+            return codeClass.prefixBits + codeClass.payloadBits;
+        }
+    }
+    return fallbackPrefixBits + epochBits;
+}
+
+std::size_t CompressedBlock::valueBits(int32_t delta)
+{
+    if (delta == 0)
+    {
+        return 1;
+    }
+
+    for (const auto &codeClass : valueClasses)
+    {
+        if (fitsInBits(delta, codeClass.payloadBits))
+        {
+            return codeClass.prefixBits + codeClass.payloadBits;
+        }
+    }
+    return fallbackPrefixBits + rawValueBits;
+}
+
+void CompressedBlock::writeBits(uint32_t value, std::size_t bits)
+{
+    while (bits > 0)
+    {
+        auto bitOffset = m_bitPos % bitsInByte;
+        auto freeBits = bitsInByte - bitOffset;
+        auto bitsToWrite = std::min(freeBits, bits);
+        auto chunk = (value >> (bits - bitsToWrite)) & ((1U << bitsToWrite) - 1);
+
+        m_data[m_bitPos / bitsInByte] |= static_cast<uint8_t>(chunk << (freeBits - bitsToWrite));
+        m_bitPos += bitsToWrite;
+        bits -= bitsToWrite;
+    }
+}
+
+void CompressedBlock::writeTimestamp(int32_t deltaOfDelta)
+{
+    if (deltaOfDelta == 0)
+    {
+        writeBits(0, 1);
+        return;
+    }
+
+    for (const auto &codeClass : timestampClasses)
+    {
+        if (fitsInBits(deltaOfDelta, codeClass.payloadBits))
+        {
+            writeBits(codeClass.prefix, codeClass.prefixBits);
+            writeBits(lowBits(deltaOfDelta, codeClass.payloadBits), codeClass.payloadBits);
+            return;
+        }
+    }
+
+    writeBits(fallbackPrefix, fallbackPrefixBits);
+    writeBits(static_cast<uint32_t>(deltaOfDelta), epochBits);
+}
+
+void CompressedBlock::writeValue(int32_t delta, int16_t value)
+{
+    if (delta == 0)
+    {
+        writeBits(0, 1);
+        return;
+    }
+
+    for (const auto &codeClass : valueClasses)
+    {
+        if (fitsInBits(delta, codeClass.payloadBits))
+        {
+            writeBits(codeClass.prefix, codeClass.prefixBits);
+            writeBits(lowBits(delta, codeClass.payloadBits), codeClass.payloadBits);
+            return;
+        }
+    }
+
+    // Big jumps store the value itself, so the delta never overflows 16 bits
+    writeBits(fallbackPrefix, fallbackPrefixBits);
+    writeBits(static_cast<uint16_t>(value), rawValueBits);
+}
+
+uint32_t CompressedBlock::readBits(const uint8_t *data, std::size_t &bitPos, std::size_t bits)
+{
+    uint32_t value = 0;
+    while (bits > 0)
+    {
+        auto bitOffset = bitPos % bitsInByte;
+        auto availableBits = bitsInByte - bitOffset;
+        auto bitsToRead = std::min(availableBits, bits);
+        auto chunk = (data[bitPos / bitsInByte] >> (availableBits - bitsToRead))
+                     & ((1U << bitsToRead) - 1);
+
+        value = (value << bitsToRead) | chunk;
+        bitPos += bitsToRead;
+        bits -= bitsToRead;
+    }
+    return value;
+}
+
+int32_t CompressedBlock::readTimestamp(const uint8_t *data, std::size_t &bitPos)
+{
+    if (readBits(data, bitPos, 1) == 0)
+    {
+        return 0;
+    }
+
+    for (const auto &codeClass : timestampClasses)
+    {
+        if (readBits(data, bitPos, 1) == 0)
+        {
+            auto payload = readBits(data, bitPos, codeClass.payloadBits);
+            return signExtend(payload, codeClass.payloadBits);
+        }
+    }
+    return static_cast<int32_t>(readBits(data, bitPos, epochBits));
+}
+
+int16_t CompressedBlock::readValue(const uint8_t *data, std::size_t &bitPos, int16_t previous)
+{
+    if (readBits(data, bitPos, 1) == 0)
+    {
+        return previous;
+    }
+
+    for (const auto &codeClass : valueClasses)
+    {
+        if (readBits(data, bitPos, 1) == 0)
+        {
+            auto payload = readBits(data, bitPos, codeClass.payloadBits);
+            auto delta = signExtend(payload, codeClass.payloadBits);
+            return static_cast<int16_t>(previous + delta);
+        }
+    }
+    return static_cast<int16_t>(readBits(data, bitPos, rawValueBits));
+}
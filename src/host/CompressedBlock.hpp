@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <iterator>
+
+// Fixed-size block of readings compressed in the spirit of Facebook's Gorilla: timestamps are
+// stored as delta-of-delta and values (quantized to hundredths) as deltas from the previous one,
+// both with variable-length prefix codes. Readings are decoded on the fly while iterating.
+class CompressedBlock
+{
+public:
+    constexpr static std::size_t blockBytes = 256;
+
+    struct Reading
+    {
+        uint32_t epochTime;
+        float temperature;
+        float humidity;
+    };
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Reading;
+        using pointer = const Reading *;
+        using reference = const Reading &;
+
+        Iterator(const uint8_t *data, uint16_t count, uint16_t index);
+
+        reference operator*() const
+        {
+            return m_current;
+        }
+
+        pointer operator->() const
+        {
+            return &m_current;
+        }
+
+        Iterator &operator++();
+        Iterator operator++(int);
+
+        friend bool operator==(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.m_index == rhs.m_index;
+        }
+
+        friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.m_index != rhs.m_index;
+        }
+
+    private:
+        const uint8_t *m_data;
+        uint16_t m_count;
+        uint16_t m_index;
+        std::size_t m_bitPos{0};
+        int32_t m_delta{0};
+        int16_t m_temperature{0};
+        int16_t m_humidity{0};
+        Reading m_current{};
+
+        void decodeCurrent();
+    };
+
+    bool append(uint32_t epochTime, float temperature, float humidity);
+    void clear();
+
+    [[nodiscard]] uint16_t size() const
+    {
+        return m_count;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_count == 0;
+    }
+
+    [[nodiscard]] uint32_t firstEpoch() const
+    {
+        return m_firstEpoch;
+    }
+
+    [[nodiscard]] uint32_t lastEpoch() const
+    {
+        return m_lastEpoch;
+    }
+
+    [[nodiscard]] std::size_t usedBits() const
+    {
+        return m_bitPos;
+    }
+
+    // Read-only view of a serialized block, decoded in place
+    class View
+    {
+    public:
+        View(const uint8_t *data, uint16_t count)
+            : m_data(data)
+            , m_count(count)
+        {
+        }
+
+        [[nodiscard]] Iterator begin() const
+        {
+            return {m_data, m_count, 0};
+        }
+
+        [[nodiscard]] Iterator end() const
+        {
+            return {m_data, m_count, m_count};
+        }
+
+    private:
+        const uint8_t *m_data;
+        uint16_t m_count;
+    };
+
+    // The serialized form is the used part of the bit stream, the readings count is kept aside
+    [[nodiscard]] const uint8_t *data() const
+    {
+        return m_data.data();
+    }
+
+    [[nodiscard]] std::size_t usedBytes() const
+    {
+        return (m_bitPos + 7) / 8;
+    }
+
+    [[nodiscard]] Iterator begin() const;
+    [[nodiscard]] Iterator end() const;
+
+    static int16_t quantize(float value);
+    static float dequantize(int16_t value);
+
+private:
+    constexpr static std::size_t capacityBits = blockBytes * 8;
+
+    std::array<uint8_t, blockBytes> m_data{};
+    std::size_t m_bitPos{0};
+    uint16_t m_count{0};
+    uint32_t m_firstEpoch{0};
+    uint32_t m_lastEpoch{0};
+    int32_t m_lastDelta{0};
+    int16_t m_lastTemperature{0};
+    int16_t m_lastHumidity{0};
+
+    static std::size_t timestampBits(int64_t deltaOfDelta);
+    static std::size_t valueBits(int32_t delta);
+    void writeBits(uint32_t value, std::size_t bits);
+    void writeTimestamp(int32_t deltaOfDelta);
+    void writeValue(int32_t delta, int16_t value);
+    static uint32_t readBits(const uint8_t *data, std::size_t &bitPos, std::size_t bits);
+    static int32_t readTimestamp(const uint8_t *data, std::size_t &bitPos);
+    static int16_t readValue(const uint8_t *data, std::size_t &bitPos, int16_t previous);
+};
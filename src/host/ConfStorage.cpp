@@ -21,6 +21,7 @@ ConfStorage::State ConfStorage::load()
     try
     {
         m_jsonData = nlohmann::json::parse(data);
+        changed(true);
     }
     catch (nlohmann::json::parse_error err)
     {
@@ -33,18 +34,92 @@ ConfStorage::State ConfStorage::load()
 
 ConfStorage::State ConfStorage::save()
 {
-    auto file = m_fileSystem->open(m_path, IFileSystem32Adp::Mode::F_WRITE);
+    auto data = serialize();
+    if (!data.has_value())
+    {
+        return State::FAIL;
+    }
+
+    {
+        // A pending copy is older than the one being written
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingData.reset();
+    }
+
+    return write(data.value());
+}
+
+void ConfStorage::requestSave()
+{
+    auto data = serialize();
+    if (!data.has_value())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pendingData = std::move(data);
+}
+
+ConfStorage::State ConfStorage::flush()
+{
+    std::optional<std::string> data;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        data.swap(m_pendingData);
+    }
+
+    if (!data.has_value())
+    {
+        return State::OK;
+    }
+
+    auto state = write(data.value());
+    if (state == State::FAIL)
+    {
+        // Retried on the next update unless a newer copy was requested in the meantime
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        if (!m_pendingData.has_value())
+        {
+            m_pendingData = std::move(data);
+        }
+    }
+    return state;
+}
+
+void ConfStorage::update()
+{
+    flush();
+}
+
+std::optional<std::string> ConfStorage::serialize() const
+{
     try
     {
-        auto data = m_jsonData.dump();
-        file->print(data);
+        return m_jsonData.dump();
     }
     catch (nlohmann::json::type_error err)
     {
         logger::logErr("Can't dump json data of configuration file, %s", err.what());
+        return std::nullopt;
+    }
+}
+
+ConfStorage::State ConfStorage::write(const std::string &data)
+{
+    auto file = m_fileSystem->open(m_path, IFileSystem32Adp::Mode::F_WRITE);
+    if (file == nullptr)
+    {
+        logger::logErr("Can't open configuration file %s", m_path);
         return State::FAIL;
     }
 
+    if (auto written = file->print(data); written != data.size())
+    {
+        logger::logErr("Configuration file written partially, %u of %u bytes",
+                       static_cast<unsigned>(written), static_cast<unsigned>(data.size()));
+        return State::FAIL;
+    }
     return State::OK;
 }
 
@@ -58,11 +133,13 @@ void ConfStorage::setDefault()
     defaultData["sensorUpdatePeriodMins"] = defaultSensorUpdateMins;
 
     m_jsonData = defaultData;
+    changed(true);
 }
 
 void ConfStorage::setSensorUpdatePeriodMins(uint16_t minutes)
 {
     m_jsonData["sensorUpdatePeriodMins"] = minutes;
+    changed();
 }
 
 uint16_t ConfStorage::getSensorUpdatePeriodMins() const
@@ -73,6 +150,7 @@ uint16_t ConfStorage::getSensorUpdatePeriodMins() const
 void ConfStorage::setServerPort(std::size_t port)
 {
     m_jsonData["serverPort"] = port;
+    changed();
 }
 
 std::size_t ConfStorage::getServerPort() const
@@ -80,10 +158,28 @@ std::size_t ConfStorage::getServerPort() const
     return m_jsonData["serverPort"];
 }
 
+void ConfStorage::setOutlierThreshold(float threshold)
+{
+    m_jsonData["outlierThreshold"] = threshold;
+    changed();
+}
+
+float ConfStorage::getOutlierThreshold() const
+{
+    // Configuration files written before the filter existed don't have it
+    auto threshold = m_jsonData.find("outlierThreshold");
+    if (threshold == m_jsonData.end() || !threshold->is_number())
+    {
+        return defaultOutlierThreshold;
+    }
+    return threshold->get<float>();
+}
+
 void ConfStorage::setWifiConfig(const std::string &ssid, const std::string &pass)
 {
     m_jsonData["wifi"]["ssid"] = ssid;
     m_jsonData["wifi"]["pass"] = pass;
+    changed();
 }
 
 std::optional<std::pair<std::string, std::string>> ConfStorage::getWifiConfig()
@@ -107,6 +203,7 @@ void ConfStorage::setAdminCredentials(const std::string &user, const std::string
 {
     m_jsonData["admin"]["user"] = user;
     m_jsonData["admin"]["pass"] = pass;
+    changed();
 }
 
 std::optional<std::pair<std::string, std::string>> ConfStorage::getAdminCredentials() const
@@ -128,7 +225,8 @@ std::string ConfStorage::getConfigWithoutCredentials() const
     nlohmann::json dataWithoutCred
         = {{"sensorUpdatePeriodMins", m_jsonData["sensorUpdatePeriodMins"]},
            {"sensors", m_jsonData["sensors"]},
-           {"serverPort", m_jsonData["serverPort"]}};
+           {"serverPort", m_jsonData["serverPort"]},
+           {"outlierThreshold", getOutlierThreshold()}};
 
     return dataWithoutCred.dump();
 }
@@ -166,6 +264,7 @@ bool ConfStorage::addSensor(IDType identifier, const std::string &name)
     if (isAvailableSpaceForNextSensor())
     {
         m_jsonData["sensors"][std::to_string(identifier)] = newSensorName;
+        changed(true);
         return true;
     }
 
@@ -180,6 +279,7 @@ bool ConfStorage::removeSensor(IDType identifier)
     if (toRemove != end)
     {
         m_jsonData["sensors"].erase(toRemove);
+        changed(true);
         return true;
     }
 
@@ -191,6 +291,26 @@ std::string ConfStorage::getSensorsMapping() const
     return m_jsonData["sensors"].dump();
 }
 
+uint32_t ConfStorage::getConfigVersion() const
+{
+    return m_configVersion.load(std::memory_order_relaxed);
+}
+
+uint32_t ConfStorage::getSensorsVersion() const
+{
+    return m_sensorsVersion.load(std::memory_order_relaxed);
+}
+
+// The mapping is a part of the configuration, so its changes move both versions
+void ConfStorage::changed(bool sensorsChanged)
+{
+    m_configVersion.fetch_add(1, std::memory_order_relaxed);
+    if (sensorsChanged)
+    {
+        m_sensorsVersion.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 bool ConfStorage::isSensorMapped(IDType identifier)
 {
     auto sensorIt = m_jsonData["sensors"].find(std::to_string(identifier));
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <optional>
+#include <string>
 
 #include "IConfStorage.hpp"
 #include "adapters/IFileSystem32Adp.hpp"
@@ -17,6 +20,11 @@ public:
 
     State load() override;
     State save() override;
+    void requestSave() override;
+    State flush() override;
+
+    // Writes requested saves, called from the main loop
+    void update();
 
     void setDefault();
 
@@ -24,6 +32,8 @@ public:
     [[nodiscard]] uint16_t getSensorUpdatePeriodMins() const override;
     void setServerPort(std::size_t port) override;
     [[nodiscard]] std::size_t getServerPort() const override;
+    void setOutlierThreshold(float threshold) override;
+    [[nodiscard]] float getOutlierThreshold() const override;
     void setWifiConfig(const std::string &ssid, const std::string &pass) override;
     std::optional<std::pair<std::string, std::string>> getWifiConfig() override;
     void setAdminCredentials(const std::string &user, const std::string &pass) override;
@@ -36,15 +46,32 @@ public:
     bool addSensor(IDType identifier, const std::string &name = "") override;
     bool removeSensor(IDType identifier) override;
     [[nodiscard]] std::string getSensorsMapping() const override;
+    [[nodiscard]] uint32_t getConfigVersion() const override;
+    [[nodiscard]] uint32_t getSensorsVersion() const override;
     bool isSensorMapped(IDType identifier) override;
 
-private:
-    // Limited because of space for readings
+    // Limited because of space for readings, see ReadingsStorage::sensorsHeapBudget
     constexpr static auto maxSensorsNum = 7;
+
+private:
     constexpr static auto defaultSrvPortNumber = 80;
     constexpr static auto defaultSensorUpdateMins = 1;
+    constexpr static auto defaultOutlierThreshold = 3.0F;
 
     nlohmann::json m_jsonData{};
     std::shared_ptr<IFileSystem32Adp> m_fileSystem;
     std::string m_path;
+
+    // Latest requested copy, requests arriving before it is written replace it. Requests come from
+    // other tasks, the mutex is held only to swap the copy, never during a write.
+    std::mutex m_pendingMutex;
+    std::optional<std::string> m_pendingData;
+
+    // Read by web handlers on the server task
+    std::atomic<uint32_t> m_configVersion{0};
+    std::atomic<uint32_t> m_sensorsVersion{0};
+
+    [[nodiscard]] std::optional<std::string> serialize() const;
+    State write(const std::string &data);
+    void changed(bool sensorsChanged = false);
 };
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crc32
+{
+// CRC-32 (IEEE 802.3), bitwise variant - records are short, so no lookup table is kept in RAM
+inline uint32_t calculate(const uint8_t *data, std::size_t size, uint32_t crc = 0)
+{
+    constexpr uint32_t polynomial = 0xEDB88320;
+
+    crc = ~crc;
+    for (std::size_t idx = 0; idx < size; ++idx)
+    {
+        crc ^= data[idx];  // NOLINT
+        for (auto bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ (polynomial & (0U - (crc & 1U)));
+        }
+    }
+
+    return ~crc;
+}
+}  // namespace crc32
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cinttypes>
+#include <optional>
+
+#include "P2Quantile.hpp"
+#include "Quantization.hpp"
+#include "RingBuffer.hpp"
+
+// Percentiles of one day of readings, quantized to hundredths like rollup buckets
+struct QuantilesDay
+{
+    struct Metric
+    {
+        int16_t p5;
+        int16_t p50;
+        int16_t p95;
+    };
+
+    uint32_t startEpoch;
+    uint32_t count;
+    Metric temperature;
+    Metric humidity;
+};
+
+// Median, 5th and 95th percentile of temperature and humidity per UTC day. The day in progress is
+// estimated by P-squared markers, finished days are kept as 20 byte summaries.
+template <uint16_t daysNum>
+class DailyQuantiles
+{
+public:
+    constexpr static uint32_t secondsPerDay = 24 * 60 * 60;
+
+    void add(float temperature, float humidity, unsigned long epochTime)
+    {
+        auto dayStart = static_cast<uint32_t>(epochTime - epochTime % secondsPerDay);
+        if (m_current.count() != 0 && dayStart != m_currentStart)
+        {
+            m_days.put(m_current.toDay(m_currentStart));
+            m_current = {};
+        }
+
+        m_currentStart = dayStart;
+        m_current.add(temperature, humidity);
+    }
+
+    // Calls fun for every finished day and finally for the day in progress
+    template <typename Fun>
+    void forEach(Fun fun) const
+    {
+        for (const auto &day : m_days)
+        {
+            fun(day);
+        }
+
+        if (m_current.count() != 0)
+        {
+            fun(m_current.toDay(m_currentStart));
+        }
+    }
+
+private:
+    struct MetricEstimators
+    {
+        P2Quantile<5> p5;
+        P2Quantile<50> p50;
+        P2Quantile<95> p95;
+
+        void add(float value)
+        {
+            p5.add(value);
+            p50.add(value);
+            p95.add(value);
+        }
+
+        template <typename Quantize>
+        QuantilesDay::Metric toMetric(Quantize quantize) const
+        {
+            return {static_cast<int16_t>(quantize(p5.value().value_or(0))),
+                    static_cast<int16_t>(quantize(p50.value().value_or(0))),
+                    static_cast<int16_t>(quantize(p95.value().value_or(0)))};
+        }
+    };
+
+    struct DayEstimators
+    {
+        MetricEstimators temperature;
+        MetricEstimators humidity;
+
+        void add(float temperatureValue, float humidityValue)
+        {
+            temperature.add(temperatureValue);
+            humidity.add(humidityValue);
+        }
+
+        [[nodiscard]] uint32_t count() const
+        {
+            return temperature.p50.count();
+        }
+
+        [[nodiscard]] QuantilesDay toDay(uint32_t startEpoch) const
+        {
+            return {startEpoch, count(),
+                    temperature.toMetric(quantization::toCentiTemperature),
+                    humidity.toMetric(quantization::toCentiHumidity)};
+        }
+    };
+
+    RingBuffer<QuantilesDay, daysNum> m_days;
+    DayEstimators m_current;
+    uint32_t m_currentStart{0};
+};
@@ -68,7 +68,7 @@ bool EspNowPairingManager::addNewSensorToStorage(IDType identifier)
 
     logger::logInf("Paired sensor with ID: %u", identifier);
     m_confStorage->addSensor(identifier);
-    m_confStorage->save();
+    m_unsavedPairings = true;
 
     return true;
 }
@@ -81,4 +81,10 @@ void EspNowPairingManager::unpairSensor(IDType identifier)
 void EspNowPairingManager::update()
 {
     m_pairingTimer.update();
+
+    if (!m_pairingEnabled && m_unsavedPairings)
+    {
+        m_confStorage->requestSave();
+        m_unsavedPairings = false;
+    }
 }
@@ -30,5 +30,7 @@ private:
     std::shared_ptr<LedIndicator> m_pairingLed;
 
     bool m_pairingEnabled = false;
+    // Sensors paired in one window are saved together once it closes
+    bool m_unsavedPairings = false;
     Timer m_pairingTimer;
 };
@@ -1,6 +1,8 @@
 #include "EspNowServer.hpp"
 
+#include <algorithm>
 #include <array>
+#include <utility>
 
 #include "common/Messages.hpp"
 #include "common/logger.hpp"
@@ -13,11 +15,13 @@ constexpr std::array<uint8_t, macSize> broadcastAddress{0xFF, 0xFF, 0xFF, 0xFF,
 EspNowServer::EspNowServer(std::unique_ptr<IEspNow32Adp> espNowAdp,
                            const std::shared_ptr<EspNowPairingManager> &pairingManager,
                            const std::shared_ptr<IWifi32Adp> &wifiAdp,
-                           const std::shared_ptr<IConfStorage> &confStorage)
+                           const std::shared_ptr<IConfStorage> &confStorage,
+                           const std::shared_ptr<IArduino32Adp> &arduinoAdp)
     : m_espNowAdp(std::move(espNowAdp))
     , m_pairingManager(pairingManager)
     , m_wifiAdp(wifiAdp)
     , m_confStorage(confStorage)
+    , m_arduinoAdp(arduinoAdp)
 {
 }
 
@@ -39,8 +43,114 @@ void EspNowServer::deinit()
     m_espNowAdp->deinit();
 }
 
+void EspNowServer::update()
+{
+    updateRateLimit();
+    if (!m_frames.empty() || m_handshakesNum != 0)
+    {
+        const auto nowMs = static_cast<uint32_t>(m_arduinoAdp->millis());
+        if (!m_frames.empty())
+        {
+            m_frames.consume([this, nowMs](const Frame &frame) { processFrame(frame, nowMs); },
+                             framesPerUpdate);
+        }
+        updateHandshakes(nowMs);
+    }
+    else
+    {
+        // Nothing waits for them, they would only take places of statuses of the next handshakes
+        m_sendStatuses.consume([](const SendStatus &) {});
+    }
+
+    auto dropped = m_droppedFrames.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDrops)
+    {
+        logger::logWrn("Ingest queue full, dropped %u frames so far", dropped);
+        m_reportedDrops = dropped;
+    }
+
+    // Logged outside of the lock, the receive callback must not wait for the serial port
+    std::array<std::pair<MacAddr, uint32_t>, rateLimitedSendersNum + 1> throttled{};
+    std::size_t throttledNum = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_rateLimiterMutex);
+        m_rateLimiter.reportThrottled(
+            [&throttled, &throttledNum](const auto &sender)
+            { throttled[throttledNum++] = {sender.mac, sender.throttled}; });
+    }
+    for (std::size_t idx = 0; idx < throttledNum; ++idx)
+    {
+        logger::logWrn("Sender %s over its rate, throttled %u frames so far",
+                       throttled[idx].first.str().c_str(), throttled[idx].second);
+    }
+}
+
+void EspNowServer::updateRateLimit()
+{
+    // Transmitters keep the period they were paired with, so a longer one applies only to those
+    // paired later. Until then the shortest period handed out since boot sets the rate.
+    constexpr uint32_t msInMinute = 60 * 1000;
+    const auto periodMins = m_confStorage->getSensorUpdatePeriodMins();
+    m_ratePeriodMins = std::min(m_ratePeriodMins.value_or(periodMins), periodMins);
+    const uint32_t periodMs = *m_ratePeriodMins * msInMinute;
+    std::lock_guard<std::mutex> lock(m_rateLimiterMutex);
+    m_rateLimiter.setRate(periodMs / framesPerUpdatePeriod, framesBurst);
+}
+
+EspNowServer::IngestStats EspNowServer::ingestStats() const
+{
+    std::lock_guard<std::mutex> lock(m_rateLimiterMutex);
+    return {m_receivedFrames.load(std::memory_order_relaxed),
+            m_droppedFrames.load(std::memory_order_relaxed),
+            m_oversizedFrames.load(std::memory_order_relaxed),
+            m_rateLimiter.throttledTotal()};
+}
+
+uint32_t EspNowServer::throttledFrames(const MacAddr &mac) const
+{
+    std::lock_guard<std::mutex> lock(m_rateLimiterMutex);
+    return m_rateLimiter.throttled(mac);
+}
+
 void EspNowServer::onDataRecv(const MacAddr &mac, const uint8_t *incomingData, int len)
 {
+    // Runs in the Wi-Fi driver task, so the frame is only copied and processed later by update.
+    // Frames over the rate of their sender are dropped here and don't take a place in the queue.
+    m_receivedFrames.fetch_add(1, std::memory_order_relaxed);
+    if (len < 0 || static_cast<std::size_t>(len) > maxFrameSize)
+    {
+        m_oversizedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    {
+        const auto nowMs = static_cast<uint32_t>(m_arduinoAdp->millis());
+        std::lock_guard<std::mutex> lock(m_rateLimiterMutex);
+        if (!m_rateLimiter.admit(mac, nowMs))
+        {
+            return;
+        }
+    }
+
+    auto queued = m_frames.pushWith(
+        [&mac, incomingData, len](Frame &frame)
+        {
+            frame.mac = mac;
+            frame.length = static_cast<uint8_t>(len);
+            std::copy_n(incomingData, len, frame.data.begin());
+        });
+    if (!queued)
+    {
+        m_droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void EspNowServer::processFrame(const Frame &frame, uint32_t nowMs)
+{
+    const auto &mac = frame.mac;
+    const auto *incomingData = frame.data.data();
+    const auto len = frame.length;
+
     auto msgAndSignature = serializer::partialDeserialize<MsgType, Signature>(incomingData, len);
 
     if (!msgAndSignature)
@@ -68,12 +178,7 @@ void EspNowServer::onDataRecv(const MacAddr &mac, const uint8_t *incomingData, i
             logger::logDbg("PAIR_REQ received");
             PairReqMsg pairReqMsg;
             pairReqMsg.deserialize(incomingData, len);
-            m_pairingManager->addNewSensorToStorage(pairReqMsg.ID);
-
-            logger::logInf("Paired sensor: %u", pairReqMsg.ID);
-            m_espNowAdp->addPeer(mac, m_wifiAdp->getChannel());
-            sendPairOK(mac);
-            m_espNowAdp->deletePeer(mac);
+            queueHandshake(mac, pairReqMsg.ID, nowMs);
         }
         else
         {
@@ -104,17 +209,160 @@ void EspNowServer::onDataRecv(const MacAddr &mac, const uint8_t *incomingData, i
     }
 }
 
-void EspNowServer::onDataSend(const MacAddr &mac, IEspNow32Adp::Status status)
+void EspNowServer::queueHandshake(const MacAddr &mac, IDType identifier, uint32_t nowMs)
+{
+    auto end = m_handshakes.begin() + m_handshakesNum;
+    if (std::any_of(m_handshakes.begin(), end,
+                    [&mac](const Handshake &handshake) { return handshake.mac == mac; }))
+    {
+        logger::logDbg("Pairing of %u already in progress", identifier);
+        return;
+    }
+
+    if (m_handshakesNum == pendingHandshakesNum)
+    {
+        logger::logWrn("Too many pending pairings, request of %u dropped", identifier);
+        return;
+    }
+
+    m_handshakes[m_handshakesNum++] = {mac, identifier, nowMs, nowMs, 0, false, 0};
+}
+
+void EspNowServer::updateHandshakes(uint32_t nowMs)
 {
-    logger::logDbg("Last Packet Send Status: ");
-    if (status == IEspNow32Adp::Status::OK)
+    m_sendStatuses.consume([this, nowMs](const SendStatus &sendStatus)
+                           { onHandshakeStatus(sendStatus, nowMs); });
+
+    auto inFlight = static_cast<std::size_t>(
+        std::count_if(m_handshakes.begin(), m_handshakes.begin() + m_handshakesNum,
+                      [](const Handshake &handshake) { return handshake.inFlight; }));
+
+    // Oldest requests first, the queue keeps arrival order
+    for (std::size_t idx = 0; idx < m_handshakesNum;)
     {
-        logger::logDbg("Delivery success: %s", mac.str());
+        auto &handshake = m_handshakes[idx];
+        if (handshake.inFlight && nowMs - handshake.attemptMs >= pairRespStatusTimeoutMs)
+        {
+            --inFlight;
+            failAttempt(handshake, nowMs);
+        }
+
+        if (handshake.inFlight)
+        {
+            ++idx;
+            continue;
+        }
+
+        const bool expired = handshake.attempts == pairRespAttempts
+                             || nowMs - handshake.receivedMs >= pairReqValidityMs;
+        if (expired)
+        {
+            logger::logWrn("Pairing of %u failed after %u attempts", handshake.identifier,
+                           handshake.attempts);
+            removeHandshake(idx);
+            continue;
+        }
+
+        const bool due = static_cast<int32_t>(nowMs - handshake.attemptMs) >= 0;
+        if (inFlight < handshakesInFlight && due)
+        {
+            if (!startAttempt(handshake, nowMs))
+            {
+                removeHandshake(idx);
+                continue;
+            }
+            inFlight += handshake.inFlight ? 1 : 0;
+        }
+        ++idx;
+    }
+}
+
+void EspNowServer::onHandshakeStatus(const SendStatus &sendStatus, uint32_t nowMs)
+{
+    for (std::size_t idx = 0; idx < m_handshakesNum; ++idx)
+    {
+        auto &handshake = m_handshakes[idx];
+        if (!(handshake.mac == sendStatus.mac))
+        {
+            continue;
+        }
+
+        // Statuses of one peer come in order, an earlier one belongs to an attempt which timed out
+        if (handshake.statusesOwed != 0)
+        {
+            --handshake.statusesOwed;
+        }
+        if (!handshake.inFlight || handshake.statusesOwed != 0)
+        {
+            return;
+        }
+
+        if (sendStatus.status == IEspNow32Adp::Status::OK)
+        {
+            logger::logInf("Paired sensor: %u", handshake.identifier);
+            removeHandshake(idx);
+        }
+        else
+        {
+            failAttempt(handshake, nowMs);
+        }
+        return;
+    }
+}
+
+// Returns false when the sensor can't be paired at all
+bool EspNowServer::startAttempt(Handshake &handshake, uint32_t nowMs)
+{
+    if (handshake.attempts == 0)
+    {
+        // Registered before the first PAIR_RESP, so free places are never promised twice
+        m_pairingManager->addNewSensorToStorage(handshake.identifier);
+        if (!m_pairingManager->isPaired(handshake.identifier))
+        {
+            logger::logWrn("Sensor %u can't be paired", handshake.identifier);
+            return false;
+        }
+        m_espNowAdp->addPeer(handshake.mac, m_wifiAdp->getChannel());
+    }
+
+    ++handshake.attempts;
+    handshake.attemptMs = nowMs;
+    handshake.inFlight = true;
+    if (!sendPairOK(handshake.mac))
+    {
+        failAttempt(handshake, nowMs);
     }
     else
     {
-        logger::logDbg("Delivery fail");
+        ++handshake.statusesOwed;
     }
+    return true;
+}
+
+void EspNowServer::failAttempt(Handshake &handshake, uint32_t nowMs)
+{
+    logger::logDbg("PAIR_RESP to %u not delivered, attempt %u", handshake.identifier,
+                   handshake.attempts);
+    handshake.inFlight = false;
+    // Backs off, colliding senders shouldn't retry in lockstep
+    handshake.attemptMs = nowMs + pairRespRetryDelayMs * handshake.attempts;
+}
+
+void EspNowServer::removeHandshake(std::size_t idx)
+{
+    if (m_handshakes[idx].attempts != 0)
+    {
+        m_espNowAdp->deletePeer(m_handshakes[idx].mac);
+    }
+    std::move(m_handshakes.begin() + idx + 1, m_handshakes.begin() + m_handshakesNum,
+              m_handshakes.begin() + idx);
+    --m_handshakesNum;
+}
+
+void EspNowServer::onDataSend(const MacAddr &mac, IEspNow32Adp::Status status)
+{
+    // Runs in the Wi-Fi driver task, a lost status is handled as a timeout of the handshake
+    m_sendStatuses.push({mac, status});
 }
 
 void EspNowServer::setOnDataSendCb()
@@ -136,7 +384,7 @@ void EspNowServer::setOnDataRecvCb()
     m_espNowAdp->registerOnRecvCb(onRecv);
 }
 
-void EspNowServer::sendPairOK(const MacAddr &mac) const
+bool EspNowServer::sendPairOK(const MacAddr &mac) const
 {
     auto pairRespMsg = PairRespMsg::create(static_cast<uint8_t>(m_wifiAdp->getChannel()),
                                            m_confStorage->getSensorUpdatePeriodMins());
@@ -148,5 +396,7 @@ void EspNowServer::sendPairOK(const MacAddr &mac) const
     if (state == IEspNow32Adp::Status::FAIL)
     {
         logger::logWrn("Esp send msg error");
+        return false;
     }
+    return true;
 }
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 #include "EspNowPairingManager.hpp"
+#include "SenderRateLimiter.hpp"
+#include "SpscQueue.hpp"
+#include "adapters/IArduino32Adp.hpp"
 #include "adapters/IEspNow32Adp.hpp"
 #include "adapters/IWifi32Adp.hpp"
 #include "common/MacAddr.hpp"
@@ -16,10 +24,19 @@ public:
     using NewReadingsCb = std::function<void(float temp, float hum, IDType identifier)>;
     using NewPeerCb = std::function<bool(IDType identifier)>;
 
+    struct IngestStats
+    {
+        uint32_t received;
+        uint32_t dropped;
+        uint32_t oversized;
+        uint32_t throttled;
+    };
+
     EspNowServer(std::unique_ptr<IEspNow32Adp> espNowAdp,
                  const std::shared_ptr<EspNowPairingManager> &pairingManager,
                  const std::shared_ptr<IWifi32Adp> &wifiAdp,
-                 const std::shared_ptr<IConfStorage> &confStorage);
+                 const std::shared_ptr<IConfStorage> &confStorage,
+                 const std::shared_ptr<IArduino32Adp> &arduinoAdp);
     ~EspNowServer() = default;
     EspNowServer(const EspNowServer &) = delete;
     EspNowServer(EspNowServer &&) = delete;
@@ -28,19 +45,96 @@ public:
 
     void init(const NewReadingsCb &newReadingsCb);
     void deinit();
+    void update();
+    [[nodiscard]] IngestStats ingestStats() const;
+    [[nodiscard]] uint32_t throttledFrames(const MacAddr &mac) const;
 
 private:
+    constexpr static std::size_t maxFrameSize = 64;  // Biggest message takes less than half of it
+    constexpr static std::size_t queuedFramesNum = 16;
+    constexpr static std::size_t framesPerUpdate = 8;
+    // Senders may send two frames per update period on average (resends, a reboot in between)
+    // and up to four at once (pairing followed by the first reading)
+    constexpr static uint32_t framesPerUpdatePeriod = 2;
+    constexpr static float framesBurst = 4;
+    constexpr static std::size_t rateLimitedSendersNum = 24;
+
+    // Handshakes of sensors commissioned together wait in a queue, a few of them are answered at
+    // once. A transmitter listens for PAIR_RESP for 500 ms on a channel, the answer has to be
+    // delivered within that time or it's useless.
+    constexpr static std::size_t pendingHandshakesNum = 32;
+    constexpr static std::size_t handshakesInFlight = 4;
+    constexpr static uint8_t pairRespAttempts = 4;
+    constexpr static uint32_t pairRespRetryDelayMs = 20;
+    constexpr static uint32_t pairRespStatusTimeoutMs = 100;
+    constexpr static uint32_t pairReqValidityMs = 450;
+    constexpr static std::size_t sendStatusesNum = 16;
+
+    struct Frame
+    {
+        MacAddr mac;
+        uint8_t length;
+        std::array<uint8_t, maxFrameSize> data;
+    };
+
+    struct Handshake
+    {
+        MacAddr mac;
+        IDType identifier;
+        uint32_t receivedMs;
+        // When the next attempt may start, or when the one in flight was sent
+        uint32_t attemptMs;
+        uint8_t attempts;
+        bool inFlight;
+        // Every send gets a status, late ones of attempts given up on included
+        uint8_t statusesOwed;
+    };
+
+    struct SendStatus
+    {
+        MacAddr mac;
+        IEspNow32Adp::Status status;
+    };
+
     NewReadingsCb m_newReadingsCb;
 
     std::unique_ptr<IEspNow32Adp> m_espNowAdp;
     std::shared_ptr<EspNowPairingManager> m_pairingManager;
     std::shared_ptr<IWifi32Adp> m_wifiAdp;
     std::shared_ptr<IConfStorage> m_confStorage;
+    std::shared_ptr<IArduino32Adp> m_arduinoAdp;
     bool m_pairingEnabled = false;
 
+    // Filled by the receive callback in the Wi-Fi driver task, drained by update in the main loop
+    SpscQueue<Frame, queuedFramesNum> m_frames;
+    std::atomic<uint32_t> m_receivedFrames{0};
+    std::atomic<uint32_t> m_droppedFrames{0};
+    std::atomic<uint32_t> m_oversizedFrames{0};
+    uint32_t m_reportedDrops{0};
+
+    // Frames over the rate of their sender are dropped by the receive callback before queueing.
+    // The main loop sets the rate and reads the counts, the mutex guards the limiter between them.
+    mutable std::mutex m_rateLimiterMutex;
+    SenderRateLimiter<rateLimitedSendersNum> m_rateLimiter;
+    // Main loop only
+    std::optional<uint16_t> m_ratePeriodMins;
+
+    // Filled by the send callback in the Wi-Fi driver task, handshakes are main loop only
+    SpscQueue<SendStatus, sendStatusesNum> m_sendStatuses;
+    std::array<Handshake, pendingHandshakesNum> m_handshakes{};
+    std::size_t m_handshakesNum{0};
+
     void onDataSend(const MacAddr &mac, IEspNow32Adp::Status status);
     void onDataRecv(const MacAddr &mac, const uint8_t *incomingData, int len);
+    void processFrame(const Frame &frame, uint32_t nowMs);
+    void updateRateLimit();
+    void queueHandshake(const MacAddr &mac, IDType identifier, uint32_t nowMs);
+    void updateHandshakes(uint32_t nowMs);
+    void onHandshakeStatus(const SendStatus &sendStatus, uint32_t nowMs);
+    bool startAttempt(Handshake &handshake, uint32_t nowMs);
+    void failAttempt(Handshake &handshake, uint32_t nowMs);
+    void removeHandshake(std::size_t idx);
     void setOnDataRecvCb();
     void setOnDataSendCb();
-    void sendPairOK(const MacAddr &mac) const;
+    bool sendPairOK(const MacAddr &mac) const;
 };
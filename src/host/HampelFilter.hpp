@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <limits>
+
+// Streaming Hampel filter of one series: a sample is an outlier when it is further from the
+// median of the previous windowSize samples than threshold robust standard deviations (median
+// absolute deviation scaled to sigma of a normal distribution). The window is also kept sorted,
+// so the median is read directly and the MAD is found by walking outwards from it, a check costs
+// O(windowSize) with a tiny fixed window. Outliers are kept in the window, a lasting step in the
+// signal stops being flagged once it makes up half of the window.
+template <uint8_t windowSize>
+class HampelFilter
+{
+    static_assert(windowSize >= 3);
+
+public:
+    // Returns whether value is an outlier, then adds it to the window. Deviations up to
+    // minDeviation always pass, a flat signal has zero MAD and would flag any change otherwise.
+    bool check(float value, float threshold, float minDeviation)
+    {
+        bool outlier = false;
+        if (m_size == windowSize)
+        {
+            const auto median = m_sorted[middle];
+            const auto sigma = madToSigma * medianAbsoluteDeviation();
+            outlier = std::fabs(value - median) > std::max(threshold * sigma, minDeviation);
+
+            remove(m_window[m_next]);
+        }
+
+        insert(value);
+        m_window[m_next] = value;
+        m_next = m_next + 1 == windowSize ? 0 : m_next + 1;
+        return outlier;
+    }
+
+private:
+    constexpr static float madToSigma = 1.4826F;
+    constexpr static uint8_t middle = windowSize / 2;
+
+    // Samples in arrival order (a ring) and the same samples sorted
+    std::array<float, windowSize> m_window{};
+    std::array<float, windowSize> m_sorted{};
+    uint8_t m_next{0};
+    uint8_t m_size{0};
+
+    // Deviations grow in both directions from the median, so the middle one of them is found by
+    // merging the two sides until half of the window is taken
+    [[nodiscard]] float medianAbsoluteDeviation() const
+    {
+        constexpr auto none = std::numeric_limits<float>::infinity();
+        const auto median = m_sorted[middle];
+        int lower = middle - 1;
+        int upper = middle + 1;
+        float deviation = 0;
+        for (uint8_t taken = 0; taken < middle; ++taken)
+        {
+            const auto lowerDeviation = lower >= 0 ? median - m_sorted[lower] : none;
+            const auto upperDeviation = upper < windowSize ? m_sorted[upper] - median : none;
+            if (lowerDeviation <= upperDeviation)
+            {
+                deviation = lowerDeviation;
+                --lower;
+            }
+            else
+            {
+                deviation = upperDeviation;
+                ++upper;
+            }
+        }
+        return deviation;
+    }
+
+    void insert(float value)
+    {
+        auto idx = m_size;
+        for (; idx > 0 && m_sorted[idx - 1] > value; --idx)
+        {
+            m_sorted[idx] = m_sorted[idx - 1];
+        }
+        m_sorted[idx] = value;
+        ++m_size;
+    }
+
+    void remove(float value)
+    {
+        auto end = m_sorted.begin() + m_size;
+        auto idx = static_cast<uint8_t>(std::lower_bound(m_sorted.begin(), end, value)
+                                        - m_sorted.begin());
+        for (; idx + 1 < m_size; ++idx)
+        {
+            m_sorted[idx] = m_sorted[idx + 1];
+        }
+        --m_size;
+    }
+};
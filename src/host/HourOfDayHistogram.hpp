@@ -0,0 +1,61 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <limits>
+
+// Counts of readings by UTC hour of day and value bin, the shape of a typical day over weeks of
+// readings. Bins are binWidth wide from minValue up, values outside of the range go to the edge
+// bins. Adding a reading is O(1). When a count would overflow, all of them are halved, so the
+// histogram keeps its shape and older readings weigh less from then on.
+template <int16_t minValue, uint8_t binWidth, uint8_t binsNum>
+class HourOfDayHistogram
+{
+    static_assert(binWidth > 0 && binsNum > 0);
+
+public:
+    using Count = uint16_t;
+    constexpr static uint8_t hoursNum = 24;
+    constexpr static uint32_t secondsPerHour = 60 * 60;
+
+    void add(float value, unsigned long epochTime)
+    {
+        const auto hour = static_cast<uint8_t>((epochTime / secondsPerHour) % hoursNum);
+        auto &count = m_counts[hour * binsNum + bin(value)];
+        if (count == std::numeric_limits<Count>::max())
+        {
+            halve();
+        }
+        ++count;
+    }
+
+    [[nodiscard]] Count at(uint8_t hour, uint8_t binIdx) const
+    {
+        return m_counts[hour * binsNum + binIdx];
+    }
+
+    // Hour-major, binsNum counts of hour 0 first
+    [[nodiscard]] const std::array<Count, hoursNum * binsNum> &counts() const
+    {
+        return m_counts;
+    }
+
+private:
+    std::array<Count, hoursNum * binsNum> m_counts{};
+
+    static uint8_t bin(float value)
+    {
+        const auto offset = std::floor((value - minValue) / binWidth);
+        return static_cast<uint8_t>(std::clamp(offset, 0.0F, static_cast<float>(binsNum - 1)));
+    }
+
+    void halve()
+    {
+        for (auto &count : m_counts)
+        {
+            count /= 2;
+        }
+    }
+};
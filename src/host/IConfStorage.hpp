@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 
@@ -25,12 +26,21 @@ public:
     IConfStorage &operator=(IConfStorage &&) = default;
 
     virtual State load() = 0;
+    // Writes the configuration to flash right away
     virtual State save() = 0;
+    // Takes a copy of the configuration and returns, it is written later together with any newer
+    // requests. Meant for radio callbacks and web handlers, which must not wait for flash.
+    virtual void requestSave() = 0;
+    // Barrier for requested saves, writes the pending copy (if any) before returning
+    virtual State flush() = 0;
 
     virtual void setSensorUpdatePeriodMins(uint16_t minutes) = 0;
     [[nodiscard]] virtual uint16_t getSensorUpdatePeriodMins() const = 0;
     virtual void setServerPort(std::size_t port) = 0;
     [[nodiscard]] virtual std::size_t getServerPort() const = 0;
+    // In robust standard deviations, zero disables rejection of outlying readings
+    virtual void setOutlierThreshold(float threshold) = 0;
+    [[nodiscard]] virtual float getOutlierThreshold() const = 0;
     virtual void setWifiConfig(const std::string &ssid, const std::string &pass) = 0;
     virtual std::optional<std::pair<std::string, std::string>> getWifiConfig() = 0;
     virtual void setAdminCredentials(const std::string &user, const std::string &pass) = 0;
@@ -42,5 +52,9 @@ public:
     virtual bool addSensor(IDType identifier, const std::string &name = "") = 0;
     virtual bool removeSensor(IDType identifier) = 0;
     [[nodiscard]] virtual std::string getSensorsMapping() const = 0;
+    // Counters moving with every change of the configuration and of the sensors mapping, web
+    // clients compare them to tell whether their copy is current
+    [[nodiscard]] virtual uint32_t getConfigVersion() const = 0;
+    [[nodiscard]] virtual uint32_t getSensorsVersion() const = 0;
     virtual bool isSensorMapped(IDType identifier) = 0;
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "common/types.hpp"
+
+class IHistoryReader
+{
+public:
+    using ReadCb = std::function<void(unsigned long epochTime, float temperature, float humidity)>;
+
+    IHistoryReader() = default;
+    IHistoryReader(const IHistoryReader &) = default;
+    IHistoryReader(IHistoryReader &&) = default;
+    virtual ~IHistoryReader() = default;
+
+    IHistoryReader &operator=(const IHistoryReader &) = default;
+    IHistoryReader &operator=(IHistoryReader &&) = default;
+
+    // Visits readings of one sensor from the closed time range, oldest first. Returns the number
+    // of visited readings.
+    virtual std::size_t read(IDType identifier, unsigned long from, unsigned long to,
+                             const ReadCb &readCb) const
+        = 0;
+};
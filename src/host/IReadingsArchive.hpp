@@ -0,0 +1,11 @@
+#pragma once
+
+#include "IHistoryReader.hpp"
+#include "common/types.hpp"
+
+class IReadingsArchive : public IHistoryReader
+{
+public:
+    // Performs a single step of background maintenance, returns false when there was nothing to do
+    virtual bool compact(unsigned long now) = 0;
+};
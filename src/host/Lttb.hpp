@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Largest-Triangle-Three-Buckets downsampling (Sveinn Steinarsson, 2013). Points are given by
+// index, x(idx) returns the time and y(idx) an array of series values; the triangle areas of all
+// series are summed, so one selection keeps the shape of temperature and humidity at once.
+namespace lttb
+{
+template <typename XFun, typename YFun>
+std::vector<std::size_t> select(std::size_t count, std::size_t threshold, XFun x, YFun y)
+{
+    std::vector<std::size_t> selected;
+    if (threshold >= count)
+    {
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            selected.push_back(idx);
+        }
+        return selected;
+    }
+    if (threshold < 3)
+    {
+        if (threshold == 2)
+        {
+            selected.push_back(0);
+        }
+        if (threshold >= 1)
+        {
+            selected.push_back(count - 1);
+        }
+        return selected;
+    }
+
+    selected.reserve(threshold);
+    selected.push_back(0);
+
+    // First and last points are always kept, the rest is split into equal buckets
+    const auto bucketSize = static_cast<double>(count - 2) / static_cast<double>(threshold - 2);
+    std::size_t previous = 0;
+    for (std::size_t bucket = 0; bucket < threshold - 2; ++bucket)
+    {
+        const auto begin = static_cast<std::size_t>(bucket * bucketSize) + 1;
+        const auto end = static_cast<std::size_t>((bucket + 1) * bucketSize) + 1;
+
+        // Third vertex is the average of the next bucket, or the last point for the last bucket
+        const auto nextBegin = end;
+        const auto nextEnd
+            = std::min(static_cast<std::size_t>((bucket + 2) * bucketSize) + 1, count);
+        double nextX = 0;
+        decltype(y(0)) nextY{};
+        for (auto idx = nextBegin; idx < nextEnd; ++idx)
+        {
+            nextX += static_cast<double>(x(idx));
+            const auto values = y(idx);
+            for (std::size_t series = 0; series < values.size(); ++series)
+            {
+                nextY[series] += values[series];
+            }
+        }
+        const auto nextCount = static_cast<double>(nextEnd - nextBegin);
+        nextX /= nextCount;
+        for (auto &value : nextY)
+        {
+            value /= nextCount;
+        }
+
+        const auto previousX = static_cast<double>(x(previous));
+        const auto previousY = y(previous);
+        double maxArea = -1;
+        for (auto idx = begin; idx < end; ++idx)
+        {
+            const auto currentX = static_cast<double>(x(idx));
+            const auto currentY = y(idx);
+            double area = 0;
+            for (std::size_t series = 0; series < currentY.size(); ++series)
+            {
+                area += std::fabs((previousX - nextX) * (currentY[series] - previousY[series])
+                                  - (previousX - currentX) * (nextY[series] - previousY[series]));
+            }
+            if (area > maxArea)
+            {
+                maxArea = area;
+                previous = idx;
+            }
+        }
+        selected.push_back(previous);
+    }
+
+    selected.push_back(count - 1);
+    return selected;
+}
+}  // namespace lttb
@@ -0,0 +1,92 @@
+#include "MappedHistoryReader.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "common/logger.hpp"
+
+MappedHistoryReader::MappedHistoryReader(std::unique_ptr<IMappedRegion> region)
+    : m_region(std::move(region))
+{
+    auto end = m_region->size();
+    while (end >= archive_format::footerSize)
+    {
+        auto footer
+            = archive_format::decodeFooter(m_region->data() + end - archive_format::footerSize);
+        auto indexEnd = static_cast<std::size_t>(footer.indexOffset)
+                        + static_cast<std::size_t>(footer.entries) * archive_format::indexEntrySize;
+        if (footer.magic != archive_format::magic || footer.chunkBytes > end
+            || indexEnd + archive_format::footerSize > footer.chunkBytes)
+        {
+            break;
+        }
+        end -= footer.chunkBytes;
+        m_chunks.push_back({end, footer});
+    }
+    std::reverse(m_chunks.begin(), m_chunks.end());
+
+    if (m_chunks.empty())
+    {
+        logger::logWrn("Mapped history has no valid archive image");
+    }
+}
+
+std::size_t MappedHistoryReader::read(IDType identifier, unsigned long from, unsigned long to,
+                                      const ReadCb &readCb) const
+{
+    if (from > to)
+    {
+        return 0;
+    }
+
+    constexpr unsigned long maxEpoch = std::numeric_limits<uint32_t>::max();
+    auto first = static_cast<uint32_t>(std::min(from, maxEpoch));
+    auto last = static_cast<uint32_t>(std::min(to, maxEpoch));
+
+    std::size_t visited = 0;
+    for (const auto &chunk : m_chunks)
+    {
+        visited += readChunk(chunk, identifier, first, last, readCb);
+    }
+    return visited;
+}
+
+bool MappedHistoryReader::valid() const
+{
+    return !m_chunks.empty();
+}
+
+std::size_t MappedHistoryReader::readChunk(const Chunk &chunk, IDType identifier, uint32_t from,
+                                           uint32_t to, const ReadCb &readCb) const
+{
+    const auto *bytes = m_region->data() + chunk.start;
+    const auto &footer = chunk.footer;
+    auto entryAt = [bytes, &footer](std::size_t idx)
+    {
+        return archive_format::decodeIndexEntry(bytes + footer.indexOffset
+                                                + idx * archive_format::indexEntrySize);
+    };
+
+    std::size_t visited = 0;
+    for (auto idx = archive_format::firstEntryOf(identifier, from, footer.entries, entryAt);
+         idx < footer.entries; ++idx)
+    {
+        auto entry = entryAt(idx);
+        if (entry.identifier != identifier || entry.firstEpoch > to)
+        {
+            break;
+        }
+
+        // A damaged entry must not make the decoder read past the mapping
+        if (entry.bytes > CompressedBlock::blockBytes
+            || std::size_t{entry.offset} + entry.bytes > footer.indexOffset)
+        {
+            logger::logWrn("Mapped history block %u is out of bounds", static_cast<unsigned>(idx));
+            break;
+        }
+
+        visited += archive_format::visitBlock(
+            CompressedBlock::View(bytes + entry.offset, entry.count), from, to, readCb);
+    }
+    return visited;
+}
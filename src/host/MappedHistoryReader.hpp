@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ArchiveFormat.hpp"
+#include "IHistoryReader.hpp"
+#include "adapters/IMappedRegion.hpp"
+
+// Read-only history served straight from archive day files mapped into the address space (see
+// ArchiveFormat.hpp). An image is written to the end of the region, oldest day first, so chunks
+// are found back from the end until erased bytes. The index is searched and blocks are decoded
+// in place, nothing is copied through file reads.
+class MappedHistoryReader : public IHistoryReader
+{
+public:
+    explicit MappedHistoryReader(std::unique_ptr<IMappedRegion> region);
+
+    std::size_t read(IDType identifier, unsigned long from, unsigned long to,
+                     const ReadCb &readCb) const override;
+    [[nodiscard]] bool valid() const;
+
+private:
+    struct Chunk
+    {
+        std::size_t start;
+        archive_format::Footer footer;
+    };
+
+    std::unique_ptr<IMappedRegion> m_region;
+    // Oldest first
+    std::vector<Chunk> m_chunks;
+
+    std::size_t readChunk(const Chunk &chunk, IDType identifier, uint32_t from, uint32_t to,
+                          const ReadCb &readCb) const;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <optional>
+
+// Streaming estimate of the percent-th percentile in constant memory (the P-squared algorithm of
+// Jain and Chlamtac). Five markers track the minimum, the percentile, the maximum and the two
+// midpoints between them. Each sample moves marker positions by one, and marker heights are
+// adjusted along a parabola through the neighbours. Until five samples arrive the percentile
+// is exact.
+template <uint8_t percent>
+class P2Quantile
+{
+    static_assert(percent > 0 && percent < 100);
+
+public:
+    void add(float value)
+    {
+        if (m_count < markersNum)
+        {
+            // Kept sorted, so the markers are ready once the fifth sample arrives
+            auto idx = m_count;
+            for (; idx > 0 && m_heights[idx - 1] > value; --idx)
+            {
+                m_heights[idx] = m_heights[idx - 1];
+            }
+            m_heights[idx] = value;
+            ++m_count;
+            return;
+        }
+
+        std::size_t cell = 0;
+        if (value < m_heights[0])
+        {
+            m_heights[0] = value;
+        }
+        else if (value >= m_heights[markersNum - 1])
+        {
+            m_heights[markersNum - 1] = value;
+            cell = markersNum - 2;
+        }
+        else
+        {
+            while (value >= m_heights[cell + 1])
+            {
+                ++cell;
+            }
+        }
+
+        for (auto idx = cell + 1; idx < markersNum; ++idx)
+        {
+            ++m_positions[idx];
+        }
+        ++m_count;
+
+        for (std::size_t idx = 1; idx < markersNum - 1; ++idx)
+        {
+            adjust(idx);
+        }
+    }
+
+    [[nodiscard]] std::optional<float> value() const
+    {
+        if (m_count == 0)
+        {
+            return std::nullopt;
+        }
+        if (m_count < markersNum)
+        {
+            // Nearest rank
+            auto rank = static_cast<std::size_t>(std::ceil(quantile * m_count));
+            return m_heights[std::max<std::size_t>(rank, 1) - 1];
+        }
+        return m_heights[markersNum / 2];
+    }
+
+    [[nodiscard]] uint32_t count() const
+    {
+        return m_count;
+    }
+
+private:
+    constexpr static std::size_t markersNum = 5;
+    constexpr static float quantile = static_cast<float>(percent) / 100;
+
+    std::array<float, markersNum> m_heights{};
+    // One-based positions of the markers among the samples seen so far
+    std::array<uint32_t, markersNum> m_positions{1, 2, 3, 4, 5};
+    uint32_t m_count{0};
+
+    // Where the markers should be after count samples
+    [[nodiscard]] float desiredPosition(std::size_t idx) const
+    {
+        constexpr std::array<float, markersNum> increments{0, quantile / 2, quantile,
+                                                           (1 + quantile) / 2, 1};
+        constexpr std::array<float, markersNum> initial{1, 1 + 2 * quantile, 1 + 4 * quantile,
+                                                        3 + 2 * quantile, 5};
+        return initial[idx] + increments[idx] * static_cast<float>(m_count - markersNum);
+    }
+
+    void adjust(std::size_t idx)
+    {
+        const auto offset = desiredPosition(idx) - static_cast<float>(m_positions[idx]);
+        const auto toNext = m_positions[idx + 1] - m_positions[idx];
+        const auto toPrevious = m_positions[idx] - m_positions[idx - 1];
+        if (!((offset >= 1 && toNext > 1) || (offset <= -1 && toPrevious > 1)))
+        {
+            return;
+        }
+
+        const int step = offset > 0 ? 1 : -1;
+        auto height = parabolic(idx, step);
+        if (height <= m_heights[idx - 1] || height >= m_heights[idx + 1])
+        {
+            height = linear(idx, step);
+        }
+        m_heights[idx] = height;
+        m_positions[idx] += step;
+    }
+
+    [[nodiscard]] float parabolic(std::size_t idx, int step) const
+    {
+        const auto position = static_cast<float>(m_positions[idx]);
+        const auto previous = static_cast<float>(m_positions[idx - 1]);
+        const auto next = static_cast<float>(m_positions[idx + 1]);
+        const auto direction = static_cast<float>(step);
+
+        return m_heights[idx]
+               + direction / (next - previous)
+                     * ((position - previous + direction) * (m_heights[idx + 1] - m_heights[idx])
+                            / (next - position)
+                        + (next - position - direction) * (m_heights[idx] - m_heights[idx - 1])
+                              / (position - previous));
+    }
+
+    [[nodiscard]] float linear(std::size_t idx, int step) const
+    {
+        const auto neighbour = step > 0 ? idx + 1 : idx - 1;
+        return m_heights[idx]
+               + static_cast<float>(step) * (m_heights[neighbour] - m_heights[idx])
+                     / (static_cast<float>(m_positions[neighbour])
+                        - static_cast<float>(m_positions[idx]));
+    }
+};
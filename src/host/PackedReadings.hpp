@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Quantization.hpp"
+#include "ReadingsQuery.hpp"
+#include "ReadingsRollup.hpp"
+#include "common/types.hpp"
+
+// Compact little-endian layout of sensor data for clients asking for application/octet-stream,
+// decoded by charts.js. Values are stored column by column in hundredths, times as varint deltas,
+// so a raw reading takes about six bytes instead of some thirty of JSON text.
+//
+//   u8 version, u8 resolution, u16 zero, u64 identifier, u32 count, u32 first epoch,
+//   u32 length of the time column, time column (LEB128 deltas from the previous time),
+//   then for readings: i16 temperatures, u16 humidities, suspect bits (LSB first)
+//   or for buckets: i16 average, u16 average, i16 minimum, i16 maximum, u16 minimum,
+//   u16 maximum temperature and humidity, u16 counts
+namespace packed_readings
+{
+constexpr uint8_t version = 1;
+constexpr std::size_t headerSize = 2 * sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint64_t)
+                                   + 3 * sizeof(uint32_t);
+
+template <typename T>
+void append(std::string &out, T value)
+{
+    for (std::size_t byte = 0; byte < sizeof(T); ++byte)
+    {
+        out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * byte)) & 0xFF));
+    }
+}
+
+inline void appendVarint(std::string &out, uint32_t value)
+{
+    constexpr uint32_t lowBits = 0x7F;
+    constexpr uint32_t more = 0x80;
+    while (value > lowBits)
+    {
+        out.push_back(static_cast<char>((value & lowBits) | more));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Header and the time column, epochAt gives the time of the idx-th value
+template <typename EpochAt>
+void appendHeader(std::string &out,
+                  IDType identifier,
+                  ReadingsQuery::Resolution resolution,
+                  std::size_t count,
+                  EpochAt epochAt)
+{
+    append(out, version);
+    append(out, static_cast<uint8_t>(resolution));
+    append(out, uint16_t{0});
+    append(out, static_cast<uint64_t>(identifier));
+    append(out, static_cast<uint32_t>(count));
+    const uint32_t firstEpoch = count > 0 ? epochAt(0) : 0;
+    append(out, firstEpoch);
+
+    std::string epochs;
+    auto previous = firstEpoch;
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        appendVarint(epochs, epochAt(idx) - previous);
+        previous = epochAt(idx);
+    }
+    append(out, static_cast<uint32_t>(epochs.size()));
+    out += epochs;
+}
+
+template <typename Column>
+void appendColumn(std::string &out, std::size_t count, Column column)
+{
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        append(out, column(idx));
+    }
+}
+
+// Readings are sorted by time
+template <typename Reading>
+std::string encode(IDType identifier, const std::vector<Reading> &readings)
+{
+    const auto count = readings.size();
+    std::string out;
+    out.reserve(headerSize + count * (sizeof(uint16_t) * 3 + 1) + count / 8 + 1);
+    appendHeader(out, identifier, ReadingsQuery::Resolution::RAW, count,
+                 [&readings](std::size_t idx) { return readings[idx].epochTime; });
+    appendColumn(out, count,
+                 [&readings](std::size_t idx)
+                 {
+                     return quantization::toCentiTemperature(
+                         static_cast<float>(readings[idx].temperature));
+                 });
+    appendColumn(out, count,
+                 [&readings](std::size_t idx)
+                 {
+                     return quantization::toCentiHumidity(
+                         static_cast<float>(readings[idx].humidity));
+                 });
+
+    uint8_t suspectBits = 0;
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        suspectBits |= static_cast<uint8_t>(readings[idx].suspect ? 1U << (idx % 8) : 0U);
+        if (idx % 8 == 7 || idx + 1 == count)
+        {
+            append(out, suspectBits);
+            suspectBits = 0;
+        }
+    }
+    return out;
+}
+
+inline std::string encode(IDType identifier,
+                          ReadingsQuery::Resolution resolution,
+                          const std::vector<RollupBucket> &buckets)
+{
+    const auto count = buckets.size();
+    std::string out;
+    out.reserve(headerSize + count * (sizeof(uint16_t) * 7 + 2));
+    appendHeader(out, identifier, resolution, count,
+                 [&buckets](std::size_t idx) { return buckets[idx].startEpoch; });
+    appendColumn(out, count, [&buckets](std::size_t idx) { return buckets[idx].avgTemperature; });
+    appendColumn(out, count, [&buckets](std::size_t idx) { return buckets[idx].avgHumidity; });
+    appendColumn(out, count, [&buckets](std::size_t idx) { return buckets[idx].minTemperature; });
+    appendColumn(out, count, [&buckets](std::size_t idx) { return buckets[idx].maxTemperature; });
+    appendColumn(out, count, [&buckets](std::size_t idx) { return buckets[idx].minHumidity; });
+    appendColumn(out, count, [&buckets](std::size_t idx) { return buckets[idx].maxHumidity; });
+    appendColumn(out, count, [&buckets](std::size_t idx) { return buckets[idx].count; });
+    return out;
+}
+}  // namespace packed_readings
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <limits>
+
+// Readings are kept in hundredths of degree / percent. That is lossy (at most 0.005 off after
+// rounding), but well within the AHT10 accuracy of 0.3 degree and 2 percent.
+namespace quantization
+{
+constexpr auto centiPerUnit = 100.0;
+
+inline int16_t toCentiTemperature(float value)
+{
+    constexpr long limit = std::numeric_limits<int16_t>::max();
+    return static_cast<int16_t>(std::clamp(std::lround(value * centiPerUnit), -limit, limit));
+}
+
+inline uint16_t toCentiHumidity(float value)
+{
+    constexpr long limit = std::numeric_limits<uint16_t>::max();
+    return static_cast<uint16_t>(std::clamp(std::lround(value * centiPerUnit), 0L, limit));
+}
+
+inline double fromCenti(long value)
+{
+    return static_cast<double>(value) / centiPerUnit;
+}
+}  // namespace quantization
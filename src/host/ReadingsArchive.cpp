@@ -0,0 +1,454 @@
+#include "ReadingsArchive.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "common/logger.hpp"
+
+namespace
+{
+constexpr uint32_t secondsInDay = 86400;
+constexpr uint32_t noDay = std::numeric_limits<uint32_t>::max();
+
+uint32_t toEpoch32(unsigned long epochTime)
+{
+    return static_cast<uint32_t>(
+        std::min<unsigned long>(epochTime, std::numeric_limits<uint32_t>::max()));
+}
+
+uint32_t dayOf(uint32_t epochTime)
+{
+    return epochTime / secondsInDay;
+}
+
+uint32_t daysBefore(uint32_t day, std::size_t days)
+{
+    return day > days ? static_cast<uint32_t>(day - days) : 0;
+}
+}  // namespace
+
+ReadingsArchive::ReadingsArchive(const std::shared_ptr<IFileSystem32Adp> &fileSystem,
+                                 const std::shared_ptr<const ReadingsLog> &log,
+                                 std::string pathPrefix,
+                                 std::optional<std::size_t> budgetBytes,
+                                 std::size_t retentionDays)
+    : m_fileSystem(fileSystem)
+    , m_log(log)
+    , m_pathPrefix(std::move(pathPrefix))
+    , m_budgetBytes(budgetBytes.value_or(budgetFor(fileSystem->totalBytes())))
+    , m_retentionDays(retentionDays)
+    , m_oldestDay(noDay)
+{
+}
+
+std::size_t ReadingsArchive::budgetFor(std::size_t partitionBytes)
+{
+    const auto otherBytes = ReadingsLog::maxBytes() + reservedBytes;
+    return partitionBytes > otherBytes ? partitionBytes - otherBytes : 0;
+}
+
+std::size_t ReadingsArchive::read(IDType identifier, unsigned long from, unsigned long to,
+                                  const ReadCb &readCb) const
+{
+    if (from > to)
+    {
+        return 0;
+    }
+
+    auto first = toEpoch32(from);
+    auto last = toEpoch32(to);
+    auto firstDay = std::max(dayOf(first), m_oldestDay.load());
+    auto lastDay = std::min(dayOf(last), m_newestDay.load());
+
+    std::size_t visited = 0;
+    for (auto day = firstDay; day <= lastDay; ++day)
+    {
+        if (m_fileSystem->exists(dayPath(day)))
+        {
+            visited += readDay(day, identifier, first, last, readCb);
+        }
+    }
+    return visited;
+}
+
+bool ReadingsArchive::compact(unsigned long now)
+{
+    if (!m_scanned)
+    {
+        scanNextDays(now);
+        return true;
+    }
+
+    // A chunk which couldn't be written is retried before anything else is read from the log
+    if (m_chunk.has_value() && m_chunk->finished)
+    {
+        storeChunk();
+        return true;
+    }
+
+    if (!findNextPosition())
+    {
+        return false;
+    }
+    compactNextRecords();
+    return true;
+}
+
+std::pair<unsigned long, unsigned long> ReadingsArchive::timeRange() const
+{
+    auto oldestDay = m_oldestDay.load();
+    auto newestDay = m_newestDay.load();
+    if (oldestDay > newestDay)
+    {
+        return {1, 0};
+    }
+    return {static_cast<unsigned long>(oldestDay) * secondsInDay,
+            static_cast<unsigned long>(newestDay + 1) * secondsInDay - 1};
+}
+
+std::string ReadingsArchive::dayPath(uint32_t day) const
+{
+    return m_pathPrefix + "d" + std::to_string(day) + ".bin";
+}
+
+std::size_t ReadingsArchive::readDay(uint32_t day, IDType identifier, uint32_t from, uint32_t to,
+                                     const ReadCb &readCb) const
+{
+    auto file = m_fileSystem->open(dayPath(day), IFileSystem32Adp::Mode::F_READ);
+
+    // Chunks are found from the last one back, but visited oldest first
+    std::vector<std::pair<std::size_t, archive_format::Footer>> chunks;
+    auto end = file->size();
+    while (end > 0)
+    {
+        auto footer = readFooter(*file, end);
+        if (!footer.has_value() || footer->day != day || footer->chunkBytes > end)
+        {
+            logger::logWrn("Archive file %s is damaged, skipping %u bytes", dayPath(day), end);
+            break;
+        }
+        end -= footer->chunkBytes;
+        chunks.emplace_back(end, footer.value());
+    }
+
+    std::size_t visited = 0;
+    for (auto chunk = chunks.rbegin(); chunk != chunks.rend(); ++chunk)
+    {
+        visited += readChunk(*file, chunk->first, chunk->second, identifier, from, to, readCb);
+    }
+    return visited;
+}
+
+std::size_t ReadingsArchive::readChunk(IRaiiFile &file, std::size_t start,
+                                       const archive_format::Footer &footer, IDType identifier,
+                                       uint32_t from, uint32_t to, const ReadCb &readCb)
+{
+    auto entryAt = [&file, &footer, start](std::size_t idx)
+    {
+        std::array<uint8_t, archive_format::indexEntrySize> buffer{};
+        file.seek(start + footer.indexOffset + idx * buffer.size());
+        file.read(buffer.data(), buffer.size());
+        return archive_format::decodeIndexEntry(buffer.data());
+    };
+
+    std::array<uint8_t, CompressedBlock::blockBytes> bytes{};
+    std::size_t visited = 0;
+    for (auto idx = archive_format::firstEntryOf(identifier, from, footer.entries, entryAt);
+         idx < footer.entries; ++idx)
+    {
+        auto entry = entryAt(idx);
+        if (entry.identifier != identifier || entry.firstEpoch > to)
+        {
+            break;
+        }
+
+        file.seek(start + entry.offset);
+        file.read(bytes.data(), std::min<std::size_t>(entry.bytes, bytes.size()));
+        visited += archive_format::visitBlock(CompressedBlock::View(bytes.data(), entry.count),
+                                              from, to, readCb);
+    }
+    return visited;
+}
+
+std::optional<archive_format::Footer> ReadingsArchive::readFooter(IRaiiFile &file,
+                                                                  std::size_t end)
+{
+    std::array<uint8_t, archive_format::footerSize> bytes{};
+    if (end < bytes.size() || !file.seek(end - bytes.size())
+        || file.read(bytes.data(), bytes.size()) != bytes.size())
+    {
+        return std::nullopt;
+    }
+
+    auto footer = archive_format::decodeFooter(bytes.data());
+    if (footer.magic != archive_format::magic || footer.chunkBytes < bytes.size())
+    {
+        return std::nullopt;
+    }
+    return footer;
+}
+
+// Files are looked for a retention period further back than kept, so days which expired while
+// the device was off are found and dropped as well
+void ReadingsArchive::scanNextDays(unsigned long now)
+{
+    if (!m_nextScanDay.has_value())
+    {
+        m_lastScanDay = dayOf(toEpoch32(now));
+        m_nextScanDay = daysBefore(m_lastScanDay, 2 * m_retentionDays);
+    }
+
+    for (std::size_t days = 0; days < daysPerScanStep && m_nextScanDay.value() <= m_lastScanDay;
+         ++days)
+    {
+        scanDay(m_nextScanDay.value()++);
+    }
+
+    if (m_nextScanDay.value() > m_lastScanDay)
+    {
+        m_scanned = true;
+        logger::logInf("Archive uses %u bytes", m_usedBytes);
+    }
+}
+
+void ReadingsArchive::scanDay(uint32_t day)
+{
+    auto path = dayPath(day);
+    if (!m_fileSystem->exists(path))
+    {
+        return;
+    }
+
+    auto file = m_fileSystem->open(path, IFileSystem32Adp::Mode::F_READ);
+    keepDay(day, file->size());
+
+    // Archiving resumes after the newest record any of the chunks was made of
+    if (auto footer = readFooter(*file, file->size()); footer.has_value())
+    {
+        LogPosition position{footer->logSequence, footer->logRecord};
+        if (!m_next.has_value() || position.sequence > m_next->sequence
+            || (position.sequence == m_next->sequence && position.record > m_next->record))
+        {
+            m_next = position;
+        }
+    }
+}
+
+bool ReadingsArchive::findNextPosition()
+{
+    auto segments = m_log->closedSegments();
+    if (segments.empty())
+    {
+        return false;
+    }
+
+    if (!m_next.has_value())
+    {
+        m_next = LogPosition{segments.front(), 0};
+    }
+    else if (m_next->sequence < segments.front())
+    {
+        logger::logWrn("Readings log segments %u to %u were reused before being archived",
+                       m_next->sequence, segments.front() - 1);
+        m_next = LogPosition{segments.front(), 0};
+    }
+    return m_next->sequence <= segments.back();
+}
+
+void ReadingsArchive::compactNextRecords()
+{
+    auto &next = m_next.value();
+    std::size_t taken = 0;
+    bool dayChanged = false;
+    auto visited = m_log->readSegment(next.sequence, next.record, recordsPerStep,
+                                      [this, &taken, &dayChanged](const ReadingsLog::Record &record)
+                                      {
+                                          auto day = dayOf(toEpoch32(record.epochTime));
+                                          dayChanged = dayChanged
+                                                       || (m_chunk.has_value()
+                                                           && m_chunk->day != day);
+                                          if (!dayChanged)
+                                          {
+                                              appendToChunk(record);
+                                              ++taken;
+                                          }
+                                      });
+    if (!visited.has_value())
+    {
+        return;
+    }
+
+    next.record += taken;
+    if (!dayChanged && visited.value() < recordsPerStep)
+    {
+        next = LogPosition{next.sequence + 1, 0};
+    }
+    else if (!dayChanged)
+    {
+        return;
+    }
+
+    if (m_chunk.has_value())
+    {
+        finishChunk();
+    }
+}
+
+void ReadingsArchive::appendToChunk(const ReadingsLog::Record &record)
+{
+    auto epochTime = toEpoch32(record.epochTime);
+    if (!m_chunk.has_value())
+    {
+        m_chunk = Chunk{dayOf(epochTime), {}, {}, {}, false};
+    }
+
+    auto &block = m_chunk->openBlocks[record.identifier];
+    if (!block.append(epochTime, record.temperature, record.humidity))
+    {
+        writeBlock(record.identifier, block);
+        block.clear();
+        block.append(epochTime, record.temperature, record.humidity);
+    }
+}
+
+void ReadingsArchive::writeBlock(IDType identifier, const CompressedBlock &block)
+{
+    auto &chunk = m_chunk.value();
+    auto bytes = static_cast<uint16_t>(block.usedBytes());
+    chunk.index.push_back({identifier, block.firstEpoch(), block.lastEpoch(),
+                           static_cast<uint32_t>(chunk.bytes.size()), block.size(), bytes});
+    chunk.bytes.insert(chunk.bytes.end(), block.data(), block.data() + bytes);  // NOLINT
+}
+
+void ReadingsArchive::finishChunk()
+{
+    auto &chunk = m_chunk.value();
+    for (const auto &[identifier, block] : chunk.openBlocks)
+    {
+        if (!block.empty())
+        {
+            writeBlock(identifier, block);
+        }
+    }
+    chunk.openBlocks.clear();
+
+    // Blocks of one sensor were written in time order, so a stable sort keeps them that way
+    using archive_format::IndexEntry;
+    std::stable_sort(chunk.index.begin(), chunk.index.end(),
+                     [](const IndexEntry &lhs, const IndexEntry &rhs)
+                     { return lhs.identifier < rhs.identifier; });
+
+    auto indexOffset = static_cast<uint32_t>(chunk.bytes.size());
+    chunk.bytes.resize(indexOffset + chunk.index.size() * archive_format::indexEntrySize
+                       + archive_format::footerSize);
+    auto *cursor = &chunk.bytes[indexOffset];
+    for (const auto &entry : chunk.index)
+    {
+        archive_format::encode(entry, cursor);
+        cursor += archive_format::indexEntrySize;  // NOLINT
+    }
+
+    archive_format::Footer footer{archive_format::magic,
+                                  chunk.day,
+                                  static_cast<uint32_t>(chunk.index.size()),
+                                  indexOffset,
+                                  static_cast<uint32_t>(chunk.bytes.size()),
+                                  m_next->sequence,
+                                  m_next->record};
+    archive_format::encode(footer, cursor);
+    chunk.finished = true;
+
+    storeChunk();
+}
+
+// The chunk is written with a single append, LittleFS commits it whole when the file is closed.
+// A short write is cut off, so the chunk before stays the last one, and the write is retried.
+void ReadingsArchive::storeChunk()
+{
+    auto &chunk = m_chunk.value();
+    auto path = dayPath(chunk.day);
+    if (!makeRoom(chunk.day, chunk.bytes.size()))
+    {
+        logger::logErr("No room to archive %u bytes of day %u, dropping them", chunk.bytes.size(),
+                       chunk.day);
+        m_chunk.reset();
+        return;
+    }
+
+    std::size_t previousSize = 0;
+    std::size_t written = 0;
+    {
+        auto file = m_fileSystem->open(path, IFileSystem32Adp::Mode::F_APPEND);
+        previousSize = file->size();
+        written = file->write(chunk.bytes.data(), chunk.bytes.size());
+    }
+
+    if (written == chunk.bytes.size())
+    {
+        keepDay(chunk.day, written);
+        m_chunk.reset();
+        return;
+    }
+
+    logger::logErr("Archive write failed, %u of %u bytes written, will retry", written,
+                   chunk.bytes.size());
+    if (previousSize == 0)
+    {
+        m_fileSystem->remove(path);
+    }
+    else
+    {
+        m_fileSystem->truncate(path, previousSize);
+    }
+}
+
+// Expired days are dropped first, then the oldest ones until the bytes fit into the budget and the
+// free space. The day being written is never dropped.
+bool ReadingsArchive::makeRoom(uint32_t day, std::size_t bytes)
+{
+    auto fits = [this, bytes]
+    {
+        return m_usedBytes + bytes <= m_budgetBytes
+               && m_fileSystem->freeBytes() >= bytes + reservedBytes;
+    };
+
+    auto firstKeptDay = daysBefore(std::max(day, m_newestDay.load()), m_retentionDays);
+    while (m_oldestDay.load() < day && (m_oldestDay.load() < firstKeptDay || !fits()))
+    {
+        dropOldestDay();
+    }
+    return fits();
+}
+
+void ReadingsArchive::dropOldestDay()
+{
+    auto day = m_oldestDay.load();
+    auto path = dayPath(day);
+    if (m_fileSystem->exists(path))
+    {
+        auto size = m_fileSystem->open(path, IFileSystem32Adp::Mode::F_READ)->size();
+        if (m_fileSystem->remove(path))
+        {
+            m_usedBytes -= std::min(size, m_usedBytes);
+            logger::logInf("Dropped archived day %u", day);
+        }
+    }
+
+    if (day >= m_newestDay.load())
+    {
+        m_oldestDay = noDay;
+        m_newestDay = 0;
+    }
+    else
+    {
+        m_oldestDay = day + 1;
+    }
+}
+
+void ReadingsArchive::keepDay(uint32_t day, std::size_t bytes)
+{
+    m_usedBytes += bytes;
+    m_oldestDay = std::min(m_oldestDay.load(), day);
+    m_newestDay = std::max(m_newestDay.load(), day);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ArchiveFormat.hpp"
+#include "CompressedBlock.hpp"
+#include "IReadingsArchive.hpp"
+#include "ReadingsLog.hpp"
+#include "adapters/IFileSystem32Adp.hpp"
+
+// Long-term history on flash, made from the readings log instead of being written next to it, so
+// every reading is stored raw only once. Segments of the log which are no longer written to are
+// compacted into CompressedBlocks kept in daily files (see ArchiveFormat.hpp), whose sparse indexes
+// let a range read of one sensor seek straight to its first matching block.
+// A maintenance step handles a bounded number of records to keep the main loop responsive. Files
+// are kept within a flash budget and a retention period, the oldest days are dropped first.
+// Days are not merged into weekly files later: blocks are already stored without padding behind a
+// sparse index, about 6 % over the bare codec, while a merge would rewrite the whole archive every
+// week and whole days could no longer be dropped.
+class ReadingsArchive : public IReadingsArchive
+{
+public:
+    // Seven sensors reporting every minute take about 24 KB a day with file system overhead, so a
+    // ~1.4 MB partition keeps the whole period
+    constexpr static std::size_t defaultRetentionDays = 49;
+
+    // Without a budget the archive may take the whole partition but the log and the reserve
+    ReadingsArchive(const std::shared_ptr<IFileSystem32Adp> &fileSystem,
+                    const std::shared_ptr<const ReadingsLog> &log,
+                    std::string pathPrefix,
+                    std::optional<std::size_t> budgetBytes = std::nullopt,
+                    std::size_t retentionDays = defaultRetentionDays);
+
+    [[nodiscard]] static std::size_t budgetFor(std::size_t partitionBytes);
+
+    std::size_t read(IDType identifier, unsigned long from, unsigned long to,
+                     const ReadCb &readCb) const override;
+    bool compact(unsigned long now) override;
+
+    // Closed time range of the archived days, empty until the files were scanned
+    [[nodiscard]] std::pair<unsigned long, unsigned long> timeRange() const;
+
+private:
+    constexpr static std::size_t recordsPerStep = 128;
+    constexpr static std::size_t daysPerScanStep = 8;
+    // Left to the readings log and the configuration, which share the file system
+    constexpr static std::size_t reservedBytes = 32 * 1024;
+
+    struct LogPosition
+    {
+        uint32_t sequence;
+        uint32_t record;
+    };
+
+    // Readings of one day taken from one log segment, written to flash at once
+    struct Chunk
+    {
+        uint32_t day;
+        std::map<IDType, CompressedBlock> openBlocks;
+        std::vector<uint8_t> bytes;
+        std::vector<archive_format::IndexEntry> index;
+        bool finished;
+    };
+
+    std::shared_ptr<IFileSystem32Adp> m_fileSystem;
+    std::shared_ptr<const ReadingsLog> m_log;
+    std::string m_pathPrefix;
+    std::size_t m_budgetBytes;
+    std::size_t m_retentionDays;
+
+    std::optional<uint32_t> m_nextScanDay;
+    uint32_t m_lastScanDay{0};
+    bool m_scanned{false};
+
+    // Read by web handlers running outside the main loop
+    std::atomic<uint32_t> m_oldestDay;
+    std::atomic<uint32_t> m_newestDay{0};
+    std::size_t m_usedBytes{0};
+
+    std::optional<LogPosition> m_next;
+    std::optional<Chunk> m_chunk;
+
+    [[nodiscard]] std::string dayPath(uint32_t day) const;
+
+    std::size_t readDay(uint32_t day, IDType identifier, uint32_t from, uint32_t to,
+                        const ReadCb &readCb) const;
+    static std::size_t readChunk(IRaiiFile &file, std::size_t start,
+                                 const archive_format::Footer &footer, IDType identifier,
+                                 uint32_t from, uint32_t to, const ReadCb &readCb);
+    static std::optional<archive_format::Footer> readFooter(IRaiiFile &file, std::size_t end);
+
+    void scanNextDays(unsigned long now);
+    void scanDay(uint32_t day);
+    [[nodiscard]] bool findNextPosition();
+    void compactNextRecords();
+    void appendToChunk(const ReadingsLog::Record &record);
+    void writeBlock(IDType identifier, const CompressedBlock &block);
+    void finishChunk();
+    void storeChunk();
+    bool makeRoom(uint32_t day, std::size_t bytes);
+    void dropOldestDay();
+    void keepDay(uint32_t day, std::size_t bytes);
+};
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+
+#include "ReadingsColumns.hpp"
+
+// Preallocated arena of fixed-size reading blocks shared by all sensors. Every sensor owns a chain
+// of blocks, oldest first. A chain which reached its quota reuses its own oldest block, otherwise
+// a new block is taken from the free list and, when the pool is exhausted, the globally oldest
+// full block is reclaimed from whichever sensor owns it.
+template <uint16_t blocksNum, uint16_t readingsPerBlock>
+class ReadingsBlockPool
+{
+    using BlockIdx = uint16_t;
+    constexpr static BlockIdx noBlock = std::numeric_limits<BlockIdx>::max();
+
+    static_assert(blocksNum > 0);
+    static_assert(blocksNum < noBlock);
+
+public:
+    constexpr static std::size_t capacity = std::size_t{blocksNum} * readingsPerBlock;
+
+    // Heap taken by one block, so the pool can be sized from a memory budget
+    constexpr static std::size_t blockBytes()
+    {
+        return sizeof(Block);
+    }
+
+    struct Reading
+    {
+        uint32_t epochTime;
+        double temperature;
+        double humidity;
+        bool suspect{false};
+    };
+
+    // Blocks keep a pointer to their chain, so a chain must not be moved while it owns blocks
+    struct Chain
+    {
+        BlockIdx oldest{noBlock};
+        BlockIdx newest{noBlock};
+        std::size_t size{0};
+        uint16_t blocks{0};
+        // Zero means no limit
+        uint16_t quota{0};
+
+        [[nodiscard]] bool empty() const
+        {
+            return size == 0;
+        }
+    };
+
+    // Random access view of the chain readings which fall into a time range
+    class Range
+    {
+    public:
+        [[nodiscard]] std::size_t size() const
+        {
+            return m_end - m_begin;
+        }
+
+        [[nodiscard]] Reading at(std::size_t idx) const
+        {
+            return m_pool->readingAt(m_blocks, m_begin + idx);
+        }
+
+    private:
+        friend class ReadingsBlockPool;
+
+        const ReadingsBlockPool *m_pool;
+        std::array<BlockIdx, blocksNum> m_blocks{};
+        std::size_t m_begin{0};
+        std::size_t m_end{0};
+
+        explicit Range(const ReadingsBlockPool *pool)
+            : m_pool(pool)
+        {
+        }
+    };
+
+    ReadingsBlockPool()
+        : m_blocks(std::make_unique<std::array<Block, blocksNum>>())
+    {
+        for (BlockIdx idx = 0; idx < blocksNum; ++idx)
+        {
+            block(idx).next = idx + 1 < blocksNum ? idx + 1 : noBlock;
+        }
+        m_freeHead = 0;
+    }
+
+    void put(Chain &chain,
+             uint32_t epochTime,
+             float temperature,
+             float humidity,
+             bool suspect = false)
+    {
+        if (chain.newest == noBlock || block(chain.newest).readings.size() == readingsPerBlock)
+        {
+            if (chain.quota != 0 && chain.blocks >= chain.quota)
+            {
+                detachOldest(chain);
+            }
+
+            auto idx = allocate();
+            block(idx).owner = &chain;
+            if (chain.newest == noBlock)
+            {
+                chain.oldest = idx;
+            }
+            else
+            {
+                block(chain.newest).next = idx;
+            }
+            chain.newest = idx;
+            ++chain.blocks;
+        }
+
+        block(chain.newest).readings.put(epochTime, temperature, humidity, suspect);
+        ++chain.size;
+    }
+
+    // Oldest blocks above the new quota go back to the pool right away, newest readings are kept
+    void setQuota(Chain &chain, uint16_t quota)
+    {
+        chain.quota = quota;
+        while (quota != 0 && chain.blocks > quota)
+        {
+            detachOldest(chain);
+        }
+    }
+
+    // Returns all blocks of the chain to the pool
+    void release(Chain &chain)
+    {
+        while (chain.oldest != noBlock)
+        {
+            detachOldest(chain);
+        }
+    }
+
+    template <typename Fun>
+    void forEach(const Chain &chain, Fun fun) const
+    {
+        for (auto idx = chain.oldest; idx != noBlock; idx = block(idx).next)
+        {
+            block(idx).readings.forEach(fun);
+        }
+    }
+
+    // Epochs are monotonic within a chain, so both ends of the range are found by binary search
+    [[nodiscard]] Range range(const Chain &chain, uint32_t from, uint32_t to) const
+    {
+        Range result(this);
+        std::size_t blocksInChain = 0;
+        // Bounded, so a chain read while being relinked (see Seqlock.hpp) can't overrun
+        for (auto idx = chain.oldest; idx < blocksNum && blocksInChain < blocksNum;
+             idx = block(idx).next)
+        {
+            result.m_blocks[blocksInChain++] = idx;
+        }
+
+        const auto size = std::min(chain.size, blocksInChain * readingsPerBlock);
+        auto firstNotBefore = [this, &result, size](uint32_t epochTime, bool inclusive)
+        {
+            std::size_t low = 0;
+            std::size_t high = size;
+            while (low < high)
+            {
+                auto middle = low + (high - low) / 2;
+                auto middleEpoch = readingAt(result.m_blocks, middle).epochTime;
+                if (inclusive ? middleEpoch < epochTime : middleEpoch <= epochTime)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            return low;
+        };
+
+        result.m_begin = firstNotBefore(from, true);
+        result.m_end = std::max(result.m_begin, firstNotBefore(to, false));
+        return result;
+    }
+
+    [[nodiscard]] std::optional<uint32_t> firstEpoch(const Chain &chain) const
+    {
+        auto oldest = chain.oldest;
+        if (chain.empty() || oldest >= blocksNum)
+        {
+            return std::nullopt;
+        }
+        return block(oldest).readings.epochAt(0);
+    }
+
+    [[nodiscard]] std::optional<Reading> last(const Chain &chain) const
+    {
+        auto newest = chain.newest;
+        if (chain.empty() || newest >= blocksNum)
+        {
+            return std::nullopt;
+        }
+
+        const auto &readings = block(newest).readings;
+        if (readings.empty())
+        {
+            return std::nullopt;
+        }
+        auto idx = readings.size() - 1;
+        return Reading{readings.epochAt(idx), readings.temperatureAt(idx),
+                       readings.humidityAt(idx), readings.suspectAt(idx)};
+    }
+
+    [[nodiscard]] std::size_t freeBlocks() const
+    {
+        std::size_t count = 0;
+        for (auto idx = m_freeHead; idx != noBlock; idx = block(idx).next)
+        {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    struct Block
+    {
+        ReadingsColumns<readingsPerBlock> readings;
+        BlockIdx next{noBlock};
+        Chain *owner{nullptr};
+    };
+
+    std::unique_ptr<std::array<Block, blocksNum>> m_blocks;
+    BlockIdx m_freeHead{noBlock};
+
+    Block &block(BlockIdx idx)
+    {
+        return (*m_blocks)[idx];
+    }
+
+    [[nodiscard]] const Block &block(BlockIdx idx) const
+    {
+        return (*m_blocks)[idx];
+    }
+
+    // Every block but the newest one of a chain is full
+    [[nodiscard]] Reading readingAt(const std::array<BlockIdx, blocksNum> &blocks,
+                                    std::size_t idx) const
+    {
+        const auto &readings = block(blocks[idx / readingsPerBlock]).readings;
+        auto offset = static_cast<uint16_t>(idx % readingsPerBlock);
+        return {readings.epochAt(offset), readings.temperatureAt(offset),
+                readings.humidityAt(offset), readings.suspectAt(offset)};
+    }
+
+    BlockIdx allocate()
+    {
+        if (m_freeHead == noBlock)
+        {
+            detachOldest(*block(findOldestBlock()).owner);
+        }
+
+        auto idx = m_freeHead;
+        m_freeHead = block(idx).next;
+        block(idx).next = noBlock;
+        return idx;
+    }
+
+    // Blocks still being filled are taken only when no sensor has a full one, so a slowly
+    // reporting sensor does not lose its only block to every new one
+    BlockIdx findOldestBlock() const
+    {
+        std::optional<BlockIdx> oldestFull;
+        std::optional<BlockIdx> oldest;
+        for (BlockIdx idx = 0; idx < blocksNum; ++idx)
+        {
+            auto isOlder = [this, idx](std::optional<BlockIdx> current)
+            {
+                return !current.has_value()
+                       || block(idx).readings.epochAt(0)
+                              < block(current.value()).readings.epochAt(0);
+            };
+
+            const auto &candidate = block(idx);
+            if (candidate.owner == nullptr || candidate.owner->oldest != idx)
+            {
+                continue;
+            }
+            if (isOlder(oldest))
+            {
+                oldest = idx;
+            }
+            if (candidate.owner->newest != idx && isOlder(oldestFull))
+            {
+                oldestFull = idx;
+            }
+        }
+        return oldestFull.value_or(oldest.value());
+    }
+
+    void detachOldest(Chain &chain)
+    {
+        auto idx = chain.oldest;
+        auto &detached = block(idx);
+
+        chain.size -= detached.readings.size();
+        --chain.blocks;
+        chain.oldest = detached.next;
+        if (chain.oldest == noBlock)
+        {
+            chain.newest = noBlock;
+        }
+
+        detached = Block{};
+        detached.next = m_freeHead;
+        m_freeHead = idx;
+    }
+};
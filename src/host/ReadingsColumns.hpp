@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cinttypes>
+#include <cstddef>
+
+#include "Quantization.hpp"
+
+// Ring of readings stored column by column: epochs are kept as they are, temperature and humidity
+// quantized to hundredths (see Quantization.hpp), plus a bit per reading marking suspect ones
+// (see HampelFilter.hpp). A single metric is serialized by walking one dense array instead of
+// striding over structs.
+template <uint16_t capacity>
+class ReadingsColumns
+{
+    static_assert(capacity > 0);
+
+public:
+    void put(uint32_t epochTime, float temperature, float humidity, bool suspect = false)
+    {
+        m_head = m_size == 0 ? 0 : next(m_head);
+        m_epochs[m_head] = epochTime;
+        m_temperatures[m_head] = quantization::toCentiTemperature(temperature);
+        m_humidities[m_head] = quantization::toCentiHumidity(humidity);
+        m_suspect[m_head] = suspect;
+
+        if (m_size < capacity)
+        {
+            ++m_size;
+        }
+    }
+
+    [[nodiscard]] uint16_t size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    // Index 0 is the oldest reading
+    [[nodiscard]] uint32_t epochAt(uint16_t idx) const
+    {
+        return m_epochs[physical(idx)];
+    }
+
+    [[nodiscard]] double temperatureAt(uint16_t idx) const
+    {
+        return quantization::fromCenti(m_temperatures[physical(idx)]);
+    }
+
+    [[nodiscard]] double humidityAt(uint16_t idx) const
+    {
+        return quantization::fromCenti(m_humidities[physical(idx)]);
+    }
+
+    [[nodiscard]] bool suspectAt(uint16_t idx) const
+    {
+        return m_suspect[physical(idx)];
+    }
+
+    template <typename Fun>
+    void forEach(Fun fun) const
+    {
+        forEachPhysical(
+            [this, &fun](uint16_t idx)
+            {
+                fun(m_epochs[idx], quantization::fromCenti(m_temperatures[idx]),
+                    quantization::fromCenti(m_humidities[idx]));
+            });
+    }
+
+    template <typename Fun>
+    void forEachTemperature(Fun fun) const
+    {
+        forEachPhysical([this, &fun](uint16_t idx)
+                        { fun(m_epochs[idx], quantization::fromCenti(m_temperatures[idx])); });
+    }
+
+    template <typename Fun>
+    void forEachHumidity(Fun fun) const
+    {
+        forEachPhysical([this, &fun](uint16_t idx)
+                        { fun(m_epochs[idx], quantization::fromCenti(m_humidities[idx])); });
+    }
+
+private:
+    std::array<uint32_t, capacity> m_epochs{};
+    std::array<int16_t, capacity> m_temperatures{};
+    std::array<uint16_t, capacity> m_humidities{};
+    std::bitset<capacity> m_suspect{};
+    uint16_t m_head{0};
+    uint16_t m_size{0};
+
+    [[nodiscard]] uint16_t oldest() const
+    {
+        return m_size < capacity ? 0 : next(m_head);
+    }
+
+    [[nodiscard]] uint16_t physical(uint16_t idx) const
+    {
+        auto shifted = static_cast<std::size_t>(oldest()) + idx;
+        return static_cast<uint16_t>(shifted < capacity ? shifted : shifted - capacity);
+    }
+
+    static uint16_t next(uint16_t idx)
+    {
+        return idx + 1 == capacity ? 0 : idx + 1;
+    }
+
+    // Visits the (at most two) contiguous segments in order, without wrapping index per element
+    template <typename Fun>
+    void forEachPhysical(Fun fun) const
+    {
+        const auto first = oldest();
+        const auto firstSegmentEnd = std::min<std::size_t>(first + m_size, capacity);
+        for (std::size_t idx = first; idx < firstSegmentEnd; ++idx)
+        {
+            fun(static_cast<uint16_t>(idx));
+        }
+
+        const auto wrapped = m_size - (firstSegmentEnd - first);
+        for (std::size_t idx = 0; idx < wrapped; ++idx)
+        {
+            fun(static_cast<uint16_t>(idx));
+        }
+    }
+};
@@ -0,0 +1,68 @@
+#include "ReadingsJsonStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+ReadingsJsonStream::ReadingsJsonStream(const ReadingsStorage &storage, const ReadingsQuery &query)
+    : m_storage(storage)
+    , m_cursor(storage.openCursor(query))
+{
+}
+
+std::size_t ReadingsJsonStream::fill(uint8_t *buffer, std::size_t maxLen)
+{
+    std::size_t written = 0;
+    while (written < maxLen)
+    {
+        if (m_pendingOffset == m_pending.size())
+        {
+            if (m_stage == Stage::DONE)
+            {
+                break;
+            }
+            produce();
+            continue;
+        }
+
+        auto len = std::min(maxLen - written, m_pending.size() - m_pendingOffset);
+        std::memcpy(buffer + written, m_pending.data() + m_pendingOffset, len);  // NOLINT
+        m_pendingOffset += len;
+        written += len;
+    }
+    return written;
+}
+
+// Replaces the written text with the next part of the response
+void ReadingsJsonStream::produce()
+{
+    m_pending.clear();
+    m_pendingOffset = 0;
+
+    switch (m_stage)
+    {
+    case Stage::HEADER:
+        // Keys in the order nlohmann::json dumps them
+        m_pending = R"({"identifier":)" + std::to_string(m_cursor.query.identifier) + ",";
+        if (m_cursor.query.resolution != ReadingsQuery::Resolution::RAW)
+        {
+            m_pending += R"("resolution":")";
+            m_pending += ReadingsQuery::resolutionToStr(m_cursor.query.resolution);
+            m_pending += R"(",)";
+        }
+        m_pending += R"("values":[)";
+        m_stage = Stage::VALUES;
+        break;
+    case Stage::VALUES:
+        if (m_storage.readJsonValues(m_cursor, batchSize, m_pending) == 0)
+        {
+            m_stage = Stage::FOOTER;
+        }
+        break;
+    case Stage::FOOTER:
+        m_pending = "]}";
+        m_stage = Stage::DONE;
+        break;
+    case Stage::DONE:
+        break;
+    }
+}
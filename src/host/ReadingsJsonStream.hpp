@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ReadingsQuery.hpp"
+#include "ReadingsStorage.hpp"
+
+// Pull-based writer of a sensor data response, for selections too long to be serialized at once.
+// Values are read from the storage a batch at a time, text that doesn't fit into the buffer waits
+// for the next call. Memory stays at one batch whatever the length of the history. The output is
+// the same as of ReadingsStorage::getReadings without downsampling.
+class ReadingsJsonStream
+{
+public:
+    constexpr static std::size_t batchSize = 32;
+
+    ReadingsJsonStream(const ReadingsStorage &storage, const ReadingsQuery &query);
+
+    // Returns the number of bytes written, zero once the whole response was written
+    std::size_t fill(uint8_t *buffer, std::size_t maxLen);
+
+private:
+    enum class Stage
+    {
+        HEADER,
+        VALUES,
+        FOOTER,
+        DONE
+    };
+
+    const ReadingsStorage &m_storage;
+    ReadingsStorage::Cursor m_cursor;
+    Stage m_stage{Stage::HEADER};
+    std::string m_pending;
+    std::size_t m_pendingOffset{0};
+
+    void produce();
+};
@@ -0,0 +1,292 @@
+#include "ReadingsLog.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "Crc32.hpp"
+#include "common/logger.hpp"
+
+ReadingsLog::ReadingsLog(const std::shared_ptr<IFileSystem32Adp> &fileSystem,
+                         std::string pathPrefix)
+    : m_fileSystem(fileSystem)
+    , m_pathPrefix(std::move(pathPrefix))
+{
+}
+
+void ReadingsLog::append(const Record &record)
+{
+    encode(record, &m_pending[m_pendingRecords * frameSize]);
+    ++m_pendingRecords;
+
+    // Records are written in batches to limit flash wear
+    if (m_pendingRecords == batchSize)
+    {
+        flush();
+    }
+}
+
+void ReadingsLog::flush()
+{
+    if (m_pendingRecords == 0)
+    {
+        return;
+    }
+
+    if (!m_scanned)
+    {
+        replay([](const Record &) {});
+    }
+
+    const auto bytesToWrite = m_pendingRecords * frameSize;
+    if (m_activeSegmentSize == 0)
+    {
+        startSegment(m_activeSegment, m_activeSequence);
+    }
+    else if (m_activeSegmentSize + bytesToWrite > maxSegmentSize)
+    {
+        startSegment((m_activeSegment + 1) % segmentsNum, m_activeSequence + 1);
+    }
+
+    auto file = m_fileSystem->open(segmentPath(m_activeSegment), IFileSystem32Adp::Mode::F_APPEND);
+    auto written = file->write(m_pending.data(), bytesToWrite);
+    if (written != bytesToWrite)
+    {
+        logger::logErr("Readings log write failed, %u of %u bytes written", written, bytesToWrite);
+    }
+
+    m_activeSegmentSize += written;
+    m_pendingRecords = 0;
+}
+
+std::size_t ReadingsLog::replay(const ReplayCb &replayCb)
+{
+    std::vector<std::pair<uint32_t, std::size_t>> segments;
+    for (std::size_t segment = 0; segment < segmentsNum; ++segment)
+    {
+        if (auto sequence = readSequence(segment); sequence.has_value())
+        {
+            segments.emplace_back(sequence.value(), segment);
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+
+    std::size_t replayedBytes = 0;
+    for (const auto &[sequence, segment] : segments)
+    {
+        replayedBytes = replaySegment(segment, replayCb);
+    }
+
+    m_scanned = true;
+    if (!segments.empty())
+    {
+        std::tie(m_activeSequence, m_activeSegment) = segments.back();
+        m_activeSegmentSize = replayedBytes;
+    }
+
+    return segments.size();
+}
+
+std::vector<uint32_t> ReadingsLog::closedSegments() const
+{
+    std::vector<uint32_t> sequences;
+    for (std::size_t segment = 0; segment < segmentsNum; ++segment)
+    {
+        if (auto sequence = readSequence(segment); sequence.has_value())
+        {
+            sequences.push_back(sequence.value());
+        }
+    }
+    std::sort(sequences.begin(), sequences.end());
+
+    // The newest segment is the one records are appended to
+    if (!sequences.empty())
+    {
+        sequences.pop_back();
+    }
+    return sequences;
+}
+
+std::optional<std::size_t> ReadingsLog::readSegment(uint32_t sequence, std::size_t firstRecord,
+                                                    std::size_t maxRecords,
+                                                    const ReplayCb &readCb) const
+{
+    // Segments are reused in turn, so a sequence can only be in one of them
+    auto segment = sequence % segmentsNum;
+    if (readSequence(segment) != sequence)
+    {
+        return std::nullopt;
+    }
+
+    auto file = m_fileSystem->open(segmentPath(segment), IFileSystem32Adp::Mode::F_READ);
+    if (!file->seek(headerSize + firstRecord * frameSize))
+    {
+        return 0;
+    }
+
+    std::array<uint8_t, frameSize * framesPerRead> chunk{};
+    std::size_t visited = 0;
+    while (visited < maxRecords)
+    {
+        auto bytesToRead = std::min(maxRecords - visited, framesPerRead) * frameSize;
+        auto readBytes = file->read(chunk.data(), bytesToRead);
+        for (std::size_t offset = 0; offset + frameSize <= readBytes; offset += frameSize)
+        {
+            auto record = decode(&chunk[offset]);
+            if (!record.has_value())
+            {
+                return visited;
+            }
+
+            readCb(record.value());
+            ++visited;
+        }
+
+        if (readBytes < bytesToRead)
+        {
+            break;
+        }
+    }
+    return visited;
+}
+
+std::string ReadingsLog::segmentPath(std::size_t segment) const
+{
+    return m_pathPrefix + std::to_string(segment) + ".log";
+}
+
+std::optional<uint32_t> ReadingsLog::readSequence(std::size_t segment) const
+{
+    auto path = segmentPath(segment);
+    if (!m_fileSystem->exists(path))
+    {
+        return std::nullopt;
+    }
+
+    auto file = m_fileSystem->open(path, IFileSystem32Adp::Mode::F_READ);
+    std::array<uint8_t, headerSize> header{};
+    if (file->read(header.data(), header.size()) != header.size())
+    {
+        return std::nullopt;
+    }
+
+    uint32_t magic = 0;
+    uint32_t sequence = 0;
+    std::memcpy(&magic, header.data(), sizeof(magic));
+    std::memcpy(&sequence, &header[sizeof(magic)], sizeof(sequence));
+
+    if (magic != segmentMagic)
+    {
+        return std::nullopt;
+    }
+    return sequence;
+}
+
+std::size_t ReadingsLog::replaySegment(std::size_t segment, const ReplayCb &replayCb)
+{
+    auto path = segmentPath(segment);
+    std::size_t validSize = headerSize;
+    std::size_t fileSize = 0;
+
+    {
+        auto file = m_fileSystem->open(path, IFileSystem32Adp::Mode::F_READ);
+        fileSize = file->size();
+
+        std::array<uint8_t, headerSize> header{};
+        file->read(header.data(), header.size());
+
+        std::array<uint8_t, frameSize * framesPerRead> chunk{};
+        bool torn = false;
+        while (!torn)
+        {
+            auto readBytes = file->read(chunk.data(), chunk.size());
+            for (std::size_t offset = 0; offset + frameSize <= readBytes; offset += frameSize)
+            {
+                auto record = decode(&chunk[offset]);
+                if (!record.has_value())
+                {
+                    torn = true;
+                    break;
+                }
+
+                replayCb(record.value());
+                validSize += frameSize;
+            }
+
+            if (readBytes < chunk.size())
+            {
+                break;
+            }
+        }
+    }
+
+    if (validSize < fileSize)
+    {
+        logger::logWrn("Readings log %s has torn tail, truncating %u bytes", path,
+                       fileSize - validSize);
+        m_fileSystem->truncate(path, validSize);
+    }
+
+    return validSize;
+}
+
+void ReadingsLog::startSegment(std::size_t segment, uint32_t sequence)
+{
+    std::array<uint8_t, headerSize> header{};
+    std::memcpy(header.data(), &segmentMagic, sizeof(segmentMagic));
+    std::memcpy(&header[sizeof(segmentMagic)], &sequence, sizeof(sequence));
+
+    auto file = m_fileSystem->open(segmentPath(segment), IFileSystem32Adp::Mode::F_WRITE);
+    file->write(header.data(), header.size());
+
+    m_activeSegment = segment;
+    m_activeSequence = sequence;
+    m_activeSegmentSize = headerSize;
+}
+
+void ReadingsLog::encode(const Record &record, uint8_t *frame)
+{
+    auto identifier = static_cast<uint64_t>(record.identifier);
+    auto epochTime = static_cast<uint32_t>(record.epochTime);
+
+    auto *payload = frame + 1;  // NOLINT
+    frame[0] = payloadSize;     // NOLINT
+    std::memcpy(payload, &identifier, sizeof(identifier));
+    payload += sizeof(identifier);  // NOLINT
+    std::memcpy(payload, &record.temperature, sizeof(record.temperature));
+    payload += sizeof(record.temperature);  // NOLINT
+    std::memcpy(payload, &record.humidity, sizeof(record.humidity));
+    payload += sizeof(record.humidity);  // NOLINT
+    std::memcpy(payload, &epochTime, sizeof(epochTime));
+    payload += sizeof(epochTime);  // NOLINT
+
+    auto crc = crc32::calculate(frame, frameSize - sizeof(uint32_t));
+    std::memcpy(payload, &crc, sizeof(crc));
+}
+
+std::optional<ReadingsLog::Record> ReadingsLog::decode(const uint8_t *frame)
+{
+    uint32_t crc = 0;
+    std::memcpy(&crc, frame + frameSize - sizeof(crc), sizeof(crc));  // NOLINT
+    if (frame[0] != payloadSize || crc != crc32::calculate(frame, frameSize - sizeof(crc)))
+    {
+        return std::nullopt;
+    }
+
+    uint64_t identifier = 0;
+    uint32_t epochTime = 0;
+    Record record{};
+
+    const auto *payload = frame + 1;  // NOLINT
+    std::memcpy(&identifier, payload, sizeof(identifier));
+    payload += sizeof(identifier);  // NOLINT
+    std::memcpy(&record.temperature, payload, sizeof(record.temperature));
+    payload += sizeof(record.temperature);  // NOLINT
+    std::memcpy(&record.humidity, payload, sizeof(record.humidity));
+    payload += sizeof(record.humidity);  // NOLINT
+    std::memcpy(&epochTime, payload, sizeof(epochTime));
+
+    record.identifier = static_cast<IDType>(identifier);
+    record.epochTime = epochTime;
+    return record;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "adapters/IFileSystem32Adp.hpp"
+#include "common/types.hpp"
+
+// Append-only binary log of readings, kept in a fixed number of rotating segment files.
+// Every record is framed with its length and CRC, so a record torn by a power loss is detected
+// (and cut off) during replay.
+class ReadingsLog
+{
+public:
+    struct Record
+    {
+        IDType identifier;
+        float temperature;
+        float humidity;
+        unsigned long epochTime;
+    };
+
+    using ReplayCb = std::function<void(const Record &record)>;
+
+    ReadingsLog(const std::shared_ptr<IFileSystem32Adp> &fileSystem, std::string pathPrefix);
+
+    void append(const Record &record);
+    void flush();
+    std::size_t replay(const ReplayCb &replayCb);
+
+    // Sequences of the segments which are no longer written to, oldest first
+    [[nodiscard]] std::vector<uint32_t> closedSegments() const;
+    // Visits up to maxRecords records of a segment, starting with the given one. Returns the number
+    // of visited records, or nothing when the segment was already reused for newer records.
+    std::optional<std::size_t> readSegment(uint32_t sequence, std::size_t firstRecord,
+                                           std::size_t maxRecords, const ReplayCb &readCb) const;
+
+    // Flash taken by all segments once they are full
+    constexpr static std::size_t maxBytes()
+    {
+        return segmentsNum * maxSegmentSize;
+    }
+
+private:
+    constexpr static std::size_t segmentsNum = 4;
+    constexpr static std::size_t maxSegmentSize = 16 * 1024;
+    constexpr static std::size_t batchSize = 16;
+    constexpr static std::size_t framesPerRead = 16;
+    constexpr static uint32_t segmentMagic = 0x474C4854;  // "THLG"
+
+    constexpr static std::size_t headerSize = sizeof(segmentMagic) + sizeof(uint32_t);
+    constexpr static std::size_t payloadSize
+        = sizeof(uint64_t) + sizeof(float) + sizeof(float) + sizeof(uint32_t);
+    constexpr static std::size_t frameSize = sizeof(uint8_t) + payloadSize + sizeof(uint32_t);
+
+    using Frame = std::array<uint8_t, frameSize>;
+
+    std::shared_ptr<IFileSystem32Adp> m_fileSystem;
+    std::string m_pathPrefix;
+
+    std::array<uint8_t, frameSize * batchSize> m_pending{};
+    std::size_t m_pendingRecords{0};
+
+    bool m_scanned = false;
+    std::size_t m_activeSegment{0};
+    uint32_t m_activeSequence{0};
+    std::size_t m_activeSegmentSize{0};
+
+    [[nodiscard]] std::string segmentPath(std::size_t segment) const;
+    [[nodiscard]] std::optional<uint32_t> readSequence(std::size_t segment) const;
+    std::size_t replaySegment(std::size_t segment, const ReplayCb &replayCb);
+    void startSegment(std::size_t segment, uint32_t sequence);
+
+    static void encode(const Record &record, uint8_t *frame);
+    static std::optional<Record> decode(const uint8_t *frame);
+};
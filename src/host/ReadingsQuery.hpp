@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "common/types.hpp"
+
+struct ReadingsQuery
+{
+    enum class Resolution
+    {
+        AUTO,
+        RAW,
+        MINUTES_5,
+        HOURLY,
+        DAILY
+    };
+
+    // How the response is written, negotiated with the Accept header
+    enum class Encoding
+    {
+        JSON,
+        CBOR,
+        MSGPACK,
+        PACKED
+    };
+
+    IDType identifier;
+    Resolution resolution = Resolution::AUTO;
+    std::optional<unsigned long> from = std::nullopt;
+    std::optional<unsigned long> to = std::nullopt;
+    std::optional<std::size_t> maxPoints = std::nullopt;
+    Encoding encoding = Encoding::JSON;
+
+    static std::optional<Resolution> resolutionFromStr(const std::string &name)
+    {
+        for (const auto &[resolution, resolutionName] : resolutionNames)
+        {
+            if (name == resolutionName)
+            {
+                return resolution;
+            }
+        }
+        return std::nullopt;
+    }
+
+    static const char *resolutionToStr(Resolution resolution)
+    {
+        for (const auto &[knownResolution, resolutionName] : resolutionNames)
+        {
+            if (resolution == knownResolution)
+            {
+                return resolutionName;
+            }
+        }
+        return "";
+    }
+
+    // The first supported media type of the header, in the order the client listed them.
+    // Quality values are ignored, JSON is the default.
+    static Encoding encodingFromAccept(std::string_view accept)
+    {
+        while (!accept.empty())
+        {
+            auto end = accept.find(',');
+            auto mediaType = accept.substr(0, std::min(end, accept.find(';')));
+            accept = end == std::string_view::npos ? std::string_view{} : accept.substr(end + 1);
+
+            const auto first = mediaType.find_first_not_of(' ');
+            const auto last = mediaType.find_last_not_of(' ');
+            if (first == std::string_view::npos)
+            {
+                continue;
+            }
+            mediaType = mediaType.substr(first, last - first + 1);
+            for (const auto &[encoding, contentType] : contentTypes)
+            {
+                if (mediaType == contentType)
+                {
+                    return encoding;
+                }
+            }
+        }
+        return Encoding::JSON;
+    }
+
+    static const char *contentType(Encoding encoding)
+    {
+        for (const auto &[knownEncoding, contentType] : contentTypes)
+        {
+            if (encoding == knownEncoding)
+            {
+                return contentType;
+            }
+        }
+        return "application/json";
+    }
+
+private:
+    constexpr static std::array<std::pair<Resolution, const char *>, 5> resolutionNames{{
+        {Resolution::AUTO, "auto"},
+        {Resolution::RAW, "raw"},
+        {Resolution::MINUTES_5, "5min"},
+        {Resolution::HOURLY, "hour"},
+        {Resolution::DAILY, "day"},
+    }};
+    constexpr static std::array<std::pair<Encoding, const char *>, 4> contentTypes{{
+        {Encoding::JSON, "application/json"},
+        {Encoding::CBOR, "application/cbor"},
+        {Encoding::MSGPACK, "application/msgpack"},
+        {Encoding::PACKED, "application/octet-stream"},
+    }};
+};
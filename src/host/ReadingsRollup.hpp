@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <optional>
+
+#include "Quantization.hpp"
+#include "RingBuffer.hpp"
+
+// Aggregate of all readings which fall into one time bucket, values are quantized to hundredths
+struct RollupBucket
+{
+    uint32_t startEpoch;
+    uint16_t count;
+    int16_t minTemperature;
+    int16_t maxTemperature;
+    int16_t avgTemperature;
+    uint16_t minHumidity;
+    uint16_t maxHumidity;
+    uint16_t avgHumidity;
+};
+
+template <uint32_t bucketSeconds, uint16_t size>
+class RollupTier
+{
+    using BucketsRingBuffer = RingBuffer<RollupBucket, size>;
+
+public:
+    constexpr static auto secondsPerBucket = bucketSeconds;
+
+    void add(float temperature, float humidity, unsigned long epochTime)
+    {
+        auto bucketStart = static_cast<uint32_t>(epochTime - epochTime % bucketSeconds);
+        if (m_current.count != 0 && bucketStart != m_current.startEpoch)
+        {
+            m_buckets.put(m_current.toBucket());
+            m_current = {};
+        }
+
+        if (m_current.count == 0)
+        {
+            m_current.startEpoch = bucketStart;
+            m_current.minTemperature = m_current.maxTemperature = temperature;
+            m_current.minHumidity = m_current.maxHumidity = humidity;
+        }
+
+        ++m_current.count;
+        m_current.sumTemperature += temperature;
+        m_current.sumHumidity += humidity;
+        m_current.minTemperature = std::min(m_current.minTemperature, temperature);
+        m_current.maxTemperature = std::max(m_current.maxTemperature, temperature);
+        m_current.minHumidity = std::min(m_current.minHumidity, humidity);
+        m_current.maxHumidity = std::max(m_current.maxHumidity, humidity);
+    }
+
+    // Calls fun for every closed bucket and finally for the bucket being currently filled
+    template <typename Fun>
+    void forEach(Fun fun) const
+    {
+        for (const auto &bucket : m_buckets)
+        {
+            fun(bucket);
+        }
+
+        if (m_current.count != 0)
+        {
+            fun(m_current.toBucket());
+        }
+    }
+
+    [[nodiscard]] std::optional<uint32_t> oldestEpoch() const
+    {
+        if (!m_buckets.empty())
+        {
+            return m_buckets[0].startEpoch;
+        }
+        if (m_current.count != 0)
+        {
+            return m_current.startEpoch;
+        }
+        return std::nullopt;
+    }
+
+private:
+    struct Accumulator
+    {
+        uint32_t startEpoch{0};
+        uint16_t count{0};
+        float sumTemperature{0};
+        float minTemperature{0};
+        float maxTemperature{0};
+        float sumHumidity{0};
+        float minHumidity{0};
+        float maxHumidity{0};
+
+        [[nodiscard]] RollupBucket toBucket() const
+        {
+            return {startEpoch,
+                    count,
+                    quantization::toCentiTemperature(minTemperature),
+                    quantization::toCentiTemperature(maxTemperature),
+                    quantization::toCentiTemperature(sumTemperature / count),
+                    quantization::toCentiHumidity(minHumidity),
+                    quantization::toCentiHumidity(maxHumidity),
+                    quantization::toCentiHumidity(sumHumidity / count)};
+        }
+    };
+
+    BucketsRingBuffer m_buckets;
+    Accumulator m_current;
+};
@@ -1,46 +1,334 @@
 #include "ReadingsStorage.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdio>
+#include <limits>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include "Crc32.hpp"
+#include "Lttb.hpp"
+#include "PackedReadings.hpp"
 #include "common/logger.hpp"
 
+namespace
+{
+// Suspect readings get a fourth element, so clients can tell them apart
+template <typename Reading>
+nlohmann::json readingToJson(const Reading &reading)
+{
+    auto json = nlohmann::json::array({reading.epochTime, reading.temperature, reading.humidity});
+    if (reading.suspect)
+    {
+        json.push_back(true);
+    }
+    return json;
+}
+
+// Closed time range of a query in the 32 bit epochs of stored readings
+std::pair<uint32_t, uint32_t> epochRange(const ReadingsQuery &query)
+{
+    constexpr unsigned long maxEpoch = std::numeric_limits<uint32_t>::max();
+    return {static_cast<uint32_t>(std::min(query.from.value_or(0), maxEpoch)),
+            static_cast<uint32_t>(std::min(query.to.value_or(maxEpoch), maxEpoch))};
+}
+
+// Calls fun for the buckets of the tier which overlap the closed time range
+template <typename Tier, typename Fun>
+void forEachBucketIn(const Tier &tier, uint32_t from, uint32_t to, Fun fun)
+{
+    tier.forEach(
+        [&tier, from, to, &fun](const RollupBucket &bucket)
+        {
+            if (bucket.startEpoch + tier.secondsPerBucket > from && bucket.startEpoch <= to)
+            {
+                fun(bucket);
+            }
+        });
+}
+
+nlohmann::json bucketToJson(const RollupBucket &bucket)
+{
+    return {bucket.startEpoch,
+            quantization::fromCenti(bucket.avgTemperature),
+            quantization::fromCenti(bucket.avgHumidity),
+            quantization::fromCenti(bucket.minTemperature),
+            quantization::fromCenti(bucket.maxTemperature),
+            quantization::fromCenti(bucket.minHumidity),
+            quantization::fromCenti(bucket.maxHumidity),
+            bucket.count};
+}
+
+// Same layout as rollup buckets, with the median for the average and the 5th and 95th percentile
+// for the extremes
+nlohmann::json quantilesToJson(const QuantilesDay &day)
+{
+    return {day.startEpoch,
+            quantization::fromCenti(day.temperature.p50),
+            quantization::fromCenti(day.humidity.p50),
+            quantization::fromCenti(day.temperature.p5),
+            quantization::fromCenti(day.temperature.p95),
+            quantization::fromCenti(day.humidity.p5),
+            quantization::fromCenti(day.humidity.p95),
+            day.count};
+}
+
+// Counts are flattened hour by hour, bins of hour 0 (UTC) first
+template <int16_t minValue, uint8_t binWidth, uint8_t binsNum>
+nlohmann::json heatmapToJson(const HourOfDayHistogram<minValue, binWidth, binsNum> &heatmap)
+{
+    return {{"min", minValue},
+            {"binWidth", binWidth},
+            {"bins", binsNum},
+            {"counts", heatmap.counts()}};
+}
+
+nlohmann::json statsToJson(const std::optional<WindowStats> &stats)
+{
+    if (!stats.has_value())
+    {
+        return nullptr;
+    }
+
+    auto metricToJson = [](const WindowStats::Metric &metric) -> nlohmann::json
+    {
+        return {{"min", metric.min},
+                {"max", metric.max},
+                {"mean", metric.mean},
+                {"stddev", metric.stddev}};
+    };
+
+    return {{"count", stats->count},
+            {"temperature", metricToJson(stats->temperature)},
+            {"humidity", metricToJson(stats->humidity)}};
+}
+
+// Calls fun with indices of all points or, when maxPoints is set, of the LTTB selection
+template <typename XFun, typename YFun, typename Fun>
+void forEachSelected(std::size_t count,
+                     const std::optional<std::size_t> &maxPoints,
+                     XFun x,
+                     YFun y,
+                     Fun fun)
+{
+    if (maxPoints.has_value() && count > maxPoints.value())
+    {
+        for (auto idx : lttb::select(count, maxPoints.value(), x, y))
+        {
+            fun(idx);
+        }
+        return;
+    }
+
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        fun(idx);
+    }
+}
+}  // namespace
+
+ReadingsStorage::ReadingsStorage(const std::shared_ptr<ReadingsLog> &readingsLog)
+    : m_readingsLog(readingsLog)
+{
+}
+
 void ReadingsStorage::addReading(IDType identifier,
                                  float temperature,
                                  float humidity,
                                  unsigned long epochTime)
 {
-    m_readingBuffers[identifier].put({temperature, humidity, epochTime});
+    storeReading(identifier, temperature, humidity, epochTime);
+
+    if (m_readingsLog)
+    {
+        m_readingsLog->append({identifier, temperature, humidity, epochTime});
+    }
+}
+
+void ReadingsStorage::restoreFromLog()
+{
+    if (!m_readingsLog)
+    {
+        return;
+    }
+
+    std::size_t restored = 0;
+    m_readingsLog->replay(
+        [this, &restored](const ReadingsLog::Record &record)
+        {
+            storeReading(record.identifier, record.temperature, record.humidity,
+                         record.epochTime);
+            ++restored;
+        });
+    logger::logInf("Restored %u readings from log", restored);
 }
 
-std::string ReadingsStorage::getReadingsAsJsonStr(IDType identifier)
+std::string ReadingsStorage::getReadingsAsJsonStr(IDType identifier) const
 {
-    ReadingsRingBuffer &readingsBuffer = m_readingBuffers[identifier];
-    auto jsonData = nlohmann::json::array();
+    return getReadingsAsJsonStr(ReadingsQuery{identifier});
+}
+
+std::string ReadingsStorage::getReadingsAsJsonStr(const ReadingsQuery &query) const
+{
+    auto jsonQuery = query;
+    jsonQuery.encoding = ReadingsQuery::Encoding::JSON;
+    return *getReadings(jsonQuery);
+}
 
-    for (const auto &reading : readingsBuffer)
+std::shared_ptr<const std::string> ReadingsStorage::getReadings(
+    const ReadingsQuery &query) const
+{
+    if (auto key = m_seqlock.read([this, &query] { return responseCacheKey(query); }); key)
     {
-        jsonData.push_back({reading.epochTime, reading.temperature, reading.humidity});
+        if (auto cached = findCachedResponse(query.identifier, key.value()); cached)
+        {
+            return cached;
+        }
     }
 
-    auto json = nlohmann::json();
-    json["values"] = jsonData;
-    json["identifier"] = identifier;
+    // The key is taken again with the snapshot, readings may have come in meanwhile
+    auto [snapshot, key] = m_seqlock.read(
+        [this, &query] { return std::make_pair(takeSnapshot(query), responseCacheKey(query)); });
+    auto serialized = std::make_shared<const std::string>(encode(snapshot, query));
+    if (key.has_value())
+    {
+        cacheResponse(query.identifier, key.value(), serialized);
+    }
+    return serialized;
+}
 
-    return json.dump();
+std::optional<std::string> ReadingsStorage::getReadingsETag(const ReadingsQuery &query) const
+{
+    auto key = m_seqlock.read([this, &query] { return responseCacheKey(query); });
+    if (!key.has_value())
+    {
+        return std::nullopt;
+    }
+
+    // The stamp moves with every reading of the sensor, the checksum tells selections apart
+    const std::array<uint32_t, 5> selection{
+        static_cast<uint32_t>(key->resolution), key->firstEpoch,
+        static_cast<uint32_t>(key->count), static_cast<uint32_t>(key->maxPoints),
+        static_cast<uint32_t>(key->encoding)};
+    const auto *bytes = reinterpret_cast<const uint8_t *>(selection.data());  // NOLINT
+    const auto checksum = crc32::calculate(bytes, sizeof(selection));
+    std::array<char, 2 * 8 + 2> etag{};
+    std::snprintf(etag.data(), etag.size(), "%08lx-%08lx", static_cast<unsigned long>(key->stamp),
+                  static_cast<unsigned long>(checksum));
+    return etag.data();
+}
+
+ReadingsStorage::Cursor ReadingsStorage::openCursor(const ReadingsQuery &query) const
+{
+    Cursor cursor{query};
+    cursor.query.maxPoints = std::nullopt;
+    if (query.resolution == ReadingsQuery::Resolution::AUTO)
+    {
+        cursor.query.resolution = m_seqlock.read(
+            [this, &query]
+            {
+                const SensorHistory *history = m_sensors.find(query.identifier);
+                return history != nullptr ? selectResolution(*history, query)
+                                          : ReadingsQuery::Resolution::RAW;
+            });
+    }
+    return cursor;
+}
+
+std::size_t ReadingsStorage::readJsonValues(Cursor &cursor,
+                                            std::size_t maxValues,
+                                            std::string &out) const
+{
+    auto snapshot = m_seqlock.read(
+        [this, &cursor, maxValues]
+        {
+            return takeSnapshot(cursor.query, cursor.lastEpoch, cursor.readAtLastEpoch,
+                                maxValues);
+        });
+
+    auto append = [&cursor, &out](uint32_t epochTime, const nlohmann::json &value)
+    {
+        if (cursor.read != 0)
+        {
+            out += ',';
+        }
+        if (cursor.read != 0 && epochTime == cursor.lastEpoch)
+        {
+            ++cursor.readAtLastEpoch;
+        }
+        else
+        {
+            cursor.lastEpoch = epochTime;
+            cursor.readAtLastEpoch = 1;
+        }
+        ++cursor.read;
+        out += value.dump();
+    };
+
+    for (const auto &reading : snapshot.raw)
+    {
+        append(reading.epochTime, readingToJson(reading));
+    }
+    for (const auto &bucket : snapshot.buckets)
+    {
+        append(bucket.startEpoch, bucketToJson(bucket));
+    }
+    return snapshot.raw.size() + snapshot.buckets.size();
+}
+
+std::shared_ptr<const std::string> ReadingsStorage::findCachedResponse(
+    IDType identifier,
+    const ResponseCacheKey &key) const
+{
+    std::lock_guard<std::mutex> lock(m_responseCacheMutex);
+    const CachedResponse *cached = m_responseCache.find(identifier);
+    return cached != nullptr && cached->key == key ? cached->response : nullptr;
+}
+
+void ReadingsStorage::cacheResponse(IDType identifier,
+                                    const ResponseCacheKey &key,
+                                    const std::shared_ptr<const std::string> &response) const
+{
+    std::lock_guard<std::mutex> lock(m_responseCacheMutex);
+    CachedResponse *cached = m_responseCache.insert(identifier);
+    if (cached == nullptr)
+    {
+        // Evicted sensors leave their entries behind, the least recently changed one goes
+        std::optional<IDType> oldest;
+        uint32_t oldestStamp = std::numeric_limits<uint32_t>::max();
+        m_responseCache.forEach(
+            [&oldest, &oldestStamp](IDType sensorId, const CachedResponse &entry)
+            {
+                if (entry.key.stamp < oldestStamp)
+                {
+                    oldest = sensorId;
+                    oldestStamp = entry.key.stamp;
+                }
+            });
+        m_responseCache.erase(oldest.value());
+        cached = m_responseCache.insert(identifier);
+    }
+    *cached = {key, response};
 }
 
-std::string ReadingsStorage::getLastReadingAsJsonStr(IDType identifier)
+std::string ReadingsStorage::getLastReadingAsJsonStr(IDType identifier) const
 {
-    ReadingsRingBuffer &readingsBuffer = m_readingBuffers[identifier];
-    const auto &lastReading = readingsBuffer.getLast();
+    auto last = m_seqlock.read(
+        [this, identifier]
+        {
+            const SensorHistory *history = m_sensors.find(identifier);
+            return history != nullptr ? m_rawReadings.last(history->raw) : std::nullopt;
+        });
 
     auto json = nlohmann::json();
-    if (readingsBuffer.begin() != readingsBuffer.end())
+    if (last.has_value())
     {
-        auto jsonData = nlohmann::json::array(
-            {{lastReading.epochTime, lastReading.temperature, lastReading.humidity}});
+        auto jsonData = nlohmann::json::array();
+        jsonData.push_back(readingToJson(last.value()));
         json["values"] = jsonData;
     }
     else
@@ -51,3 +339,477 @@ std::string ReadingsStorage::getLastReadingAsJsonStr(IDType identifier)
 
     return json.dump();
 }
+
+std::string ReadingsStorage::getStatsAsJsonStr(IDType identifier) const
+{
+    using WindowsStats = std::pair<std::optional<WindowStats>, std::optional<WindowStats>>;
+    auto stats = m_seqlock.read(
+        [this, identifier]
+        {
+            const SensorHistory *history = m_sensors.find(identifier);
+            return history != nullptr
+                       ? WindowsStats{history->lastHour.stats(), history->lastDay.stats()}
+                       : WindowsStats{};
+        });
+
+    auto json = nlohmann::json();
+    json["identifier"] = identifier;
+    json["1h"] = statsToJson(stats.first);
+    json["24h"] = statsToJson(stats.second);
+
+    return json.dump();
+}
+
+std::string ReadingsStorage::getQuantilesAsJsonStr(IDType identifier) const
+{
+    auto days = m_seqlock.read(
+        [this, identifier]
+        {
+            std::vector<QuantilesDay> copy;
+            if (const SensorHistory *history = m_sensors.find(identifier); history != nullptr)
+            {
+                history->quantiles.forEach([&copy](const QuantilesDay &day)
+                                           { copy.push_back(day); });
+            }
+            return copy;
+        });
+
+    auto jsonData = nlohmann::json::array();
+    for (const auto &day : days)
+    {
+        jsonData.push_back(quantilesToJson(day));
+    }
+
+    auto json = nlohmann::json();
+    json["values"] = jsonData;
+    json["identifier"] = identifier;
+
+    return json.dump();
+}
+
+std::string ReadingsStorage::getHeatmapAsJsonStr(IDType identifier) const
+{
+    // Copied to the heap, the web handler task has a small stack
+    auto heatmaps = std::make_unique<std::pair<TemperatureHeatmap, HumidityHeatmap>>();
+    const bool found = m_seqlock.read(
+        [this, identifier, &heatmaps]
+        {
+            const SensorHistory *history = m_sensors.find(identifier);
+            if (history == nullptr)
+            {
+                return false;
+            }
+            heatmaps->first = history->temperatureHeatmap;
+            heatmaps->second = history->humidityHeatmap;
+            return true;
+        });
+
+    auto json = nlohmann::json();
+    json["identifier"] = identifier;
+    json["temperature"] = found ? heatmapToJson(heatmaps->first) : nlohmann::json();
+    json["humidity"] = found ? heatmapToJson(heatmaps->second) : nlohmann::json();
+
+    return json.dump();
+}
+
+void ReadingsStorage::storeReading(IDType identifier,
+                                   float temperature,
+                                   float humidity,
+                                   unsigned long epochTime)
+{
+    bool stored = false;
+    m_seqlock.write(
+        [&]
+        {
+            auto *history = findOrAddSensor(identifier);
+            if (history == nullptr)
+            {
+                return;
+            }
+
+            history->stamp = ++m_lastStamp;
+            auto suspect = checkOutlier(*history, temperature, humidity);
+            auto intervalChanged = updateMeanInterval(*history, epochTime);
+            m_rawReadings.put(history->raw, epochTime, temperature, humidity, suspect);
+            if (intervalChanged)
+            {
+                rebalanceRawQuotas();
+            }
+            stored = true;
+            if (suspect)
+            {
+                return;
+            }
+
+            history->minutes5.add(temperature, humidity, epochTime);
+            history->hourly.add(temperature, humidity, epochTime);
+            history->daily.add(temperature, humidity, epochTime);
+            history->lastHour.add(temperature, humidity, epochTime);
+            history->lastDay.add(temperature, humidity, epochTime);
+            history->quantiles.add(temperature, humidity, epochTime);
+            history->temperatureHeatmap.add(temperature, epochTime);
+            history->humidityHeatmap.add(humidity, epochTime);
+        });
+
+    if (!stored)
+    {
+        logger::logErr("No space for readings of sensor %u", identifier);
+    }
+}
+
+void ReadingsStorage::setRawHistoryHorizon(uint32_t seconds)
+{
+    m_seqlock.write(
+        [this, seconds]
+        {
+            m_rawHistoryHorizonSecs = seconds;
+            rebalanceRawQuotas();
+        });
+}
+
+void ReadingsStorage::setOutlierThreshold(float threshold)
+{
+    m_seqlock.write([this, threshold] { m_outlierThreshold = threshold; });
+}
+
+bool ReadingsStorage::checkOutlier(SensorHistory &history, float temperature, float humidity) const
+{
+    if (m_outlierThreshold <= 0)
+    {
+        return false;
+    }
+
+    // Both windows take every reading, whichever metric flags it
+    auto temperatureOutlier = history.temperatureFilter.check(temperature, m_outlierThreshold,
+                                                              minTemperatureDeviation);
+    auto humidityOutlier
+        = history.humidityFilter.check(humidity, m_outlierThreshold, minHumidityDeviation);
+    return temperatureOutlier || humidityOutlier;
+}
+
+bool ReadingsStorage::updateMeanInterval(SensorHistory &history, unsigned long epochTime)
+{
+    constexpr auto smoothing = 0.125F;
+
+    auto last = m_rawReadings.last(history.raw);
+    if (!last.has_value() || epochTime <= last->epochTime)
+    {
+        return false;
+    }
+
+    // Gaps longer than the horizon are outages, not the reporting period
+    auto interval = static_cast<float>(
+        std::min<unsigned long>(epochTime - last->epochTime, m_rawHistoryHorizonSecs));
+    auto previousMean = history.meanIntervalSecs;
+    history.meanIntervalSecs = previousMean == 0
+                                   ? interval
+                                   : previousMean + smoothing * (interval - previousMean);
+
+    // Jitter of a few seconds does not change quotas enough to rebalance on every reading
+    constexpr auto rebalanceThreshold = 0.05F;
+    auto change = std::fabs(history.meanIntervalSecs - previousMean);
+    return previousMean == 0 || change > rebalanceThreshold * previousMean;
+}
+
+void ReadingsStorage::rebalanceRawQuotas()
+{
+    // Blocks needed to cover the horizon, plus the one being filled
+    auto blocksForHorizon = [this](const SensorHistory &history)
+    {
+        constexpr auto minBlocks = 2.0F;
+        if (history.meanIntervalSecs == 0)
+        {
+            return minBlocks;
+        }
+        auto readings = static_cast<float>(m_rawHistoryHorizonSecs) / history.meanIntervalSecs;
+        return std::max(std::ceil(readings / readingsPerBlock) + 1, minBlocks);
+    };
+
+    float neededBlocks = 0;
+    m_sensors.forEach([&neededBlocks, &blocksForHorizon](IDType, const SensorHistory &history)
+                      { neededBlocks += blocksForHorizon(history); });
+
+    // Equal, shorter horizon for all sensors when the pool can't hold the configured one
+    auto scale = std::min(1.0F, static_cast<float>(readingsBlocksNum) / neededBlocks);
+    m_sensors.forEach(
+        [this, scale, &blocksForHorizon](IDType, SensorHistory &history)
+        {
+            auto quota = std::max(1.0F, std::floor(blocksForHorizon(history) * scale));
+            m_rawReadings.setQuota(history.raw, static_cast<uint16_t>(quota));
+        });
+}
+
+ReadingsStorage::SensorHistory *ReadingsStorage::findOrAddSensor(IDType identifier)
+{
+    if (auto *history = m_sensors.find(identifier); history != nullptr)
+    {
+        return history;
+    }
+
+    if (m_sensors.full())
+    {
+        // Only removed sensors stop reporting, so the one silent for the longest time goes away
+        std::optional<IDType> stalest;
+        uint32_t stalestEpoch = std::numeric_limits<uint32_t>::max();
+        m_sensors.forEach(
+            [this, &stalest, &stalestEpoch](IDType sensorId, const SensorHistory &history)
+            {
+                auto last = m_rawReadings.last(history.raw);
+                auto lastEpoch = last.has_value() ? last->epochTime : 0;
+                if (!stalest.has_value() || lastEpoch < stalestEpoch)
+                {
+                    stalest = sensorId;
+                    stalestEpoch = lastEpoch;
+                }
+            });
+
+        logger::logWrn("Readings table full, dropping history of sensor %u", stalest.value());
+        m_rawReadings.release(m_sensors.find(stalest.value())->raw);
+        m_sensors.erase(stalest.value());
+    }
+
+    return m_sensors.insert(identifier);
+}
+
+// Runs under m_seqlock, so it only copies and everything it follows is bounds-checked
+ReadingsStorage::Snapshot ReadingsStorage::takeSnapshot(const ReadingsQuery &query,
+                                                        uint32_t resumeEpoch,
+                                                        std::size_t resumeSkip,
+                                                        std::size_t limit) const
+{
+    Snapshot snapshot;
+    const SensorHistory *history = m_sensors.find(query.identifier);
+    snapshot.resolution = query.resolution;
+    if (snapshot.resolution == ReadingsQuery::Resolution::AUTO)
+    {
+        snapshot.resolution = history != nullptr ? selectResolution(*history, query)
+                                                 : ReadingsQuery::Resolution::RAW;
+    }
+    if (history == nullptr)
+    {
+        return snapshot;
+    }
+
+    const auto [queryFrom, to] = epochRange(query);
+    const auto from = std::max(queryFrom, resumeEpoch);
+    // Values come in epoch order, so those read already are the first ones at the resume epoch
+    std::size_t toSkip = resumeSkip;
+    auto readAlready = [&toSkip, resumeEpoch](uint32_t epochTime)
+    {
+        if (epochTime == resumeEpoch && toSkip != 0)
+        {
+            --toSkip;
+            return true;
+        }
+        // A bucket overlapping the resume epoch was read already
+        return epochTime < resumeEpoch;
+    };
+    auto copyBuckets = [&snapshot, &readAlready, from, to = to, limit](const auto &tier)
+    {
+        forEachBucketIn(tier, from, to,
+                        [&snapshot, &readAlready, limit](const RollupBucket &bucket)
+                        {
+                            if (!readAlready(bucket.startEpoch) && snapshot.buckets.size() < limit)
+                            {
+                                snapshot.buckets.push_back(bucket);
+                            }
+                        });
+    };
+
+    switch (snapshot.resolution)
+    {
+    case ReadingsQuery::Resolution::AUTO:
+    case ReadingsQuery::Resolution::RAW:
+    {
+        auto readings = m_rawReadings.range(history->raw, from, to);
+        snapshot.raw.reserve(std::min(readings.size(), limit));
+        for (std::size_t idx = 0; idx < readings.size() && snapshot.raw.size() < limit; ++idx)
+        {
+            // Downsampling keeps extremes, it would pick exactly the suspect spikes
+            auto reading = readings.at(idx);
+            if (readAlready(reading.epochTime))
+            {
+                continue;
+            }
+            if (!reading.suspect || !query.maxPoints.has_value())
+            {
+                snapshot.raw.push_back(reading);
+            }
+        }
+        break;
+    }
+    case ReadingsQuery::Resolution::MINUTES_5:
+        copyBuckets(history->minutes5);
+        break;
+    case ReadingsQuery::Resolution::HOURLY:
+        copyBuckets(history->hourly);
+        break;
+    case ReadingsQuery::Resolution::DAILY:
+        copyBuckets(history->daily);
+        break;
+    }
+    return snapshot;
+}
+
+std::string ReadingsStorage::encode(const Snapshot &snapshot, const ReadingsQuery &query)
+{
+    if (query.encoding == ReadingsQuery::Encoding::PACKED)
+    {
+        // The snapshot is already a copy, only a downsampled selection needs another one
+        Snapshot selected{};
+        selected.resolution = snapshot.resolution;
+        if (query.maxPoints.has_value())
+        {
+            forEachValue(
+                snapshot, query, [&selected](const auto &reading)
+                { selected.raw.push_back(reading); },
+                [&selected](const RollupBucket &bucket) { selected.buckets.push_back(bucket); });
+        }
+        const auto &values = query.maxPoints.has_value() ? selected : snapshot;
+        return values.resolution == ReadingsQuery::Resolution::RAW
+                   ? packed_readings::encode(query.identifier, values.raw)
+                   : packed_readings::encode(query.identifier, values.resolution, values.buckets);
+    }
+
+    auto jsonData = nlohmann::json::array();
+    forEachValue(
+        snapshot, query, [&jsonData](const auto &reading)
+        { jsonData.push_back(readingToJson(reading)); },
+        [&jsonData](const RollupBucket &bucket) { jsonData.push_back(bucketToJson(bucket)); });
+
+    auto json = nlohmann::json();
+    json["values"] = jsonData;
+    json["identifier"] = query.identifier;
+    if (snapshot.resolution != ReadingsQuery::Resolution::RAW)
+    {
+        json["resolution"] = ReadingsQuery::resolutionToStr(snapshot.resolution);
+    }
+
+    // Binary encodings of the same document, floats stay doubles there
+    std::string encoded;
+    switch (query.encoding)
+    {
+    case ReadingsQuery::Encoding::CBOR:
+        nlohmann::json::to_cbor(json, encoded);
+        break;
+    case ReadingsQuery::Encoding::MSGPACK:
+        nlohmann::json::to_msgpack(json, encoded);
+        break;
+    default:
+        encoded = json.dump();
+        break;
+    }
+    return encoded;
+}
+
+// Values of the snapshot left after downsampling to query.maxPoints
+template <typename RawFun, typename BucketFun>
+void ReadingsStorage::forEachValue(const Snapshot &snapshot,
+                                   const ReadingsQuery &query,
+                                   RawFun rawFun,
+                                   BucketFun bucketFun)
+{
+    if (snapshot.resolution == ReadingsQuery::Resolution::RAW)
+    {
+        const auto &readings = snapshot.raw;
+        forEachSelected(
+            readings.size(), query.maxPoints, [&readings](std::size_t idx)
+            { return readings[idx].epochTime; },
+            [&readings](std::size_t idx)
+            { return std::array<double, 2>{readings[idx].temperature, readings[idx].humidity}; },
+            [&rawFun, &readings](std::size_t idx) { rawFun(readings[idx]); });
+        return;
+    }
+
+    const auto &buckets = snapshot.buckets;
+    forEachSelected(
+        buckets.size(), query.maxPoints, [&buckets](std::size_t idx)
+        { return buckets[idx].startEpoch; },
+        [&buckets](std::size_t idx)
+        {
+            return std::array<double, 2>{static_cast<double>(buckets[idx].avgTemperature),
+                                         static_cast<double>(buckets[idx].avgHumidity)};
+        },
+        [&bucketFun, &buckets](std::size_t idx) { bucketFun(buckets[idx]); });
+}
+
+// Finds where the selection of the query starts and how long it is, without copying it
+std::optional<ReadingsStorage::ResponseCacheKey> ReadingsStorage::responseCacheKey(
+    const ReadingsQuery &query) const
+{
+    const SensorHistory *history = m_sensors.find(query.identifier);
+    if (history == nullptr)
+    {
+        return std::nullopt;
+    }
+
+    ResponseCacheKey key{history->stamp,
+                         query.resolution,
+                         0,
+                         0,
+                         query.maxPoints.value_or(0),
+                         query.encoding};
+    if (key.resolution == ReadingsQuery::Resolution::AUTO)
+    {
+        key.resolution = selectResolution(*history, query);
+    }
+
+    const auto [from, to] = epochRange(query);
+    auto countBuckets = [&key, from = from, to = to](const auto &tier)
+    {
+        forEachBucketIn(tier, from, to,
+                        [&key](const RollupBucket &bucket)
+                        {
+                            key.firstEpoch = key.count++ == 0 ? bucket.startEpoch : key.firstEpoch;
+                        });
+    };
+
+    switch (key.resolution)
+    {
+    case ReadingsQuery::Resolution::AUTO:
+    case ReadingsQuery::Resolution::RAW:
+    {
+        auto readings = m_rawReadings.range(history->raw, from, to);
+        key.firstEpoch = readings.size() != 0 ? readings.at(0).epochTime : 0;
+        key.count = readings.size();
+        break;
+    }
+    case ReadingsQuery::Resolution::MINUTES_5:
+        countBuckets(history->minutes5);
+        break;
+    case ReadingsQuery::Resolution::HOURLY:
+        countBuckets(history->hourly);
+        break;
+    case ReadingsQuery::Resolution::DAILY:
+        countBuckets(history->daily);
+        break;
+    }
+    return key;
+}
+
+ReadingsQuery::Resolution ReadingsStorage::selectResolution(const SensorHistory &history,
+                                                            const ReadingsQuery &query) const
+{
+    // The finest tier which still reaches back to the beginning of the requested span wins
+    auto firstRawEpoch = m_rawReadings.firstEpoch(history.raw);
+    if (!query.from.has_value()
+        || (firstRawEpoch.has_value() && firstRawEpoch.value() <= query.from.value()))
+    {
+        return ReadingsQuery::Resolution::RAW;
+    }
+
+    auto covers = [&query](const std::optional<uint32_t> &oldestEpoch)
+    {
+        return oldestEpoch.has_value() && oldestEpoch.value() <= query.from.value();
+    };
+
+    if (covers(history.minutes5.oldestEpoch()))
+    {
+        return ReadingsQuery::Resolution::MINUTES_5;
+    }
+    if (covers(history.hourly.oldestEpoch()))
+    {
+        return ReadingsQuery::Resolution::HOURLY;
+    }
+    return ReadingsQuery::Resolution::DAILY;
+}
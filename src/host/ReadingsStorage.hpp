@@ -1,27 +1,198 @@
 #pragma once
 
-#include <map>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
 
-#include "RingBuffer.hpp"
+#include "ConfStorage.hpp"
+#include "DailyQuantiles.hpp"
+#include "HampelFilter.hpp"
+#include "HourOfDayHistogram.hpp"
+#include "ReadingsBlockPool.hpp"
+#include "ReadingsLog.hpp"
+#include "ReadingsQuery.hpp"
+#include "ReadingsRollup.hpp"
+#include "Seqlock.hpp"
+#include "SensorTable.hpp"
+#include "SlidingWindowStats.hpp"
 #include "common/types.hpp"
 
 class ReadingsStorage
 {
 public:
+    // Position in the selection of a query which is read in parts, see readJsonValues
+    struct Cursor
+    {
+        ReadingsQuery query;
+        // Readings may share an epoch, so the resume point counts those already read at it
+        uint32_t lastEpoch{0};
+        std::size_t readAtLastEpoch{0};
+        std::size_t read{0};
+    };
+
+    ReadingsStorage() = default;
+    explicit ReadingsStorage(const std::shared_ptr<ReadingsLog> &readingsLog);
+
     void addReading(IDType identifier, float temperature, float humidity, unsigned long epochTime);
-    std::string getReadingsAsJsonStr(IDType identifier);
-    std::string getLastReadingAsJsonStr(IDType identifier);
+    void restoreFromLog();
+    // Getters may be called from other tasks than the one adding readings, see m_seqlock
+    std::string getReadingsAsJsonStr(IDType identifier) const;
+    std::string getReadingsAsJsonStr(const ReadingsQuery &query) const;
+    // Raw readings of a sensor are serialized once per change and then shared between requests
+    // In the encoding of the query
+    std::shared_ptr<const std::string> getReadings(const ReadingsQuery &query) const;
+    // The same response in parts: the cursor keeps the resolution picked on opening, every read
+    // takes at most maxValues under the seqlock and appends them to out. Values added meanwhile
+    // are read too when they fall into the range. Downsampling needs the whole selection, so
+    // maxPoints is ignored.
+    Cursor openCursor(const ReadingsQuery &query) const;
+    // Strong validator of the getReadings response, it changes whenever the response would. None
+    // for unknown sensors.
+    std::optional<std::string> getReadingsETag(const ReadingsQuery &query) const;
+    std::size_t readJsonValues(Cursor &cursor, std::size_t maxValues, std::string &out) const;
+    std::string getLastReadingAsJsonStr(IDType identifier) const;
+    std::string getStatsAsJsonStr(IDType identifier) const;
+    std::string getQuantilesAsJsonStr(IDType identifier) const;
+    std::string getHeatmapAsJsonStr(IDType identifier) const;
+    void setRawHistoryHorizon(uint32_t seconds);
+    // Readings further from the recent median than threshold robust standard deviations are
+    // stored as suspect and left out of rollups and stats, zero (the default) disables the check
+    void setOutlierThreshold(float threshold);
 
 private:
-    struct Reading
+    // Raw readings of all sensors share one pool. Blocks are split between sensors in proportion
+    // to their reporting rates, so all of them cover the same horizon: the configured one when
+    // the pool is big enough, a shorter one otherwise. The pool takes 32 KB of heap next to the
+    // sensor histories (see sensorsHeapBudget), about 3600 readings: over 500 for each of seven
+    // sensors, or over two days of one reporting every minute.
+    constexpr static uint16_t readingsPerBlock = 32;
+    constexpr static std::size_t rawReadingsHeapBudget = 32 * 1024;
+    constexpr static auto readingsBlocksNum = static_cast<uint16_t>(
+        rawReadingsHeapBudget / ReadingsBlockPool<1, readingsPerBlock>::blockBytes());
+    constexpr static uint32_t defaultRawHistoryHorizonSecs = 24 * 60 * 60;
+    using RawReadingsPool = ReadingsBlockPool<readingsBlocksNum, readingsPerBlock>;
+
+    // AHT10 spikes are single readings, seven of them give a stable median. Changes smaller than
+    // sensor accuracy are never outliers.
+    constexpr static uint8_t outlierWindow = 7;
+    constexpr static float minTemperatureDeviation = 0.5F;
+    constexpr static float minHumidityDeviation = 2.0F;
+
+    // Hour of day heatmaps, 2 degree bins from -10 to 40 and 10 percent bins of humidity (AHT10
+    // humidity is only accurate to 2 percent), 1.7 KB together
+    using TemperatureHeatmap = HourOfDayHistogram<-10, 2, 25>;
+    using HumidityHeatmap = HourOfDayHistogram<0, 10, 10>;
+
+    // Rollups extend raw readings to 8 hours, a week and three months, daily percentiles cover
+    // the last month
+    struct SensorHistory
     {
-        float temperature;
-        float humidity;
-        unsigned long epochTime;
+        RawReadingsPool::Chain raw;
+        // Unique across sensors and growing on every reading, so it also tells a re-added sensor
+        // from the evicted one
+        uint32_t stamp{0};
+        // Moving average of seconds between readings, zero until the second reading
+        float meanIntervalSecs{0};
+        RollupTier<5 * 60, 96> minutes5;
+        RollupTier<60 * 60, 168> hourly;
+        RollupTier<24 * 60 * 60, 92> daily;
+        // Ten minute slots for the hour and two hour ones for the day, about 1 KB together
+        SlidingWindowStats<60 * 60, 6> lastHour;
+        SlidingWindowStats<24 * 60 * 60, 12> lastDay;
+        DailyQuantiles<31> quantiles;
+        TemperatureHeatmap temperatureHeatmap;
+        HumidityHeatmap humidityHeatmap;
+        HampelFilter<outlierWindow> temperatureFilter;
+        HampelFilter<outlierWindow> humidityFilter;
     };
 
-    constexpr static uint16_t maxReadingsPerSensor = 220;
-    using ReadingsRingBuffer = RingBuffer<Reading, maxReadingsPerSensor>;
+    // A node32s has no PSRAM and about 200 KB of heap left once WiFi and the web server run.
+    // Histories of all sensors may take 80 KB of it, all allocated at startup, every one on its own
+    // (see SensorTable). Anything added to SensorHistory has to fit here or lower maxSensorsNum.
+    constexpr static std::size_t sensorsHeapBudget = 80 * 1024;
+    static_assert(sizeof(SensorHistory) * ConfStorage::maxSensorsNum <= sensorsHeapBudget,
+                  "Sensor histories don't fit into their heap budget");
+    static_assert(sizeof(SensorHistory) * (ConfStorage::maxSensorsNum + 1) > sensorsHeapBudget,
+                  "Sensor histories leave room for more sensors, raise maxSensorsNum");
+
+    // Copy of the readings answering a query, taken under m_seqlock and serialized after it
+    struct Snapshot
+    {
+        ReadingsQuery::Resolution resolution{ReadingsQuery::Resolution::RAW};
+        std::vector<RawReadingsPool::Reading> raw;
+        std::vector<RollupBucket> buckets;
+    };
+
+    // Readings or buckets answering a query are the same as long as the sensor hasn't changed and
+    // the selection starts at the same one and has the same length, the encoding has to match too
+    struct ResponseCacheKey
+    {
+        uint32_t stamp;
+        ReadingsQuery::Resolution resolution;
+        uint32_t firstEpoch;
+        std::size_t count;
+        std::size_t maxPoints;
+        ReadingsQuery::Encoding encoding;
+
+        bool operator==(const ResponseCacheKey &other) const
+        {
+            return stamp == other.stamp && resolution == other.resolution
+                   && firstEpoch == other.firstEpoch && count == other.count
+                   && maxPoints == other.maxPoints && encoding == other.encoding;
+        }
+    };
+
+    struct CachedResponse
+    {
+        ResponseCacheKey key{};
+        std::shared_ptr<const std::string> response;
+    };
+
+    // Readings are added on the main loop while web handlers read on the AsyncTCP task. One
+    // sequence covers the whole storage, as a reading may change other sensors too: the pool
+    // reclaims their blocks, quotas are rebalanced and the table evicts. Readers only copy under
+    // it, so adding a reading never waits for a request being served.
+    Seqlock m_seqlock;
+    RawReadingsPool m_rawReadings;
+    SensorTable<SensorHistory, ConfStorage::maxSensorsNum> m_sensors;
+    std::shared_ptr<ReadingsLog> m_readingsLog;
+    uint32_t m_rawHistoryHorizonSecs{defaultRawHistoryHorizonSecs};
+    float m_outlierThreshold{0};
+    uint32_t m_lastStamp{0};
+
+    // The last response of each sensor, only readers touch it and adding a reading just moves the
+    // sensor stamp
+    mutable std::mutex m_responseCacheMutex;
+    mutable SensorTable<CachedResponse, ConfStorage::maxSensorsNum> m_responseCache;
 
-    std::map<IDType, ReadingsRingBuffer> m_readingBuffers;
+    void storeReading(IDType identifier,
+                      float temperature,
+                      float humidity,
+                      unsigned long epochTime);
+    SensorHistory *findOrAddSensor(IDType identifier);
+    bool updateMeanInterval(SensorHistory &history, unsigned long epochTime);
+    bool checkOutlier(SensorHistory &history, float temperature, float humidity) const;
+    void rebalanceRawQuotas();
+    // Values before resumeEpoch and the first resumeSkip ones at it are left out
+    Snapshot takeSnapshot(const ReadingsQuery &query,
+                          uint32_t resumeEpoch = 0,
+                          std::size_t resumeSkip = 0,
+                          std::size_t limit = std::numeric_limits<std::size_t>::max()) const;
+    std::optional<ResponseCacheKey> responseCacheKey(const ReadingsQuery &query) const;
+    std::shared_ptr<const std::string> findCachedResponse(IDType identifier,
+                                                          const ResponseCacheKey &key) const;
+    void cacheResponse(IDType identifier,
+                       const ResponseCacheKey &key,
+                       const std::shared_ptr<const std::string> &response) const;
+    static std::string encode(const Snapshot &snapshot, const ReadingsQuery &query);
+    template <typename RawFun, typename BucketFun>
+    static void forEachValue(const Snapshot &snapshot,
+                             const ReadingsQuery &query,
+                             RawFun rawFun,
+                             BucketFun bucketFun);
+    ReadingsQuery::Resolution selectResolution(const SensorHistory &history,
+                                               const ReadingsQuery &query) const;
 };
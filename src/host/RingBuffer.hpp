@@ -1,110 +1,316 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cinttypes>
+#include <cstddef>
 #include <iterator>
 #include <limits>
 #include <type_traits>
 #include <utility>
 
-template <typename T, uint16_t size>
+// Fixed-size circular buffer, the oldest element is overwritten when full. Index 0 is the oldest
+// element. Power-of-two sizes wrap indices with a mask, other sizes with a single comparison.
+template <typename T, uint16_t length>
 class RingBuffer
 {
     constexpr static uint16_t maxSize = std::numeric_limits<uint16_t>::max() - 1;
-    constexpr static uint16_t bufferLenght = size + 1;
+    constexpr static bool isPowerOfTwo = (length & (length - 1)) == 0;
 
-    static_assert(size > 0);
-    static_assert(size <= maxSize);
+    static_assert(length > 0);
+    static_assert(length <= maxSize);
 
-    using BufferType = std::array<T, bufferLenght>;
+    using BufferType = std::array<T, length>;
 
+    template <bool isConst>
     class Iterator
     {
+        using Owner = std::conditional_t<isConst, const RingBuffer, RingBuffer>;
+
     public:
-        using iterator_category = std::forward_iterator_tag;
-        using difference_type = uint16_t;
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
         using value_type = T;
-        using pointer = T *;
-        using reference = T &;
+        using pointer = std::conditional_t<isConst, const T *, T *>;
+        using reference = std::conditional_t<isConst, const T &, T &>;
+
+        Iterator() = default;
 
-        Iterator(BufferType *buffer, difference_type currentIdx)
-            : m_buffer(buffer)
-            , m_idx(currentIdx)
+        Iterator(Owner *owner, difference_type idx)
+            : m_owner(owner)
+            , m_idx(idx)
         {
         }
 
+        // Mutable iterators convert to const ones
+        template <bool otherConst = isConst, typename = std::enable_if_t<!otherConst>>
+        operator Iterator<true>() const  // NOLINT
+        {
+            return Iterator<true>(m_owner, m_idx);
+        }
+
         reference operator*() const
         {
-            return (*m_buffer)[m_idx];
+            return (*m_owner)[m_idx];
+        }
+
+        pointer operator->() const
+        {
+            return &(*m_owner)[m_idx];
         }
 
-        pointer operator->()
+        reference operator[](difference_type offset) const
         {
-            return &(*m_buffer)[m_idx];
+            return (*m_owner)[m_idx + offset];
         }
 
         Iterator &operator++()
         {
-            m_idx = (m_idx + 1) % bufferLenght;
+            ++m_idx;
             return *this;
         }
 
         Iterator operator++(int)
         {
             Iterator tmp = *this;
-            ++(*this);
+            ++m_idx;
+            return tmp;
+        }
+
+        Iterator &operator--()
+        {
+            --m_idx;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            --m_idx;
             return tmp;
         }
 
+        Iterator &operator+=(difference_type offset)
+        {
+            m_idx += offset;
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type offset)
+        {
+            m_idx -= offset;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type offset)
+        {
+            return it += offset;
+        }
+
+        friend Iterator operator+(difference_type offset, Iterator it)
+        {
+            return it += offset;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type offset)
+        {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.m_idx - rhs.m_idx;
+        }
+
         friend bool operator==(const Iterator &lhs, const Iterator &rhs)
         {
             return lhs.m_idx == rhs.m_idx;
-        };
+        }
 
         friend bool operator!=(const Iterator &lhs, const Iterator &rhs)
         {
             return lhs.m_idx != rhs.m_idx;
-        };
+        }
+
+        friend bool operator<(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.m_idx < rhs.m_idx;
+        }
+
+        friend bool operator>(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.m_idx > rhs.m_idx;
+        }
+
+        friend bool operator<=(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.m_idx <= rhs.m_idx;
+        }
+
+        friend bool operator>=(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.m_idx >= rhs.m_idx;
+        }
 
     private:
-        difference_type m_idx;
-        BufferType *m_buffer;
+        Owner *m_owner{nullptr};
+        difference_type m_idx{0};
     };
 
 public:
-    void put(T reading)
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // Contiguous part of the buffer, oldest elements first
+    struct Span
     {
-        m_head = modInc(m_head);
-        m_buffer[m_head] = reading;
+        const T *data;
+        std::size_t size;
 
-        if (m_head == m_tailId)
+        [[nodiscard]] const T *begin() const
         {
-            m_tailId = modInc(m_tailId);
+            return data;
         }
+
+        [[nodiscard]] const T *end() const
+        {
+            return data + size;
+        }
+    };
+
+    void put(T value)
+    {
+        if (m_size < length)
+        {
+            m_buffer[wrap(m_first + m_size)] = std::move(value);
+            ++m_size;
+        }
+        else
+        {
+            m_buffer[m_first] = std::move(value);
+            m_first = wrap(m_first + 1);
+        }
+    }
+
+    // Inserts values in order, same as calling put for each of them
+    void putN(const T *values, std::size_t count)
+    {
+        if (count >= length)
+        {
+            std::copy(values + count - length, values + count, m_buffer.begin());
+            m_first = 0;
+            m_size = length;
+            return;
+        }
+
+        auto position = wrap(m_first + m_size);
+        auto tillEnd = std::min<std::size_t>(count, length - position);
+        std::copy(values, values + tillEnd, m_buffer.begin() + position);
+        std::copy(values + tillEnd, values + count, m_buffer.begin());
+
+        auto total = m_size + count;
+        if (total > length)
+        {
+            m_first = wrap(m_first + (total - length));
+        }
+        m_size = static_cast<uint16_t>(std::min<std::size_t>(total, length));
     }
 
+    // An empty buffer returns a default element instead of wrapping an index below zero
     const T &getLast() const
     {
-        return m_buffer[m_head];
+        return m_size == 0 ? m_buffer[m_first] : (*this)[m_size - 1];
+    }
+
+    T &operator[](std::size_t idx)
+    {
+        return m_buffer[wrap(m_first + idx)];
+    }
+
+    const T &operator[](std::size_t idx) const
+    {
+        return m_buffer[wrap(m_first + idx)];
     }
 
-    Iterator begin()
+    [[nodiscard]] uint16_t size() const
     {
-        return Iterator(&m_buffer, modInc(m_tailId));
+        return m_size;
     }
 
-    Iterator end()
+    [[nodiscard]] bool empty() const
     {
-        return Iterator(&m_buffer, modInc(m_head));
+        return m_size == 0;
+    }
+
+    [[nodiscard]] bool full() const
+    {
+        return m_size == length;
+    }
+
+    constexpr static uint16_t capacity()
+    {
+        return length;
+    }
+
+    // At most two contiguous segments holding all elements in order, for bulk copying
+    [[nodiscard]] std::array<Span, 2> spans() const
+    {
+        auto firstSegment = std::min<std::size_t>(m_size, length - m_first);
+        return {Span{m_buffer.data() + m_first, firstSegment},
+                Span{m_buffer.data(), m_size - firstSegment}};
+    }
+
+    void clear()
+    {
+        m_first = 0;
+        m_size = 0;
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(this, m_size);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, m_size);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
     }
 
 private:
-    BufferType m_buffer;
-    uint16_t m_head{0};
-    uint16_t m_tailId{0};
+    BufferType m_buffer{};
+    uint16_t m_first{0};
+    uint16_t m_size{0};
 
-    uint16_t modInc(uint16_t value)
+    // Arguments never exceed twice the size, so one subtraction is enough
+    static uint16_t wrap(std::size_t idx)
     {
-        return (value + 1) % bufferLenght;
+        if constexpr (isPowerOfTwo)
+        {
+            return static_cast<uint16_t>(idx & (length - 1));
+        }
+        else
+        {
+            return static_cast<uint16_t>(idx < length ? idx : idx - length);
+        }
     }
 };
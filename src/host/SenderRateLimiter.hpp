@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <limits>
+
+#include "common/MacAddr.hpp"
+
+// Token bucket: tokens refill one per refillIntervalMs up to burst, each admitted frame takes one.
+// A new bucket starts full.
+class TokenBucket
+{
+public:
+    bool tryTake(uint32_t nowMs, uint32_t refillIntervalMs, float burst)
+    {
+        refill(nowMs, refillIntervalMs, burst);
+        if (m_tokens < 1)
+        {
+            return false;
+        }
+        m_tokens -= 1;
+        return true;
+    }
+
+    [[nodiscard]] bool isFull(uint32_t nowMs, uint32_t refillIntervalMs, float burst) const
+    {
+        auto bucket = *this;
+        bucket.refill(nowMs, refillIntervalMs, burst);
+        return bucket.m_tokens >= burst;
+    }
+
+private:
+    // Clamped to the burst on first use
+    float m_tokens{std::numeric_limits<float>::max()};
+    uint32_t m_lastMs{0};
+
+    void refill(uint32_t nowMs, uint32_t refillIntervalMs, float burst)
+    {
+        // Unsigned difference survives the millis wrap-around
+        const auto elapsed = static_cast<float>(nowMs - m_lastMs);
+        m_tokens = std::min(burst, m_tokens + elapsed / static_cast<float>(refillIntervalMs));
+        m_lastMs = nowMs;
+    }
+};
+
+// Admission control of frames by sender, checked before anything of the frame is parsed. Senders
+// get a token bucket each, with a count of their rejected frames. A sender whose bucket is full
+// can be forgotten without loss (its throttling was reported long ago), so its slot is reused for
+// a new one. When every slot is busy,
+// the rest share one extra bucket, spoofing new addresses doesn't buy more frames.
+template <std::size_t capacity>
+class SenderRateLimiter
+{
+public:
+    struct Sender
+    {
+        MacAddr mac;
+        TokenBucket bucket;
+        uint32_t throttled;
+        uint32_t reported;
+        bool used;
+    };
+
+    // Zero interval disables the limit
+    void setRate(uint32_t refillIntervalMs, float burst)
+    {
+        m_refillIntervalMs = refillIntervalMs;
+        m_burst = burst;
+    }
+
+    bool admit(const MacAddr &mac, uint32_t nowMs)
+    {
+        if (m_refillIntervalMs == 0)
+        {
+            return true;
+        }
+
+        auto &sender = find(mac, nowMs);
+        if (sender.bucket.tryTake(nowMs, m_refillIntervalMs, m_burst))
+        {
+            return true;
+        }
+        ++sender.throttled;
+        ++m_throttledTotal;
+        return false;
+    }
+
+    [[nodiscard]] uint32_t throttled(const MacAddr &mac) const
+    {
+        for (const auto &sender : m_senders)
+        {
+            if (sender.used && sender.mac == mac)
+            {
+                return sender.throttled;
+            }
+        }
+        return 0;
+    }
+
+    [[nodiscard]] uint32_t throttledTotal() const
+    {
+        return m_throttledTotal;
+    }
+
+    // Calls fun with senders throttled since the last report, the shared bucket of the rest
+    // comes last
+    template <typename Fun>
+    void reportThrottled(Fun fun)
+    {
+        auto report = [&fun](Sender &sender)
+        {
+            if (sender.throttled != sender.reported)
+            {
+                fun(static_cast<const Sender &>(sender));
+                sender.reported = sender.throttled;
+            }
+        };
+        std::for_each(m_senders.begin(), m_senders.end(), report);
+        report(m_others);
+    }
+
+private:
+    std::array<Sender, capacity> m_senders{};
+    Sender m_others{{}, {}, 0, 0, true};
+    uint32_t m_throttledTotal{0};
+    uint32_t m_refillIntervalMs{0};
+    float m_burst{1};
+
+    Sender &find(const MacAddr &mac, uint32_t nowMs)
+    {
+        Sender *reusable = nullptr;
+        for (auto &sender : m_senders)
+        {
+            if (sender.used && sender.mac == mac)
+            {
+                return sender;
+            }
+            if (reusable == nullptr
+                && (!sender.used || sender.bucket.isFull(nowMs, m_refillIntervalMs, m_burst)))
+            {
+                reusable = &sender;
+            }
+        }
+
+        if (reusable == nullptr)
+        {
+            return m_others;
+        }
+
+        *reusable = {mac, {}, 0, 0, true};
+        return *reusable;
+    }
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "common/types.hpp"
+
+// Fixed-capacity map from sensor identifier to Value. All values are allocated on construction,
+// every one on its own so a table of big values needs no single huge block, and are reused after
+// erase. The index is open-addressed with linear probing, so lookups and inserts never allocate.
+template <typename Value, std::size_t capacity>
+class SensorTable
+{
+    static_assert(capacity > 0);
+    static_assert(capacity < 0xFF);
+
+    constexpr static std::size_t slotsBits = []
+    {
+        std::size_t bits = 1;
+        // Keep the load factor at or below one half
+        while ((std::size_t{1} << bits) < capacity * 2)
+        {
+            ++bits;
+        }
+        return bits;
+    }();
+    constexpr static std::size_t slotsNum = std::size_t{1} << slotsBits;
+    constexpr static uint8_t emptySlot = 0xFF;
+
+public:
+    SensorTable()
+    {
+        m_slots.fill(Slot{0, emptySlot});
+        for (std::size_t idx = 0; idx < capacity; ++idx)
+        {
+            m_freeValues[idx] = static_cast<uint8_t>(capacity - 1 - idx);
+            m_values[idx] = std::make_unique<Value>();
+        }
+    }
+
+    [[nodiscard]] Value *find(IDType identifier)
+    {
+        auto valueIdx = findValue(identifier);
+        return valueIdx < capacity ? m_values[valueIdx].get() : nullptr;
+    }
+
+    [[nodiscard]] const Value *find(IDType identifier) const
+    {
+        auto valueIdx = findValue(identifier);
+        return valueIdx < capacity ? m_values[valueIdx].get() : nullptr;
+    }
+
+    // Returns nullptr when the identifier is not present and the table is full
+    Value *insert(IDType identifier)
+    {
+        auto slot = home(identifier);
+        for (; m_slots[slot].valueIdx != emptySlot; slot = next(slot))
+        {
+            if (m_slots[slot].identifier == identifier)
+            {
+                return m_values[m_slots[slot].valueIdx].get();
+            }
+        }
+
+        if (m_size == capacity)
+        {
+            return nullptr;
+        }
+
+        auto valueIdx = m_freeValues[capacity - 1 - m_size];
+        m_slots[slot] = Slot{identifier, valueIdx};
+        ++m_size;
+        return m_values[valueIdx].get();
+    }
+
+    bool erase(IDType identifier)
+    {
+        auto slot = findSlot(identifier);
+        if (slot == slotsNum)
+        {
+            return false;
+        }
+
+        auto valueIdx = m_slots[slot].valueIdx;
+        reset(*m_values[valueIdx]);
+        --m_size;
+        m_freeValues[capacity - 1 - m_size] = valueIdx;
+
+        // Backward shift deletion, entries after the hole are moved back if their home allows
+        auto hole = slot;
+        for (auto idx = next(hole); m_slots[idx].valueIdx != emptySlot; idx = next(idx))
+        {
+            auto distanceFromHome = (idx - home(m_slots[idx].identifier)) & (slotsNum - 1);
+            auto distanceFromHole = (idx - hole) & (slotsNum - 1);
+            if (distanceFromHome >= distanceFromHole)
+            {
+                m_slots[hole] = m_slots[idx];
+                hole = idx;
+            }
+        }
+        m_slots[hole] = Slot{0, emptySlot};
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool full() const
+    {
+        return m_size == capacity;
+    }
+
+    template <typename Fun>
+    void forEach(Fun fun)
+    {
+        for (const auto &slot : m_slots)
+        {
+            if (slot.valueIdx != emptySlot)
+            {
+                fun(slot.identifier, *m_values[slot.valueIdx]);
+            }
+        }
+    }
+
+private:
+    struct Slot
+    {
+        IDType identifier;
+        uint8_t valueIdx;
+    };
+
+    std::array<Slot, slotsNum> m_slots{};
+    // Never freed until the table is, so a lookup racing with erase (see Seqlock.hpp) always points
+    // to a live value
+    std::array<std::unique_ptr<Value>, capacity> m_values;
+    std::array<uint8_t, capacity> m_freeValues{};
+    std::size_t m_size{0};
+
+    static std::size_t home(IDType identifier)
+    {
+        // Fibonacci hashing spreads identifiers which differ only in low bits
+        constexpr uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>((static_cast<uint64_t>(identifier) * multiplier)
+                                        >> (64 - slotsBits));
+    }
+
+    static std::size_t next(std::size_t slot)
+    {
+        return (slot + 1) & (slotsNum - 1);
+    }
+
+    // Values may be far too big for a temporary on the stack, so they are rebuilt where they are
+    static void reset(Value &value)
+    {
+        value.~Value();
+        new (&value) Value();
+    }
+
+    // Every slot is read once, so a lookup racing with erase (see Seqlock.hpp) may return a wrong
+    // value, but never one out of bounds
+    [[nodiscard]] std::size_t findValue(IDType identifier) const
+    {
+        for (auto slot = home(identifier);; slot = next(slot))
+        {
+            const Slot current = m_slots[slot];
+            if (current.valueIdx == emptySlot)
+            {
+                return capacity;
+            }
+            if (current.identifier == identifier)
+            {
+                return current.valueIdx < capacity ? current.valueIdx : capacity;
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t findSlot(IDType identifier) const
+    {
+        for (auto slot = home(identifier); m_slots[slot].valueIdx != emptySlot; slot = next(slot))
+        {
+            if (m_slots[slot].identifier == identifier)
+            {
+                return slot;
+            }
+        }
+        return slotsNum;
+    }
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <thread>
+
+// Sequence lock for data with one writer and readers on other tasks. The writer never waits: the
+// counter is odd for the time of an update. Readers run their section optimistically and start
+// over when the counter was odd or changed meanwhile, so a section must only copy data out, stay
+// within bounds on a torn view and never act on what it read before the read returns.
+class Seqlock
+{
+public:
+    template <typename Fun>
+    void write(Fun fun)
+    {
+        auto sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fun();
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    template <typename Fun>
+    auto read(Fun fun) const
+    {
+        for (uint32_t attempt = 0;; ++attempt)
+        {
+            auto before = m_sequence.load(std::memory_order_acquire);
+            if ((before & 1U) == 0)
+            {
+                auto result = fun();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == before)
+                {
+                    return result;
+                }
+            }
+            backOff(attempt);
+        }
+    }
+
+    // Number of finished writes
+    [[nodiscard]] uint32_t writes() const
+    {
+        return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    std::atomic<uint32_t> m_sequence{0};
+
+    // A reader of higher priority than the writer must sleep, yielding alone would never let a
+    // preempted writer on the same core finish its update
+    static void backOff(uint32_t attempt)
+    {
+        constexpr uint32_t spinsBeforeSleep = 8;
+        if (attempt < spinsBeforeSleep)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
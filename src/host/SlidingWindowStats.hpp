@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include "Quantization.hpp"
+
+struct WindowStats
+{
+    struct Metric
+    {
+        double min;
+        double max;
+        double mean;
+        double stddev;
+    };
+
+    uint32_t count;
+    Metric temperature;
+    Metric humidity;
+};
+
+// Min, max, mean and standard deviation of the readings from the last windowSeconds, updated on
+// every reading in O(1). The window is split into slots: running sums are kept over the slots and
+// monotonic queues of slot extremes give min and max, so the window moves by whole slots and
+// covers between (slotsNum - 1) / slotsNum of windowSeconds and the full window before the last
+// reading. Values are quantized to hundredths, so the sums are exact integers and never drift.
+template <uint32_t windowSeconds, uint16_t slotsNum>
+class SlidingWindowStats
+{
+    static_assert(slotsNum > 1);
+    static_assert(windowSeconds % slotsNum == 0);
+
+public:
+    constexpr static uint32_t slotSeconds = windowSeconds / slotsNum;
+
+    void add(float temperature, float humidity, unsigned long epochTime)
+    {
+        auto slotStart = static_cast<uint32_t>(epochTime - epochTime % slotSeconds);
+        if (m_current.count != 0 && slotStart < m_current.startEpoch)
+        {
+            // Clock went back, older slots would never expire in order
+            *this = SlidingWindowStats();
+        }
+
+        if (m_current.count != 0 && slotStart != m_current.startEpoch)
+        {
+            closeCurrent();
+        }
+        expire(slotStart);
+
+        const bool first = m_current.count == 0;
+        if (first)
+        {
+            m_current.startEpoch = slotStart;
+        }
+        ++m_current.count;
+        m_current.temperature.add(quantization::toCentiTemperature(temperature), first);
+        m_current.humidity.add(quantization::toCentiHumidity(humidity), first);
+    }
+
+    // Statistics of the window ending with the last reading
+    [[nodiscard]] std::optional<WindowStats> stats() const
+    {
+        auto count = m_closedCount + m_current.count;
+        if (count == 0)
+        {
+            return std::nullopt;
+        }
+
+        return WindowStats{count,
+                           metricStats(m_closedTemperature, m_temperatureExtremes,
+                                       &Slot::temperature, count),
+                           metricStats(m_closedHumidity, m_humidityExtremes, &Slot::humidity,
+                                       count)};
+    }
+
+private:
+    // 16 bytes per metric and slot: extremes fit hundredths of any sensible reading and the sum of
+    // a slot stays far from overflow at the rates EspNowServer lets through
+    struct MetricAccumulator
+    {
+        int16_t min{0};
+        int16_t max{0};
+        int32_t sum{0};
+        int64_t sumSquares{0};
+
+        void add(int32_t value, bool first)
+        {
+            constexpr int32_t lowest = std::numeric_limits<int16_t>::min();
+            constexpr int32_t highest = std::numeric_limits<int16_t>::max();
+            const auto clamped = static_cast<int16_t>(std::clamp(value, lowest, highest));
+            min = first ? clamped : std::min(min, clamped);
+            max = first ? clamped : std::max(max, clamped);
+            sum += value;
+            sumSquares += int64_t{value} * value;
+        }
+    };
+
+    struct Slot
+    {
+        uint32_t startEpoch{0};
+        uint32_t count{0};
+        MetricAccumulator temperature;
+        MetricAccumulator humidity;
+    };
+
+    // Ring of slot positions, capacity is enough as every closed slot is queued at most once
+    class PositionsQueue
+    {
+    public:
+        [[nodiscard]] bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] uint16_t front() const
+        {
+            return m_positions[m_head];
+        }
+
+        [[nodiscard]] uint16_t back() const
+        {
+            return m_positions[(m_head + m_size - 1) % slotsNum];
+        }
+
+        void pushBack(uint16_t position)
+        {
+            m_positions[(m_head + m_size) % slotsNum] = position;
+            ++m_size;
+        }
+
+        void popBack()
+        {
+            --m_size;
+        }
+
+        void popFront()
+        {
+            m_head = (m_head + 1) % slotsNum;
+            --m_size;
+        }
+
+    private:
+        std::array<uint16_t, slotsNum> m_positions{};
+        uint16_t m_head{0};
+        uint16_t m_size{0};
+    };
+
+    // Front of minima holds the position of the smallest slot minimum, the same for maxima
+    struct Extremes
+    {
+        PositionsQueue minima;
+        PositionsQueue maxima;
+    };
+
+    struct Totals
+    {
+        int64_t sum{0};
+        int64_t sumSquares{0};
+    };
+
+    std::array<Slot, slotsNum> m_slots{};
+    uint16_t m_oldestSlot{0};
+    uint16_t m_closedSlots{0};
+    uint32_t m_closedCount{0};
+    Totals m_closedTemperature;
+    Totals m_closedHumidity;
+    Extremes m_temperatureExtremes;
+    Extremes m_humidityExtremes;
+    Slot m_current;
+
+    void closeCurrent()
+    {
+        auto position = static_cast<uint16_t>((m_oldestSlot + m_closedSlots) % slotsNum);
+        m_slots[position] = m_current;
+        ++m_closedSlots;
+        m_closedCount += m_current.count;
+
+        pushSlot(m_closedTemperature, m_temperatureExtremes, &Slot::temperature, position);
+        pushSlot(m_closedHumidity, m_humidityExtremes, &Slot::humidity, position);
+        m_current = {};
+    }
+
+    // Drops slots which no longer fit into the window ending with the slot starting at slotStart
+    void expire(uint32_t slotStart)
+    {
+        while (m_closedSlots != 0
+               && m_slots[m_oldestSlot].startEpoch + windowSeconds <= slotStart)
+        {
+            const auto &slot = m_slots[m_oldestSlot];
+            m_closedCount -= slot.count;
+            popSlot(m_closedTemperature, m_temperatureExtremes, slot.temperature);
+            popSlot(m_closedHumidity, m_humidityExtremes, slot.humidity);
+
+            m_oldestSlot = (m_oldestSlot + 1) % slotsNum;
+            --m_closedSlots;
+        }
+    }
+
+    void pushSlot(Totals &totals,
+                  Extremes &extremes,
+                  MetricAccumulator Slot::*metric,
+                  uint16_t position)
+    {
+        const auto &accumulator = m_slots[position].*metric;
+        totals.sum += accumulator.sum;
+        totals.sumSquares += accumulator.sumSquares;
+
+        while (!extremes.minima.empty()
+               && (m_slots[extremes.minima.back()].*metric).min >= accumulator.min)
+        {
+            extremes.minima.popBack();
+        }
+        extremes.minima.pushBack(position);
+
+        while (!extremes.maxima.empty()
+               && (m_slots[extremes.maxima.back()].*metric).max <= accumulator.max)
+        {
+            extremes.maxima.popBack();
+        }
+        extremes.maxima.pushBack(position);
+    }
+
+    void popSlot(Totals &totals, Extremes &extremes, const MetricAccumulator &accumulator)
+    {
+        totals.sum -= accumulator.sum;
+        totals.sumSquares -= accumulator.sumSquares;
+
+        if (!extremes.minima.empty() && extremes.minima.front() == m_oldestSlot)
+        {
+            extremes.minima.popFront();
+        }
+        if (!extremes.maxima.empty() && extremes.maxima.front() == m_oldestSlot)
+        {
+            extremes.maxima.popFront();
+        }
+    }
+
+    [[nodiscard]] WindowStats::Metric metricStats(const Totals &closed,
+                                                  const Extremes &extremes,
+                                                  MetricAccumulator Slot::*metric,
+                                                  uint32_t count) const
+    {
+        const auto &current = m_current.*metric;
+        std::optional<int32_t> min;
+        std::optional<int32_t> max;
+        if (!extremes.minima.empty())
+        {
+            min = (m_slots[extremes.minima.front()].*metric).min;
+            max = (m_slots[extremes.maxima.front()].*metric).max;
+        }
+        if (m_current.count != 0)
+        {
+            min = std::min<int32_t>(min.value_or(current.min), current.min);
+            max = std::max<int32_t>(max.value_or(current.max), current.max);
+        }
+
+        const auto sum = static_cast<double>(closed.sum + current.sum);
+        const auto sumSquares = static_cast<double>(closed.sumSquares + current.sumSquares);
+        const auto mean = sum / count;
+        const auto variance = std::max(sumSquares / count - mean * mean, 0.0);
+
+        return {quantization::fromCenti(min.value()), quantization::fromCenti(max.value()),
+                mean / quantization::centiPerUnit,
+                std::sqrt(variance) / quantization::centiPerUnit};
+    }
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Lock-free, fixed-slot queue for exactly one producer and one consumer (e.g. a driver callback and
+// the main loop). Indices only grow and are wrapped with a mask, the producer owns the tail and
+// the consumer owns the head, so neither ever waits for the other.
+template <typename T, std::size_t capacity>
+class SpscQueue
+{
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+                  "Capacity has to be a power of two");
+
+public:
+    // Producer side. The slot is filled in place, so large elements are copied only once. Returns
+    // false (and doesn't call fill) when the queue is full.
+    template <typename Fill>
+    bool pushWith(Fill fill)
+    {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == capacity)
+        {
+            return false;
+        }
+
+        fill(m_slots[tail & mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T &value)
+    {
+        return pushWith([&value](T &slot) { slot = value; });
+    }
+
+    // Consumer side. Elements are passed to fun in place, at most maxElements of them. Returns the
+    // number of consumed elements.
+    template <typename Fun>
+    std::size_t consume(Fun fun, std::size_t maxElements = capacity)
+    {
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto available = m_tail.load(std::memory_order_acquire) - head;
+        auto count = available < maxElements ? available : maxElements;
+
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            fun(static_cast<const T &>(m_slots[(head + idx) & mask]));
+            // Each slot is released right away, so the producer can reuse it during the batch
+            m_head.store(head + idx + 1, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool pop(T &value)
+    {
+        return consume([&value](const T &element) { value = element; }, 1) == 1;
+    }
+
+    // Exact only when called from one of the sides while the other one is idle
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    constexpr static std::size_t mask = capacity - 1;
+    constexpr static std::size_t cacheLineSize = 64;
+
+    alignas(cacheLineSize) std::atomic<std::size_t> m_head{0};
+    alignas(cacheLineSize) std::atomic<std::size_t> m_tail{0};
+    alignas(cacheLineSize) std::array<T, capacity> m_slots{};
+};
@@ -1,13 +1,24 @@
 #include "WebPageMain.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "webserver/ResponseFillers.hpp"
+
 WebPageMain::WebPageMain(const std::shared_ptr<IArduino32Adp> &arduinoAdp,
                          const std::shared_ptr<IWebServer> &webServer,
                          std::unique_ptr<IResources> resources,
-                         const std::shared_ptr<IConfStorage> &confStorage)
+                         const std::shared_ptr<IConfStorage> &confStorage,
+                         uint32_t instanceId)
     : m_arduinoAdp(arduinoAdp)
     , m_server(webServer)
     , m_confStorage(confStorage)
     , m_resources(std::move(resources))
+    , m_instanceId(instanceId)
 {
 }
 
@@ -130,17 +141,65 @@ void WebPageMain::setupActions()
                         configuration(request);
                     });
 
+    // Registered first, the server would pass it to /sensorData as a subpath otherwise
+    m_server->onGet("/sensorData/all",
+                    [this](IWebRequest &request)
+                    {
+                        logger::logDbg("get /sensorData/all");
+                        allSensorsData(request);
+                    });
+
     m_server->onGet("/sensorData",
                     [this](IWebRequest &request)
                     {
                         logger::logDbg("get /sensorData");
                         sensorData(request);
                     });
+
+    m_server->onGet("/stats",
+                    [this](IWebRequest &request)
+                    {
+                        logger::logDbg("get /stats");
+                        sensorJson(request, m_getSensorStatsCb);
+                    });
+
+    m_server->onGet("/quantiles",
+                    [this](IWebRequest &request)
+                    {
+                        logger::logDbg("get /quantiles");
+                        sensorJson(request, m_getSensorQuantilesCb);
+                    });
+
+    m_server->onGet("/heatmap",
+                    [this](IWebRequest &request)
+                    {
+                        logger::logDbg("get /heatmap");
+                        sensorJson(request, m_getSensorHeatmapCb);
+                    });
+
+    m_server->onGet("/archive",
+                    [this](IWebRequest &request)
+                    {
+                        logger::logDbg("get /archive");
+                        archive(request);
+                    });
 }
 
-void WebPageMain::startServer(const GetSensorDataCb &getSensorDataCb)
+void WebPageMain::startServer(const GetSensorDataCb &getSensorDataCb,
+                              const GetSensorJsonCb &getSensorStatsCb,
+                              const GetSensorJsonCb &getSensorQuantilesCb,
+                              const GetSensorJsonCb &getSensorHeatmapCb,
+                              const GetSensorDataStreamCb &getSensorDataStreamCb,
+                              const GetSensorDataETagCb &getSensorDataETagCb,
+                              const GetSensorDataStreamCb &getArchiveStreamCb)
 {
     m_getSensorDataCb = getSensorDataCb;
+    m_getSensorStatsCb = getSensorStatsCb;
+    m_getSensorQuantilesCb = getSensorQuantilesCb;
+    m_getSensorHeatmapCb = getSensorHeatmapCb;
+    m_getSensorDataStreamCb = getSensorDataStreamCb;
+    m_getSensorDataETagCb = getSensorDataETagCb;
+    m_getArchiveStreamCb = getArchiveStreamCb;
 
     setupResources();
     setupActions();
@@ -208,7 +267,7 @@ void WebPageMain::setCredentials(IWebRequest &request, const std::string &body)
         }
 
         m_confStorage->setAdminCredentials(credentials["username"], credentials["password"]);
-        m_confStorage->save();
+        m_confStorage->requestSave();
 
         request.send(HTML_OK, "text/html", m_resources->getAdminHtml());
     }
@@ -242,13 +301,13 @@ void WebPageMain::updateSensorsMapping(IWebRequest &request, const std::string &
                 auto identifier = std::stoull(sensor.key());
 
                 m_confStorage->addSensor(identifier, name);
-                m_confStorage->save();
             }
             catch (std::invalid_argument err)
             {
                 logger::logErr("can't get sensor identifier, %s", err.what());
             }
         }
+        m_confStorage->requestSave();
 
         request.send(HTML_OK, "text/html", m_resources->getAdminHtml());
     }
@@ -267,10 +326,26 @@ void WebPageMain::setProperties(IWebRequest &request, const std::string &body)
             auto configuration = nlohmann::json::parse(body);
             std::uint16_t sensorUpdatePeriodMins = configuration["sensorUpdatePeriodMins"];
             std::size_t serverPort = configuration["serverPort"];
+            // Optional, clients older than the filter don't send it
+            std::optional<float> outlierThreshold;
+            if (configuration.contains("outlierThreshold"))
+            {
+                outlierThreshold = configuration["outlierThreshold"].get<float>();
+                if (*outlierThreshold < 0)
+                {
+                    logger::logErr("Can't set properties, negative outlier threshold");
+                    request.send(HTML_BAD_REQ);
+                    return;
+                }
+            }
 
             m_confStorage->setSensorUpdatePeriodMins(sensorUpdatePeriodMins);
             m_confStorage->setServerPort(serverPort);
-            m_confStorage->save();
+            if (outlierThreshold.has_value())
+            {
+                m_confStorage->setOutlierThreshold(*outlierThreshold);
+            }
+            m_confStorage->requestSave();
         }
         catch (nlohmann::json::parse_error err)
         {
@@ -302,7 +377,7 @@ void WebPageMain::removeSensor(IWebRequest &request, const std::string &body)
             auto sensor = nlohmann::json::parse(body);
             IDType sensorId = sensor["identifier"];
             m_confStorage->removeSensor(sensorId);
-            m_confStorage->save();
+            m_confStorage->requestSave();
         }
         catch (nlohmann::json::parse_error err)
         {
@@ -320,8 +395,50 @@ void WebPageMain::removeSensor(IWebRequest &request, const std::string &body)
     }
 }
 
+// Tags the response with the version and answers 304 when the client already has it
+bool WebPageMain::isNotModified(IWebRequest &request, const std::string &version)
+{
+    std::array<char, 2 * sizeof(m_instanceId) + 1> instance{};
+    std::snprintf(instance.data(), instance.size(), "%08lx",
+                  static_cast<unsigned long>(m_instanceId));
+    const auto etag = std::string("\"") + instance.data() + "-" + version + "\"";
+
+    bool matches = false;
+    if (auto ifNoneMatch = request.getHeader("If-None-Match"); ifNoneMatch.has_value())
+    {
+        // A list of tags, weak ones match too when the client only revalidates
+        std::string_view tags = ifNoneMatch.value();
+        while (!tags.empty() && !matches)
+        {
+            auto end = tags.find(',');
+            auto tag = tags.substr(0, end);
+            tags = end == std::string_view::npos ? std::string_view{} : tags.substr(end + 1);
+
+            tag.remove_prefix(std::min(tag.find_first_not_of(' '), tag.size()));
+            tag = tag.substr(0, tag.find_last_not_of(' ') + 1);
+            if (tag.substr(0, 2) == "W/")
+            {
+                tag.remove_prefix(2);
+            }
+            matches = tag == "*" || tag == etag;
+        }
+    }
+
+    request.addHeader("ETag", etag);
+    if (matches)
+    {
+        request.send(HTML_NOT_MODIFIED);
+    }
+    return matches;
+}
+
 void WebPageMain::sensorIDsToNames(IWebRequest &request)
 {
+    if (isNotModified(request, "s" + std::to_string(m_confStorage->getSensorsVersion())))
+    {
+        return;
+    }
+
     auto sensorsMappingJsonStr = m_confStorage->getSensorsMapping();
     request.send(HTML_OK, "application/json", sensorsMappingJsonStr.c_str());
 }
@@ -331,30 +448,263 @@ void WebPageMain::configuration(IWebRequest &request)
     if (!auth(request))
     {
         request.send(HTML_UNAUTH);
+        return;
+    }
+    if (isNotModified(request, "c" + std::to_string(m_confStorage->getConfigVersion())))
+    {
+        return;
     }
 
     auto config = m_confStorage->getConfigWithoutCredentials();
     request.send(HTML_OK, "application/json", config.c_str());
 }
 
+bool WebPageMain::readingsQuery(IWebRequest &request,
+                                std::map<std::string, std::string> &params,
+                                ReadingsQuery &query)
+{
+    try
+    {
+        if (params.find("identifier") != params.end())
+        {
+            query.identifier = std::stoull(params["identifier"]);
+        }
+        if (params.find("resolution") != params.end())
+        {
+            auto resolution = ReadingsQuery::resolutionFromStr(params["resolution"]);
+            if (!resolution.has_value())
+            {
+                throw std::invalid_argument("unknown resolution " + params["resolution"]);
+            }
+            query.resolution = resolution.value();
+        }
+        if (params.find("from") != params.end())
+        {
+            query.from = std::stoul(params["from"]);
+        }
+        if (params.find("to") != params.end())
+        {
+            query.to = std::stoul(params["to"]);
+        }
+        if (params.find("maxPoints") != params.end())
+        {
+            query.maxPoints = std::stoul(params["maxPoints"]);
+            if (query.maxPoints.value() == 0)
+            {
+                throw std::out_of_range("maxPoints has to be positive");
+            }
+        }
+    }
+    catch (std::invalid_argument err)
+    {
+        logger::logErr("can't get sensor data parameters, %s", err.what());
+        request.send(HTML_BAD_REQ);
+        return false;
+    }
+    catch (std::out_of_range err)
+    {
+        logger::logErr("sensor data parameter out of range, %s", err.what());
+        request.send(HTML_BAD_REQ);
+        return false;
+    }
+
+    if (auto accept = request.getHeader("Accept"); accept.has_value())
+    {
+        query.encoding = ReadingsQuery::encodingFromAccept(accept.value());
+    }
+    return true;
+}
+
+bool WebPageMain::isStreamed(const ReadingsQuery &query) const
+{
+    return !query.maxPoints.has_value() && query.encoding == ReadingsQuery::Encoding::JSON
+           && m_getSensorDataStreamCb;
+}
+
+IWebRequest::Filler WebPageMain::sensorDataFiller(const ReadingsQuery &query)
+{
+    if (isStreamed(query))
+    {
+        return m_getSensorDataStreamCb(query);
+    }
+    return response_fillers::fromString(m_getSensorDataCb(query));
+}
+
 void WebPageMain::sensorData(IWebRequest &request)
 {
     auto params = request.getParams();
-    if (params.find("identifier") != params.end())
+    if (params.find("identifier") == params.end())
     {
-        try
+        request.send(HTML_BAD_REQ);
+        return;
+    }
+
+    ReadingsQuery query{};
+    if (!readingsQuery(request, params, query))
+    {
+        return;
+    }
+    // The encoding follows Accept, caches must not answer one with a copy of another
+    request.addHeader("Vary", "Accept");
+
+    if (m_getSensorDataETagCb)
+    {
+        auto version = m_getSensorDataETagCb(query);
+        if (version.has_value() && isNotModified(request, version.value()))
         {
-            auto identifier = std::stoull(params["identifier"]);
-            request.send(HTML_OK, "application/json", m_getSensorDataCb(identifier).c_str());
+            return;
         }
-        catch (std::invalid_argument err)
+    }
+
+    const auto *contentType = ReadingsQuery::contentType(query.encoding);
+    if (isStreamed(query))
+    {
+        request.sendChunked(HTML_OK, contentType, m_getSensorDataStreamCb(query));
+    }
+    else
+    {
+        request.send(HTML_OK, contentType, m_getSensorDataCb(query));
+    }
+}
+
+// JSON is {"names": mapping, "sensors": [responses of /sensorData]}. The packed encoding has no
+// room for names, so there the mapping (as JSON) and the packed responses follow each other,
+// each after its u32 little-endian length. Other encodings are answered with JSON.
+void WebPageMain::allSensorsData(IWebRequest &request)
+{
+    auto params = request.getParams();
+    ReadingsQuery query{};
+    if (!readingsQuery(request, params, query))
+    {
+        return;
+    }
+    if (query.encoding != ReadingsQuery::Encoding::PACKED)
+    {
+        query.encoding = ReadingsQuery::Encoding::JSON;
+    }
+    request.addHeader("Vary", "Accept");
+
+    auto names = std::make_shared<const std::string>(m_confStorage->getSensorsMapping());
+    auto mapping = nlohmann::json::parse(*names, nullptr, false);
+    std::vector<IDType> identifiers;
+    if (mapping.is_object())
+    {
+        for (const auto &sensor : mapping.items())
         {
-            logger::logErr("can't get sensor identifier, %s", err.what());
-            request.send(HTML_BAD_REQ);
+            try
+            {
+                identifiers.push_back(std::stoull(sensor.key()));
+            }
+            catch (std::invalid_argument err)
+            {
+                logger::logWrn("skipping sensor with bad identifier, %s", err.what());
+            }
+            catch (std::out_of_range err)
+            {
+                logger::logWrn("skipping sensor with bad identifier, %s", err.what());
+            }
         }
     }
-    else
+
+    auto text = [](std::string content)
+    {
+        return [content = std::make_shared<const std::string>(std::move(content))]
+        { return response_fillers::fromString(content); };
+    };
+    auto lengthOf = [](const std::string &content)
+    {
+        std::string length;
+        for (std::size_t byte = 0; byte < sizeof(uint32_t); ++byte)
+        {
+            length.push_back(static_cast<char>((content.size() >> (8 * byte)) & 0xFF));
+        }
+        return length;
+    };
+
+    // Readings of a sensor are taken only when the previous sensor was sent
+    const bool packed = query.encoding == ReadingsQuery::Encoding::PACKED;
+    std::vector<std::function<IWebRequest::Filler()>> parts;
+    parts.emplace_back(packed ? text(lengthOf(*names)) : text(R"({"names":)"));
+    parts.emplace_back([names] { return response_fillers::fromString(names); });
+    if (!packed)
+    {
+        parts.emplace_back(text(R"(,"sensors":[)"));
+    }
+    for (std::size_t idx = 0; idx < identifiers.size(); ++idx)
+    {
+        if (!packed && idx > 0)
+        {
+            parts.emplace_back(text(","));
+        }
+        auto sensorQuery = query;
+        sensorQuery.identifier = identifiers[idx];
+        parts.emplace_back(
+            [this, sensorQuery, packed, lengthOf]
+            {
+                if (!packed)
+                {
+                    return sensorDataFiller(sensorQuery);
+                }
+                auto data = m_getSensorDataCb(sensorQuery);
+                auto length = std::make_shared<const std::string>(lengthOf(*data));
+                return response_fillers::sequence(
+                    {[length] { return response_fillers::fromString(length); },
+                     [data] { return response_fillers::fromString(data); }});
+            });
+    }
+    if (!packed)
+    {
+        parts.emplace_back(text("]}"));
+    }
+
+    request.sendChunked(HTML_OK, ReadingsQuery::contentType(query.encoding),
+                        response_fillers::sequence(parts));
+}
+
+// Archived readings are always raw and in JSON, only the sensor and the time range are chosen
+void WebPageMain::archive(IWebRequest &request)
+{
+    auto params = request.getParams();
+    if (params.find("identifier") == params.end() || !m_getArchiveStreamCb)
+    {
+        request.send(HTML_BAD_REQ);
+        return;
+    }
+
+    ReadingsQuery query{};
+    if (!readingsQuery(request, params, query))
+    {
+        return;
+    }
+    query.resolution = ReadingsQuery::Resolution::RAW;
+    query.encoding = ReadingsQuery::Encoding::JSON;
+
+    request.sendChunked(HTML_OK, ReadingsQuery::contentType(query.encoding),
+                        m_getArchiveStreamCb(query));
+}
+
+void WebPageMain::sensorJson(IWebRequest &request, const GetSensorJsonCb &getSensorJsonCb)
+{
+    auto params = request.getParams();
+    if (params.find("identifier") == params.end() || !getSensorJsonCb)
+    {
+        request.send(HTML_BAD_REQ);
+        return;
+    }
+
+    try
+    {
+        IDType identifier = std::stoull(params["identifier"]);
+        request.send(HTML_OK, "application/json", getSensorJsonCb(identifier).c_str());
+    }
+    catch (std::invalid_argument err)
+    {
+        logger::logErr("can't get sensor identifier, %s", err.what());
+        request.send(HTML_BAD_REQ);
+    }
+    catch (std::out_of_range err)
     {
+        logger::logErr("sensor identifier out of range, %s", err.what());
         request.send(HTML_BAD_REQ);
     }
 }
@@ -6,15 +6,23 @@
 
 #include "IConfStorage.hpp"
 #include "IResources.hpp"
+#include "ReadingsQuery.hpp"
 #include "adapters/IArduino32Adp.hpp"
 #include "common/logger.hpp"
 #include "webserver/IWebServer.hpp"
 
 class WebPageMain
 {
-    using GetSensorDataCb = std::function<std::string(const std::size_t &)>;
+    // Shared, so a cached response is handed over without a copy
+    using GetSensorDataCb
+        = std::function<std::shared_ptr<const std::string>(const ReadingsQuery &)>;
+    using GetSensorJsonCb = std::function<std::string(IDType)>;
+    // Streamed, the response of a selection which isn't downsampled grows with the history
+    using GetSensorDataStreamCb = std::function<IWebRequest::Filler(const ReadingsQuery &)>;
+    using GetSensorDataETagCb = std::function<std::optional<std::string>(const ReadingsQuery &)>;
 
     constexpr static auto HTML_OK = 200;
+    constexpr static auto HTML_NOT_MODIFIED = 304;
     constexpr static auto HTML_BAD_REQ = 400;
     constexpr static auto HTML_UNAUTH = 401;
     constexpr static auto HTML_NOT_FOUND = 404;
@@ -25,13 +33,20 @@ public:
     WebPageMain(const std::shared_ptr<IArduino32Adp> &arduinoAdp,
                 const std::shared_ptr<IWebServer> &webServer,
                 std::unique_ptr<IResources> resources,
-                const std::shared_ptr<IConfStorage> &confStorage);
+                const std::shared_ptr<IConfStorage> &confStorage,
+                uint32_t instanceId = 0);
 
     void sendEvent(const char *message,
                    const char *event = nullptr,
                    uint32_t identifier = 0,
                    uint32_t reconnect = 0);
-    void startServer(const GetSensorDataCb &getSensorDataCb);
+    void startServer(const GetSensorDataCb &getSensorDataCb,
+                     const GetSensorJsonCb &getSensorStatsCb = {},
+                     const GetSensorJsonCb &getSensorQuantilesCb = {},
+                     const GetSensorJsonCb &getSensorHeatmapCb = {},
+                     const GetSensorDataStreamCb &getSensorDataStreamCb = {},
+                     const GetSensorDataETagCb &getSensorDataETagCb = {},
+                     const GetSensorDataStreamCb &getArchiveStreamCb = {});
     void stopServer();
 
 private:
@@ -41,16 +56,33 @@ private:
     std::shared_ptr<IConfStorage> m_confStorage;
 
     GetSensorDataCb m_getSensorDataCb;
+    GetSensorJsonCb m_getSensorStatsCb;
+    GetSensorJsonCb m_getSensorQuantilesCb;
+    GetSensorJsonCb m_getSensorHeatmapCb;
+    GetSensorDataStreamCb m_getSensorDataStreamCb;
+    GetSensorDataETagCb m_getSensorDataETagCb;
+    GetSensorDataStreamCb m_getArchiveStreamCb;
+    // Versions start over after a restart, entity tags of different runs must not match
+    uint32_t m_instanceId;
 
     void setupResources();
     void setupActions();
 
     bool auth(IWebRequest &request);
+    bool isNotModified(IWebRequest &request, const std::string &version);
     void setCredentials(IWebRequest &request, const std::string &body);
     void updateSensorsMapping(IWebRequest &request, const std::string &body);
     void setProperties(IWebRequest &request, const std::string &body);
     void removeSensor(IWebRequest &request, const std::string &body);
     void sensorIDsToNames(IWebRequest &request);
     void configuration(IWebRequest &request);
+    bool readingsQuery(IWebRequest &request,
+                       std::map<std::string, std::string> &params,
+                       ReadingsQuery &query);
+    bool isStreamed(const ReadingsQuery &query) const;
+    IWebRequest::Filler sensorDataFiller(const ReadingsQuery &query);
     void sensorData(IWebRequest &request);
+    void allSensorsData(IWebRequest &request);
+    void archive(IWebRequest &request);
+    void sensorJson(IWebRequest &request, const GetSensorJsonCb &getSensorJsonCb);
 };
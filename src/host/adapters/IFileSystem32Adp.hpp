@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include "IRaiiFile.hpp"
@@ -23,4 +24,10 @@ public:
 
     [[nodiscard]] virtual std::unique_ptr<IRaiiFile> open(const std::string &path, Mode mode) const
         = 0;
+    [[nodiscard]] virtual bool exists(const std::string &path) const = 0;
+    virtual bool truncate(const std::string &path, std::size_t size) const = 0;
+    virtual bool remove(const std::string &path) const = 0;
+    virtual bool rename(const std::string &from, const std::string &to) const = 0;
+    [[nodiscard]] virtual std::size_t freeBytes() const = 0;
+    [[nodiscard]] virtual std::size_t totalBytes() const = 0;
 };
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Read-only bytes mapped into the address space, empty when mapping failed
+class IMappedRegion
+{
+public:
+    virtual ~IMappedRegion() = default;
+    IMappedRegion() = default;
+    IMappedRegion(const IMappedRegion &) = delete;
+    IMappedRegion(IMappedRegion &&) noexcept = default;
+    IMappedRegion &operator=(const IMappedRegion &) = delete;
+    IMappedRegion &operator=(IMappedRegion &&) noexcept = default;
+
+    [[nodiscard]] virtual const uint8_t *data() const = 0;
+    [[nodiscard]] virtual std::size_t size() const = 0;
+};
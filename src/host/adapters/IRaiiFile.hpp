@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 class IRaiiFile
@@ -13,5 +15,9 @@ public:
     IRaiiFile &operator=(IRaiiFile &&) noexcept = default;
 
     [[nodiscard]] virtual std::string readString() = 0;
-    virtual void print(const std::string &) = 0;
+    virtual std::size_t print(const std::string &) = 0;
+    virtual std::size_t read(uint8_t *buffer, std::size_t size) = 0;
+    virtual std::size_t write(const uint8_t *buffer, std::size_t size) = 0;
+    [[nodiscard]] virtual std::size_t size() const = 0;
+    virtual bool seek(std::size_t position) = 0;
 };
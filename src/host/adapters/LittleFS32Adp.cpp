@@ -2,6 +2,9 @@
 
 #include <LittleFS.h>
 
+#include <algorithm>
+#include <array>
+
 #include "RaiiFile.hpp"
 
 LittleFSAdp::LittleFSAdp()
@@ -27,3 +30,76 @@ std::unique_ptr<IRaiiFile> LittleFSAdp::open(const std::string &path, Mode mode)
 
     return std::make_unique<RaiiFile>(LittleFS.open(path.c_str(), nativeMode));
 }
+
+bool LittleFSAdp::exists(const std::string &path) const
+{
+    return LittleFS.exists(path.c_str());
+}
+
+bool LittleFSAdp::truncate(const std::string &path, std::size_t size) const
+{
+    // fs::File has no truncate, so the kept prefix is copied to a temporary file which then
+    // replaces the original one. LittleFS renames over an existing file atomically, so a power
+    // cut leaves either the whole original or the truncated copy.
+    constexpr auto chunkSize = 256;
+    const auto tmpPath = path + ".tmp";
+
+    std::size_t copied = 0;
+    {
+        auto src = LittleFS.open(path.c_str(), FILE_READ);
+        if (!src)
+        {
+            return false;
+        }
+        auto dst = LittleFS.open(tmpPath.c_str(), FILE_WRITE);
+        if (!dst)
+        {
+            LittleFS.remove(tmpPath.c_str());
+            return false;
+        }
+
+        std::array<uint8_t, chunkSize> chunk{};
+        while (copied < size)
+        {
+            auto toRead = std::min<std::size_t>(chunk.size(), size - copied);
+            auto readBytes = src.read(chunk.data(), toRead);
+            if (readBytes == 0 || dst.write(chunk.data(), readBytes) != readBytes)
+            {
+                break;
+            }
+            copied += readBytes;
+        }
+    }
+
+    if (copied != size)
+    {
+        LittleFS.remove(tmpPath.c_str());
+        return false;
+    }
+    if (!LittleFS.rename(tmpPath.c_str(), path.c_str()))
+    {
+        LittleFS.remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool LittleFSAdp::remove(const std::string &path) const
+{
+    return LittleFS.remove(path.c_str());
+}
+
+bool LittleFSAdp::rename(const std::string &from, const std::string &to) const
+{
+    return LittleFS.rename(from.c_str(), to.c_str());
+}
+
+std::size_t LittleFSAdp::freeBytes() const
+{
+    return LittleFS.totalBytes() - LittleFS.usedBytes();
+}
+
+std::size_t LittleFSAdp::totalBytes() const
+{
+    return LittleFS.totalBytes();
+}
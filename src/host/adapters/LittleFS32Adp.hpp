@@ -9,4 +9,10 @@ public:
     LittleFSAdp();
     [[nodiscard]] std::unique_ptr<IRaiiFile> open(const std::string &path,
                                                   Mode mode) const override;
+    [[nodiscard]] bool exists(const std::string &path) const override;
+    bool truncate(const std::string &path, std::size_t size) const override;
+    bool remove(const std::string &path) const override;
+    bool rename(const std::string &from, const std::string &to) const override;
+    [[nodiscard]] std::size_t freeBytes() const override;
+    [[nodiscard]] std::size_t totalBytes() const override;
 };
@@ -0,0 +1,44 @@
+#include "PartitionMappedRegion.hpp"
+
+#include "common/logger.hpp"
+
+PartitionMappedRegion::PartitionMappedRegion(const std::string &label)
+{
+    const auto *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                     ESP_PARTITION_SUBTYPE_ANY, label.c_str());
+    if (partition == nullptr)
+    {
+        logger::logWrn("Partition %s not found", label);
+        return;
+    }
+
+    const void *mapped = nullptr;
+    if (auto err = esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &mapped,
+                                      &m_handle);
+        err != ESP_OK)
+    {
+        logger::logErr("Can't map partition %s, error %d", label, err);
+        return;
+    }
+
+    m_data = static_cast<const uint8_t *>(mapped);
+    m_size = partition->size;
+}
+
+PartitionMappedRegion::~PartitionMappedRegion()
+{
+    if (m_data != nullptr)
+    {
+        spi_flash_munmap(m_handle);
+    }
+}
+
+const uint8_t *PartitionMappedRegion::data() const
+{
+    return m_data;
+}
+
+std::size_t PartitionMappedRegion::size() const
+{
+    return m_size;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <esp_partition.h>
+
+#include <string>
+
+#include "IMappedRegion.hpp"
+
+// Data partition mapped through the flash cache, reads go straight to flash without copying
+class PartitionMappedRegion : public IMappedRegion
+{
+public:
+    explicit PartitionMappedRegion(const std::string &label);
+    PartitionMappedRegion(const PartitionMappedRegion &) = delete;
+    PartitionMappedRegion(PartitionMappedRegion &&) noexcept = delete;
+    PartitionMappedRegion &operator=(const PartitionMappedRegion &) = delete;
+    PartitionMappedRegion &operator=(PartitionMappedRegion &&) noexcept = delete;
+    ~PartitionMappedRegion() override;
+
+    [[nodiscard]] const uint8_t *data() const override;
+    [[nodiscard]] std::size_t size() const override;
+
+private:
+    const uint8_t *m_data{nullptr};
+    std::size_t m_size{0};
+    spi_flash_mmap_handle_t m_handle{};
+};
@@ -30,9 +30,29 @@ public:
         return m_file.readString().c_str();
     }
 
-    void print(const std::string &str) override
+    std::size_t print(const std::string &str) override
     {
-        m_file.print(str.c_str());
+        return m_file.print(str.c_str());
+    }
+
+    std::size_t read(uint8_t *buffer, std::size_t size) override
+    {
+        return m_file.read(buffer, size);
+    }
+
+    std::size_t write(const uint8_t *buffer, std::size_t size) override
+    {
+        return m_file.write(buffer, size);
+    }
+
+    [[nodiscard]] std::size_t size() const override
+    {
+        return m_file.size();
+    }
+
+    bool seek(std::size_t position) override
+    {
+        return m_file.seek(position);
     }
 
 private:
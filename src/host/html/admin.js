@@ -19,6 +19,7 @@ async function fetchConfiguration() {
         const serverPort = document.getElementById("serverPort");
         sensorUpdatePeriod.value = configuration.sensorUpdatePeriodMins;
         serverPort.value = configuration.serverPort;
+        document.getElementById("outlierThreshold").value = configuration.outlierThreshold;
     }
     else if (response.status == 401) {
         console.log("Unauthorized");
@@ -186,10 +187,12 @@ function sendOtherProperties() {
 
     const sensorUpdatePeriod = document.getElementById("sensorUpdatePeriod").value;
     const serverPort = document.getElementById("serverPort").value;
+    const outlierThreshold = document.getElementById("outlierThreshold").value;
 
     let properties = {
         "sensorUpdatePeriodMins": Number(sensorUpdatePeriod),
-        "serverPort": Number(serverPort)
+        "serverPort": Number(serverPort),
+        "outlierThreshold": Number(outlierThreshold)
     };
 
     send(JSON.stringify(properties));
@@ -1,47 +1,111 @@
-const MAX_ARR_ELEMS = 220; // Should be send as configuration by server
 const TIME_IDX = 0;
 const TEMPERATURE_IDX = 1;
 const HUMIDITY_IDX = 2;
+// Present (and true) only on readings the server flagged as outliers
+const SUSPECT_IDX = 3;
+const SEC_IN_DAY = 24 * 60 * 60;
 
 var gSensorsData = {};
 var gSensorIDsToNames = {};
 
-async function fetchSensorsMapping() {
-    const response = await fetch("sensorIDsToNames");
-    const sensors = await response.json();
-    return sensors;
-}
+// Resolutions in the order of ReadingsQuery::Resolution
+const PACKED_RESOLUTIONS = ["auto", "raw", "5min", "hour", "day"];
+
+// Decodes the application/octet-stream layout of PackedReadings.hpp into the JSON shape
+function decodePackedReadings(buffer) {
+    const view = new DataView(buffer);
+    const resolution = PACKED_RESOLUTIONS[view.getUint8(1)];
+    const identifier = Number(view.getBigUint64(4, true));
+    const count = view.getUint32(12, true);
+    let epoch = view.getUint32(16, true);
+    const epochsBytes = view.getUint32(20, true);
+
+    let offset = 24;
+    const epochs = [];
+    for (let idx = 0; idx < count; ++idx) {
+        let delta = 0;
+        for (let shift = 0; ; shift += 7) {
+            const byte = view.getUint8(offset++);
+            delta += (byte & 0x7F) * 2 ** shift;
+            if (byte < 0x80) {
+                break;
+            }
+        }
+        epoch += delta;
+        epochs.push(epoch);
+    }
+    offset = 24 + epochsBytes;
+
+    function column(signed) {
+        const values = [];
+        for (let idx = 0; idx < count; ++idx) {
+            const value = signed ? view.getInt16(offset, true) : view.getUint16(offset, true);
+            values.push(value);
+            offset += 2;
+        }
+        return values;
+    }
+
+    const values = [];
+    if (resolution === "raw") {
+        const temperatures = column(true);
+        const humidities = column(false);
+        for (let idx = 0; idx < count; ++idx) {
+            const value = [epochs[idx], temperatures[idx] / 100, humidities[idx] / 100];
+            if (view.getUint8(offset + (idx >> 3)) & (1 << (idx & 7))) {
+                value.push(true);
+            }
+            values.push(value);
+        }
+        return { "identifier": identifier, "values": values };
+    }
 
-async function initialFetchSensorsData(sensorsData, temperatureChart, humidityChart) {
-    gSensorIDsToNames = await fetchSensorsMapping();
+    const columns = [column(true), column(false), column(true), column(true), column(false),
+        column(false)];
+    const counts = column(false);
+    for (let idx = 0; idx < count; ++idx) {
+        values.push([epochs[idx], ...columns.map((centi) => centi[idx] / 100), counts[idx]]);
+    }
+    return { "identifier": identifier, "resolution": resolution, "values": values };
+}
 
-    for (const [identifier, name] of Object.entries(gSensorIDsToNames)) {
-        const dataResponse = await fetch('sensorData?' + new URLSearchParams({
-            "identifier": identifier
-        }))
+// Splits the packed /sensorData/all response: the name mapping as JSON, then packed readings of
+// every sensor, each part after its u32 little-endian length
+function decodeAllSensorsData(buffer) {
+    const view = new DataView(buffer);
+    const parts = [];
+    for (let offset = 0; offset < buffer.byteLength;) {
+        const length = view.getUint32(offset, true);
+        parts.push(buffer.slice(offset + 4, offset + 4 + length));
+        offset += 4 + length;
+    }
 
-        const readings = await dataResponse.json();
+    const names = JSON.parse(new TextDecoder().decode(parts[0]));
+    return { "names": names, "sensors": parts.slice(1).map(decodePackedReadings) };
+}
 
-        addDataToSensor(sensorsData, readings, name);
-        temperatureChart.draw(sensorsData, TEMPERATURE_IDX);
-        humidityChart.draw(sensorsData, HUMIDITY_IDX);
+async function initialFetchSensorsData(sensorsData, temperatureChart, humidityChart, maxPoints) {
+    // Names and readings of all sensors in one request, sorted by time and downsampled to one
+    // per pixel
+    const dayBeforeEpoch = Math.round(Date.now() / 1000) - SEC_IN_DAY;
+    const dataResponse = await fetch('sensorData/all?' + new URLSearchParams({
+        "from": dayBeforeEpoch,
+        "maxPoints": maxPoints
+    }), { headers: { "Accept": "application/octet-stream" } })
+
+    const allSensors = decodeAllSensorsData(await dataResponse.arrayBuffer());
+    gSensorIDsToNames = allSensors.names;
+    for (const readings of allSensors.sensors) {
+        addDataToSensor(sensorsData, readings, gSensorIDsToNames[readings.identifier]);
     }
+    temperatureChart.draw(sensorsData, TEMPERATURE_IDX);
+    humidityChart.draw(sensorsData, HUMIDITY_IDX);
 }
 
 function removeOlderReadingsThanOneDay(data) {
     for (const [identifier, payload] of Object.entries(data)) {
-        let values = payload.values;
-
-        // Sort by time
-        values.sort((a, b) => a[TIME_IDX] - b[TIME_IDX]);
-        let elemsToRemove = values.length - MAX_ARR_ELEMS;
-        if (elemsToRemove > 0) {
-            data[identifier].values = values.slice(elemsToRemove);
-        }
-
-        const secInDay = 24 * 60 * 60;
         const currentEpoch = Math.round(Date.now() / 1000);
-        const dayBeforeEpoch = currentEpoch - secInDay;
+        const dayBeforeEpoch = currentEpoch - SEC_IN_DAY;
 
         // Filter too old readings
         data[identifier].values = data[identifier].values.filter((reading) => reading[TIME_IDX] > dayBeforeEpoch);
@@ -51,7 +115,7 @@ function removeOlderReadingsThanOneDay(data) {
 function addDataToSensor(sensorsData, reading, name) {
     function setInitialData() {
         const identifier = reading["identifier"]
-        const values = reading["values"];
+        const values = reading["values"].filter((value) => !value[SUSPECT_IDX]);
     
         sensorsData[identifier] = {
             "name": name,
@@ -64,7 +128,9 @@ function addDataToSensor(sensorsData, reading, name) {
 
     if (sensorsData.hasOwnProperty(identifier)) {
         sensorsData[identifier]["values"] = sensorsData[identifier]["values"] || [];
-        sensorsData[identifier]["values"].push(values);
+        if (values !== undefined && !values[SUSPECT_IDX]) {
+            sensorsData[identifier]["values"].push(values);
+        }
     }
     else {
         setInitialData();
@@ -78,7 +144,8 @@ window.addEventListener('load', function () {
     const humidityCanvas = document.getElementById("humidityCanvas");
     const humidityChart = new MicroChart(humidityCanvas, "Humidity");
 
-    initialFetchSensorsData(gSensorsData, temperatureChart, humidityChart);
+    initialFetchSensorsData(gSensorsData, temperatureChart, humidityChart,
+        Math.max(temperatureCanvas.clientWidth, 2));
     temperatureChart.draw(gSensorsData, TEMPERATURE_IDX);
     humidityChart.draw(gSensorsData, HUMIDITY_IDX);
 
@@ -1,12 +1,20 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 
 class IWebRequest
 {
 public:
+    // Writes up to maxLen next bytes of a response into buffer and returns their number, zero ends
+    // the response. It is called from the server task after the handler returned, so it has to own
+    // whatever it reads from.
+    using Filler = std::function<std::size_t(uint8_t *buffer, std::size_t maxLen)>;
+
     IWebRequest() = default;
     IWebRequest(const IWebRequest &) = default;
     IWebRequest(IWebRequest &&) = default;
@@ -18,9 +26,19 @@ public:
     virtual void send(int code, const std::string &contentType, const uint8_t *content, size_t len)
         = 0;
     virtual void send(int code, const std::string &contentType, const char *content) = 0;
+    // The content is kept alive until it is sent
+    virtual void send(int code,
+                      const std::string &contentType,
+                      const std::shared_ptr<const std::string> &content)
+        = 0;
+    // Chunked response of unknown length, produced piece by piece as the connection takes it
+    virtual void sendChunked(int code, const std::string &contentType, const Filler &filler) = 0;
     virtual void send(int code) = 0;
     virtual void redirect(const std::string &url) = 0;
     virtual bool authenticate(const std::string &user, const std::string &passwd) = 0;
     virtual void requestAuthentication() = 0;
     virtual std::map<std::string, std::string> getParams() = 0;
+    virtual std::optional<std::string> getHeader(const std::string &name) = 0;
+    // Added to the response sent next
+    virtual void addHeader(const std::string &name, const std::string &value) = 0;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IWebRequest.hpp"
+
+// Building blocks of chunked responses. Fillers are copied into the server, so their state is
+// shared between the copies.
+namespace response_fillers
+{
+inline IWebRequest::Filler fromString(const std::shared_ptr<const std::string> &content)
+{
+    auto offset = std::make_shared<std::size_t>(0);
+    return [content, offset](uint8_t *buffer, std::size_t maxLen) -> std::size_t
+    {
+        auto len = std::min(maxLen, content->size() - *offset);
+        std::memcpy(buffer, content->data() + *offset, len);  // NOLINT
+        *offset += len;
+        return len;
+    };
+}
+
+// Parts are asked for one after another when the previous one ended, an empty filler ends the
+// response. Only the current part is held, whatever the length of the whole response.
+inline IWebRequest::Filler concat(const std::function<IWebRequest::Filler()> &nextPart)
+{
+    auto next = std::make_shared<std::function<IWebRequest::Filler()>>(nextPart);
+    auto part = std::make_shared<IWebRequest::Filler>((*next)());
+    return [next, part](uint8_t *buffer, std::size_t maxLen) -> std::size_t
+    {
+        std::size_t written = 0;
+        while (written < maxLen && *part)
+        {
+            auto len = (*part)(buffer + written, maxLen - written);  // NOLINT
+            written += len;
+            if (len == 0)
+            {
+                *part = (*next)();
+            }
+        }
+        return written;
+    };
+}
+
+inline IWebRequest::Filler sequence(const std::vector<std::function<IWebRequest::Filler()>> &parts)
+{
+    auto next = std::make_shared<std::size_t>(0);
+    return concat(
+        [parts, next]
+        { return *next < parts.size() ? parts[(*next)++]() : IWebRequest::Filler{}; });
+}
+}  // namespace response_fillers
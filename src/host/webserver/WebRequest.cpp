@@ -1,5 +1,8 @@
 #include "WebRequest.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 WebRequest::WebRequest(AsyncWebServerRequest *WebRequest)
     : m_WebRequest(WebRequest)
 {
@@ -7,17 +10,55 @@ WebRequest::WebRequest(AsyncWebServerRequest *WebRequest)
 
 void WebRequest::send(int code, const std::string &contentType, const uint8_t *content, size_t len)
 {
-    m_WebRequest->send_P(code, contentType.c_str(), content, len);
+    send(m_WebRequest->beginResponse_P(code, contentType.c_str(), content, len));
 }
 
 void WebRequest::send(int code, const std::string &contentType, const char *content)
 {
-    m_WebRequest->send_P(code, contentType.c_str(), content);
+    send(m_WebRequest->beginResponse_P(code, contentType.c_str(), content));
+}
+
+void WebRequest::send(int code,
+                      const std::string &contentType,
+                      const std::shared_ptr<const std::string> &content)
+{
+    // send_P would keep only a pointer to the content, which is read later as the connection
+    // accepts more data
+    auto *response = m_WebRequest->beginResponse(
+        contentType.c_str(), content->size(),
+        [content](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+        {
+            auto len = std::min(maxLen, content->size() - index);
+            std::memcpy(buffer, content->data() + index, len);
+            return len;
+        });
+    response->setCode(code);
+    send(response);
+}
+
+void WebRequest::sendChunked(int code, const std::string &contentType, const Filler &filler)
+{
+    auto *response = m_WebRequest->beginChunkedResponse(
+        contentType.c_str(),
+        [filler](uint8_t *buffer, size_t maxLen, size_t /*index*/) -> size_t
+        { return filler(buffer, maxLen); });
+    response->setCode(code);
+    send(response);
 }
 
 void WebRequest::send(int code)
 {
-    m_WebRequest->send(code);
+    send(m_WebRequest->beginResponse(code));
+}
+
+void WebRequest::send(AsyncWebServerResponse *response)
+{
+    for (const auto &[name, value] : m_headers)
+    {
+        response->addHeader(name.c_str(), value.c_str());
+    }
+    m_headers.clear();
+    m_WebRequest->send(response);
 }
 
 void WebRequest::redirect(const std::string &url)
@@ -50,3 +91,18 @@ std::map<std::string, std::string> WebRequest::getParams()
 
     return paramsMap;
 }
+
+std::optional<std::string> WebRequest::getHeader(const std::string &name)
+{
+    AsyncWebHeader *header = m_WebRequest->getHeader(name.c_str());
+    if (header == nullptr)
+    {
+        return std::nullopt;
+    }
+    return header->value().c_str();
+}
+
+void WebRequest::addHeader(const std::string &name, const std::string &value)
+{
+    m_headers.emplace_back(name, value);
+}
@@ -4,6 +4,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "IWebRequest.hpp"
 
@@ -16,12 +18,21 @@ public:
               const uint8_t *content,
               size_t len) override;
     void send(int code, const std::string &contentType, const char *content) override;
+    void send(int code,
+              const std::string &contentType,
+              const std::shared_ptr<const std::string> &content) override;
+    void sendChunked(int code, const std::string &contentType, const Filler &filler) override;
     void send(int code) override;
     void redirect(const std::string &url) override;
     bool authenticate(const std::string &user, const std::string &passwd) override;
     void requestAuthentication() override;
     std::map<std::string, std::string> getParams() override;
+    std::optional<std::string> getHeader(const std::string &name) override;
+    void addHeader(const std::string &name, const std::string &value) override;
 
 private:
     AsyncWebServerRequest *m_WebRequest;
+    std::vector<std::pair<std::string, std::string>> m_headers;
+
+    void send(AsyncWebServerResponse *response);
 };
@@ -0,0 +1,39 @@
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+// The replacements live in their own translation unit, so they are never inlined into a caller
+// where the compiler would see memory from operator new released by free
+namespace
+{
+std::size_t allocationsNum = 0;
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+    ++allocationsNum;
+    if (void *memory = std::malloc(size); memory != nullptr)
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace benchmark
+{
+std::size_t allocations()
+{
+    return allocationsNum;
+}
+}  // namespace benchmark
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+namespace benchmark
+{
+// Heap allocations of the whole benchmark binary so far, CppUTest leak detection is disabled
+std::size_t allocations();
+}  // namespace benchmark
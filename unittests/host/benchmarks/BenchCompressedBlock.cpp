@@ -0,0 +1,142 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cinttypes>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "CompressedBlock.hpp"
+#include "RingBuffer.hpp"
+
+namespace
+{
+struct Reading
+{
+    float temperature;
+    float humidity;
+    uint32_t epochTime;
+};
+
+constexpr uint16_t ringBufferReadings = 220;
+constexpr std::size_t readingsNum = 100000;
+
+// Sensor reporting every minute (with a few seconds of jitter) and slowly changing values
+std::vector<Reading> generateReadings()
+{
+    std::vector<Reading> readings;
+    uint32_t epoch = 1700000000;
+    auto temperature = 21.5F;
+    auto humidity = 40.0F;
+    for (std::size_t idx = 0; idx < readingsNum; ++idx)
+    {
+        readings.push_back({temperature, humidity, epoch});
+        epoch += 60 + idx % 3;
+        temperature += (idx % 13 < 6) ? 0.01F : -0.01F;
+        humidity += (idx % 17 < 8) ? 0.03F : -0.03F;
+    }
+    return readings;
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(CompressedBlockBenchmark)  // NOLINT
+{
+    std::vector<Reading> readings{generateReadings()};
+};
+// clang-format on
+
+TEST(CompressedBlockBenchmark, EncodeCost)  // NOLINT
+{
+    RingBuffer<Reading, ringBufferReadings> ringBuffer;
+    auto ringBufferNs = benchmark::nsPerIteration(readings.size(),
+                                                  [&](std::size_t idx)
+                                                  {
+                                                      ringBuffer.put(readings[idx]);
+                                                      benchmark::doNotOptimize(ringBuffer);
+                                                  });
+
+    // A full block is started over, as the archive does when it stores one
+    CompressedBlock block;
+    auto compressedNs = benchmark::nsPerIteration(
+        readings.size(),
+        [&](std::size_t idx)
+        {
+            const auto &reading = readings[idx];
+            if (!block.append(reading.epochTime, reading.temperature, reading.humidity))
+            {
+                block.clear();
+                block.append(reading.epochTime, reading.temperature, reading.humidity);
+            }
+            benchmark::doNotOptimize(block);
+        });
+
+    benchmark::report("RingBuffer<Reading, 220> put", ringBufferNs, "ns/reading");
+    benchmark::report("CompressedBlock append", compressedNs, "ns/reading");
+}
+
+TEST(CompressedBlockBenchmark, DecodeThroughput)  // NOLINT
+{
+    constexpr std::size_t passes = 1000;
+
+    RingBuffer<Reading, ringBufferReadings> ringBuffer;
+    CompressedBlock block;
+    for (const auto &reading : readings)
+    {
+        ringBuffer.put(reading);
+        if (!block.append(reading.epochTime, reading.temperature, reading.humidity))
+        {
+            break;
+        }
+    }
+
+    auto ringBufferNs = benchmark::nsPerIteration(passes,
+                                                  [&](std::size_t)
+                                                  {
+                                                      float sum = 0;
+                                                      for (const auto &reading : ringBuffer)
+                                                      {
+                                                          sum += reading.temperature;
+                                                      }
+                                                      benchmark::doNotOptimize(sum);
+                                                  });
+
+    auto blockNs = benchmark::nsPerIteration(passes,
+                                             [&](std::size_t)
+                                             {
+                                                 float sum = 0;
+                                                 for (const auto &reading : block)
+                                                 {
+                                                     sum += reading.temperature;
+                                                 }
+                                                 benchmark::doNotOptimize(sum);
+                                             });
+
+    constexpr auto nsInSecond = 1e9;
+    benchmark::report("RingBuffer<Reading, 220> iterate",
+                      ringBufferReadings * nsInSecond / ringBufferNs / 1e6, "M readings/s");
+    benchmark::report("CompressedBlock decode", block.size() * nsInSecond / blockNs / 1e6,
+                      "M readings/s");
+}
+
+TEST(CompressedBlockBenchmark, BytesPerReading)  // NOLINT
+{
+    std::size_t blocks = 1;
+    CompressedBlock block;
+    for (const auto &reading : readings)
+    {
+        if (!block.append(reading.epochTime, reading.temperature, reading.humidity))
+        {
+            ++blocks;
+            block.clear();
+            block.append(reading.epochTime, reading.temperature, reading.humidity);
+        }
+    }
+
+    using ReadingsRingBuffer = RingBuffer<Reading, ringBufferReadings>;
+    benchmark::report("RingBuffer<Reading, 220>",
+                      static_cast<double>(sizeof(ReadingsRingBuffer)) / ringBufferReadings,
+                      "bytes/reading");
+    benchmark::report("CompressedBlock",
+                      static_cast<double>(blocks * CompressedBlock::blockBytes)
+                          / static_cast<double>(readings.size()),
+                      "bytes/reading");
+}
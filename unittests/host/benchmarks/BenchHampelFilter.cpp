@@ -0,0 +1,61 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cinttypes>
+
+#include "Benchmark.hpp"
+#include "HampelFilter.hpp"
+#include "ReadingsStorage.hpp"
+
+namespace
+{
+constexpr std::size_t readingsNum = 200000;
+constexpr IDType sensorsNum = 16;
+
+// Slowly changing temperature with a spike every few hundred readings
+float temperatureAt(std::size_t idx)
+{
+    if (idx % 397 == 0)
+    {
+        return 85.0F;
+    }
+    return 21.0F + static_cast<float>(idx % 50) / 100.0F;
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(HampelFilterBenchmark)  // NOLINT
+{
+};
+// clang-format on
+
+TEST(HampelFilterBenchmark, CheckOfOneSample)  // NOLINT
+{
+    HampelFilter<7> filter;
+    std::size_t outliers = 0;
+    auto checkNs = benchmark::nsPerIteration(
+        readingsNum,
+        [&](std::size_t idx) { outliers += filter.check(temperatureAt(idx), 3.0F, 0.5F) ? 1 : 0; });
+    benchmark::doNotOptimize(outliers);
+
+    benchmark::report("HampelFilter<7>::check", checkNs, "ns/sample");
+    benchmark::report("HampelFilter<7> state", sizeof(filter), "bytes");
+}
+
+TEST(HampelFilterBenchmark, AddReadingWithAndWithoutFilter)  // NOLINT
+{
+    auto measure = [](float threshold)
+    {
+        ReadingsStorage storage;
+        storage.setOutlierThreshold(threshold);
+        return benchmark::nsPerIteration(readingsNum,
+                                         [&storage](std::size_t idx)
+                                         {
+                                             auto sensorId = static_cast<IDType>(idx % sensorsNum);
+                                             storage.addReading(sensorId, temperatureAt(idx), 40.0F,
+                                                                idx / sensorsNum * 60);
+                                         });
+    };
+
+    benchmark::report("addReading, 16 sensors, filter disabled", measure(0), "ns/reading");
+    benchmark::report("addReading, 16 sensors, filter enabled", measure(3.0F), "ns/reading");
+}
@@ -0,0 +1,100 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "MappedHistoryReader.hpp"
+#include "ReadingsArchive.hpp"
+#include "ReadingsLog.hpp"
+#include "mocks/FileMappedRegion.hpp"
+#include "mocks/FileSystemFake.hpp"
+
+namespace
+{
+constexpr unsigned long secondsInDay = 86400;
+constexpr unsigned long firstDay = 19600;
+constexpr unsigned long dayStart = firstDay * secondsInDay;
+// The last day stays partly in the readings log, only the full days before it are compared
+constexpr unsigned long daysNum = 7;
+constexpr unsigned long archivedDays = daysNum - 1;
+constexpr unsigned long period = 60;
+constexpr IDType sensorsNum = 8;
+}  // namespace
+
+// clang-format off
+TEST_GROUP(MappedHistoryReaderBenchmark)  // NOLINT
+{
+    void teardown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    std::shared_ptr<FileSystemFake> fileSystem{std::make_shared<FileSystemFake>()};
+    std::shared_ptr<ReadingsLog> log{std::make_shared<ReadingsLog>(fileSystem, "/readings")};
+    std::string path;
+};
+// clang-format on
+
+TEST(MappedHistoryReaderBenchmark, RangeQueryFromMappedImageVersusFileReads)  // NOLINT
+{
+    constexpr std::size_t queries = 1000;
+    constexpr unsigned long rangeSeconds = 3600;
+
+    // Archived every hour as the background maintenance would do
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    auto temperature = 21.5F;
+    std::size_t idx = 0;
+    for (auto epoch = dayStart; epoch < dayStart + daysNum * secondsInDay; epoch += period, ++idx)
+    {
+        for (IDType identifier = 1; identifier <= sensorsNum; ++identifier)
+        {
+            log->append({identifier, temperature, 40.0, epoch + idx % 3});
+        }
+        temperature += (idx % 13 < 6) ? 0.01F : -0.01F;
+
+        if (epoch % 3600 == 0)
+        {
+            while (archive.compact(epoch))
+            {
+            }
+        }
+    }
+
+    std::vector<uint8_t> image;
+    for (auto day = firstDay; day < firstDay + archivedDays; ++day)
+    {
+        const auto &bytes = fileSystem->content("/archive-d" + std::to_string(day) + ".bin");
+        image.insert(image.end(), bytes.begin(), bytes.end());
+    }
+    std::string pattern = "/tmp/mappedHistoryXXXXXX";
+    auto descriptor = ::mkstemp(pattern.data());
+    CHECK_EQUAL(image.size(), ::write(descriptor, image.data(), image.size()));
+    ::close(descriptor);
+    path = pattern;
+    MappedHistoryReader reader(std::make_unique<FileMappedRegion>(path));
+    CHECK_TRUE(reader.valid());
+
+    auto measure = [&](const IHistoryReader &history)
+    {
+        return benchmark::nsPerIteration(
+            queries,
+            [&](std::size_t idx)
+            {
+                auto from = dayStart
+                            + (idx * 7919 * period) % (archivedDays * secondsInDay - rangeSeconds);
+                history.read(idx % sensorsNum + 1, from, from + rangeSeconds,
+                             [](unsigned long, float temp, float)
+                             { benchmark::doNotOptimize(temp); });
+            });
+    };
+
+    benchmark::report("1h range, daily files through seek and read", measure(archive) / 1000,
+                      "us/query");
+    benchmark::report("1h range, mapped image of the same days", measure(reader) / 1000,
+                      "us/query");
+}
@@ -0,0 +1,150 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+
+#include "Benchmark.hpp"
+#include "ReadingsArchive.hpp"
+#include "ReadingsLog.hpp"
+#include "mocks/FileSystemFake.hpp"
+
+namespace
+{
+constexpr unsigned long secondsInDay = 86400;
+constexpr unsigned long secondsInWeek = 7 * secondsInDay;
+constexpr unsigned long weekStart = 2800 * secondsInWeek;
+constexpr unsigned long period = 60;
+constexpr IDType sensorsNum = 7;
+// Large enough to keep every reading, the query latency is measured against the archive size
+constexpr std::size_t unlimitedBudgetBytes = 64 * 1024 * 1024;
+// LittleFS partition of the default node32s partition table
+constexpr std::size_t partitionBytes = 0x160000;
+
+// Sensors reporting every minute (with a few seconds of jitter) and slowly changing values, the
+// log is archived every hour as the background maintenance would do
+void fillArchive(ReadingsLog &log, ReadingsArchive &archive, unsigned long weeks)
+{
+    auto temperature = 21.5F;
+    auto humidity = 40.0F;
+    std::size_t idx = 0;
+    for (auto epoch = weekStart; epoch < weekStart + weeks * secondsInWeek; epoch += period, ++idx)
+    {
+        for (IDType identifier = 1; identifier <= sensorsNum; ++identifier)
+        {
+            log.append({identifier, temperature, humidity, epoch + idx % 3});
+        }
+        temperature += (idx % 13 < 6) ? 0.01F : -0.01F;
+        humidity += (idx % 17 < 8) ? 0.03F : -0.03F;
+
+        if (epoch % 3600 == 0)
+        {
+            while (archive.compact(epoch))
+            {
+            }
+        }
+    }
+}
+
+std::size_t archivedBytes(FileSystemFake &fileSystem, unsigned long weeks)
+{
+    std::size_t bytes = 0;
+    for (auto day = weekStart / secondsInDay; day <= (weekStart / secondsInDay) + weeks * 7; ++day)
+    {
+        auto path = "/archive-d" + std::to_string(day) + ".bin";
+        if (fileSystem.exists(path))
+        {
+            bytes += fileSystem.content(path).size();
+        }
+    }
+    return bytes;
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(ReadingsArchiveBenchmark)  // NOLINT
+{
+};
+// clang-format on
+
+TEST(ReadingsArchiveBenchmark, RangeQueryLatencyVersusArchiveSize)  // NOLINT
+{
+    constexpr std::size_t queries = 200;
+    constexpr unsigned long rangeSeconds = 3600;
+
+    for (unsigned long weeks : {1, 4, 12})
+    {
+        auto fileSystem = std::make_shared<FileSystemFake>();
+        auto log = std::make_shared<ReadingsLog>(fileSystem, "/readings");
+        ReadingsArchive archive(fileSystem, log, "/archive-", unlimitedBudgetBytes);
+        fillArchive(*log, archive, weeks);
+
+        // Hour long ranges spread over the whole archive, for one of the sensors
+        std::size_t visited = 0;
+        auto queryNs = benchmark::nsPerIteration(
+            queries,
+            [&](std::size_t idx)
+            {
+                auto from = weekStart + (idx * 7919 * period) % (weeks * secondsInWeek - 86400);
+                visited += archive.read(3, from, from + rangeSeconds,
+                                        [](unsigned long, float temp, float)
+                                        { benchmark::doNotOptimize(temp); });
+            });
+
+        auto name = "1h range of 1 of 7 sensors, " + std::to_string(weeks) + " archived weeks";
+        benchmark::report(name.c_str(), queryNs / 1000, "us/query");
+        benchmark::report("  readings per query", static_cast<double>(visited) / queries,
+                          "readings");
+    }
+}
+
+TEST(ReadingsArchiveBenchmark, FlashUsedPerReading)  // NOLINT
+{
+    constexpr unsigned long weeks = 1;
+    auto fileSystem = std::make_shared<FileSystemFake>();
+    auto log = std::make_shared<ReadingsLog>(fileSystem, "/readings");
+    ReadingsArchive archive(fileSystem, log, "/archive-", unlimitedBudgetBytes);
+    fillArchive(*log, archive, weeks);
+
+    std::size_t readings = 0;
+    for (IDType identifier = 1; identifier <= sensorsNum; ++identifier)
+    {
+        readings += archive.read(identifier, weekStart, weekStart + weeks * secondsInWeek,
+                                 [](unsigned long, float, float) {});
+    }
+
+    auto bytesPerReading = static_cast<double>(archivedBytes(*fileSystem, weeks)) / readings;
+    benchmark::report("Archived bytes per reading", bytesPerReading, "B");
+    benchmark::report("Days of 7 sensors in a 1.4 MB partition",
+                      ReadingsArchive::budgetFor(partitionBytes)
+                          / (bytesPerReading * sensorsNum * secondsInDay / period),
+                      "days");
+}
+
+TEST(ReadingsArchiveBenchmark, CompactionStepLatency)  // NOLINT
+{
+    auto fileSystem = std::make_shared<FileSystemFake>();
+    auto log = std::make_shared<ReadingsLog>(fileSystem, "/readings");
+    ReadingsArchive archive(fileSystem, log, "/archive-", unlimitedBudgetBytes);
+    while (archive.compact(weekStart))
+    {
+    }
+
+    // Three closed log segments waiting for the archive
+    for (unsigned long idx = 0; idx < 2000; ++idx)
+    {
+        log->append({idx % sensorsNum + 1, 21.5, 40.0, weekStart + idx * 10});
+    }
+    log->flush();
+
+    std::size_t steps = 0;
+    auto stepNs = benchmark::nsPerIteration(1,
+                                            [&](std::size_t)
+                                            {
+                                                while (archive.compact(weekStart))
+                                                {
+                                                    ++steps;
+                                                }
+                                            });
+    benchmark::report("Compaction step", stepNs / 1000 / static_cast<double>(steps), "us/step");
+}
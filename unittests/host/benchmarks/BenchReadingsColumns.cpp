@@ -0,0 +1,95 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cinttypes>
+
+#include "Benchmark.hpp"
+#include "ReadingsColumns.hpp"
+#include "RingBuffer.hpp"
+
+namespace
+{
+// Layout used by ReadingsStorage before the columnar one, epoch is 32 bit wide on ESP32
+struct Reading
+{
+    float temperature;
+    float humidity;
+    uint32_t epochTime;
+};
+
+constexpr uint16_t readingsPerSensor = 220;
+constexpr std::size_t passes = 100000;
+}  // namespace
+
+// clang-format off
+TEST_GROUP(ReadingsColumnsBenchmark)  // NOLINT
+{
+    void setup() override
+    {
+        for (uint32_t idx = 0; idx < readingsPerSensor * 2; ++idx)
+        {
+            auto temperature = 20.0F + static_cast<float>(idx % 50) / 10;
+            auto humidity = 40.0F + static_cast<float>(idx % 30) / 10;
+            ringBuffer.put({temperature, humidity, idx * 60});
+            columns.put(idx * 60, temperature, humidity);
+        }
+    }
+
+    RingBuffer<Reading, readingsPerSensor> ringBuffer;
+    ReadingsColumns<readingsPerSensor> columns;
+};
+// clang-format on
+
+TEST(ReadingsColumnsBenchmark, MemoryPerSensor)  // NOLINT
+{
+    benchmark::report("RingBuffer<Reading, 220>", sizeof(ringBuffer), "bytes");
+    benchmark::report("ReadingsColumns<220>", sizeof(columns), "bytes");
+}
+
+TEST(ReadingsColumnsBenchmark, SingleMetricWalk)  // NOLINT
+{
+    auto ringBufferNs = benchmark::nsPerIteration(passes,
+                                                  [&](std::size_t)
+                                                  {
+                                                      double sum = 0;
+                                                      for (const auto &reading : ringBuffer)
+                                                      {
+                                                          sum += reading.temperature;
+                                                      }
+                                                      benchmark::doNotOptimize(sum);
+                                                  });
+
+    auto columnsNs = benchmark::nsPerIteration(passes,
+                                               [&](std::size_t)
+                                               {
+                                                   double sum = 0;
+                                                   columns.forEachTemperature(
+                                                       [&sum](uint32_t, double value)
+                                                       { sum += value; });
+                                                   benchmark::doNotOptimize(sum);
+                                               });
+
+    benchmark::report("RingBuffer<Reading, 220> temperature walk", ringBufferNs, "ns/sensor");
+    benchmark::report("ReadingsColumns<220> temperature walk", columnsNs, "ns/sensor");
+}
+
+TEST(ReadingsColumnsBenchmark, Put)  // NOLINT
+{
+    auto ringBufferNs = benchmark::nsPerIteration(passes,
+                                                  [&](std::size_t idx)
+                                                  {
+                                                      ringBuffer.put({21.5F, 40.0F,
+                                                                      static_cast<uint32_t>(idx)});
+                                                      benchmark::doNotOptimize(ringBuffer);
+                                                  });
+
+    auto columnsNs = benchmark::nsPerIteration(passes,
+                                               [&](std::size_t idx)
+                                               {
+                                                   columns.put(static_cast<uint32_t>(idx), 21.5F,
+                                                               40.0F);
+                                                   benchmark::doNotOptimize(columns);
+                                               });
+
+    benchmark::report("RingBuffer<Reading, 220> put", ringBufferNs, "ns/reading");
+    benchmark::report("ReadingsColumns<220> put", columnsNs, "ns/reading");
+}
@@ -0,0 +1,142 @@
+#include <CppUTest/TestHarness.h>
+
+#include <array>
+#include <cinttypes>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+#include "ReadingsStorage.hpp"
+
+namespace
+{
+constexpr std::size_t requestsNum = 2000;
+constexpr IDType sensorsNum = 16;
+constexpr unsigned long readingsPeriodSecs = 60;
+constexpr unsigned long dayEpoch = 24 * 60 * 60;
+// Width of a chart canvas, as sent by the charts page
+constexpr std::size_t chartMaxPoints = 800;
+
+// A day of readings of 16 sensors, as much as the raw pool holds
+void fill(ReadingsStorage &storage)
+{
+    for (unsigned long epoch = 0; epoch < dayEpoch; epoch += readingsPeriodSecs)
+    {
+        for (IDType sensorId = 0; sensorId < sensorsNum; ++sensorId)
+        {
+            storage.addReading(sensorId, 21.0F + static_cast<float>(epoch % 500) / 100.0F,
+                               40.0F + static_cast<float>(sensorId), epoch);
+        }
+    }
+}
+
+// Readings of one sensor every minute for longer than the hourly rollup keeps
+unsigned long fillOneSensor(ReadingsStorage &storage)
+{
+    constexpr unsigned long days = 8;
+    unsigned long epoch = 0;
+    for (; epoch < days * dayEpoch; epoch += readingsPeriodSecs)
+    {
+        storage.addReading(0, 21.0F + static_cast<float>(epoch % 500) / 100.0F,
+                           40.0F + static_cast<float>(epoch % 300) / 10.0F, epoch);
+    }
+    return epoch;
+}
+
+ReadingsQuery chartQuery(IDType sensorId, std::size_t requestIdx)
+{
+    ReadingsQuery query{sensorId};
+    // Every request comes a second later, as from different browser tabs
+    query.from = requestIdx % 60;
+    query.maxPoints = chartMaxPoints;
+    return query;
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(ReadingsStorageBenchmark)  // NOLINT
+{
+};
+// clang-format on
+
+TEST(ReadingsStorageBenchmark, SensorDataRequests)  // NOLINT
+{
+    ReadingsStorage storage;
+    fill(storage);
+
+    // A reading before each request, so every response is serialized again
+    unsigned long epoch = dayEpoch;
+    auto startAllocations = benchmark::allocations();
+    auto uncachedNs = benchmark::nsPerIteration(
+        requestsNum,
+        [&storage, &epoch](std::size_t idx)
+        {
+            auto sensorId = static_cast<IDType>(idx % sensorsNum);
+            storage.addReading(sensorId, 21.0F, 40.0F, epoch++);
+            benchmark::doNotOptimize(storage.getReadings(chartQuery(sensorId, idx)));
+        });
+    auto uncachedAllocations
+        = static_cast<double>(benchmark::allocations() - startAllocations) / requestsNum;
+
+    startAllocations = benchmark::allocations();
+    auto cachedNs = benchmark::nsPerIteration(
+        requestsNum,
+        [&storage](std::size_t idx)
+        {
+            auto sensorId = static_cast<IDType>(idx % sensorsNum);
+            benchmark::doNotOptimize(storage.getReadings(chartQuery(sensorId, idx)));
+        });
+    auto cachedAllocations
+        = static_cast<double>(benchmark::allocations() - startAllocations) / requestsNum;
+
+    benchmark::report("addReading + getReadings, serialized again", uncachedNs, "ns/request");
+    benchmark::report("addReading + getReadings, serialized again", uncachedAllocations,
+                      "allocations/request");
+    benchmark::report("getReadings, shared response", cachedNs, "ns/request");
+    benchmark::report("getReadings, shared response", cachedAllocations,
+                      "allocations/request");
+}
+
+TEST(ReadingsStorageBenchmark, SensorDataEncodings)  // NOLINT
+{
+    constexpr std::size_t encodingRequestsNum = 50;
+    constexpr std::array<std::pair<ReadingsQuery::Encoding, const char *>, 4> encodings{{
+        {ReadingsQuery::Encoding::JSON, "json"},
+        {ReadingsQuery::Encoding::CBOR, "cbor"},
+        {ReadingsQuery::Encoding::MSGPACK, "msgpack"},
+        {ReadingsQuery::Encoding::PACKED, "packed"},
+    }};
+
+    ReadingsStorage storage;
+    auto epoch = fillOneSensor(storage);
+
+    // The whole raw history and the full hourly ring buffer, a reading before each request
+    // keeps responses from being shared
+    for (auto resolution : {ReadingsQuery::Resolution::RAW, ReadingsQuery::Resolution::HOURLY})
+    {
+        const auto valuesNum
+            = nlohmann::json::parse(storage.getReadingsAsJsonStr({0, resolution}))["values"].size();
+        for (const auto &[encoding, encodingName] : encodings)
+        {
+            ReadingsQuery query{0, resolution};
+            query.encoding = encoding;
+            std::size_t bytes = 0;
+            auto ns = benchmark::nsPerIteration(
+                encodingRequestsNum,
+                [&storage, &epoch, &query, &bytes](std::size_t /*idx*/)
+                {
+                    storage.addReading(0, 21.0F, 40.0F, epoch++);
+                    auto response = storage.getReadings(query);
+                    bytes = response->size();
+                });
+
+            std::string name = std::string(ReadingsQuery::resolutionToStr(resolution)) + " "
+                               + encodingName + ", " + std::to_string(valuesNum) + " values";
+            benchmark::report(name.c_str(), ns / 1000, "us/request");
+            benchmark::report(name.c_str(), static_cast<double>(bytes) / valuesNum,
+                              "bytes/value");
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include <CppUTest/TestHarness.h>
+
+#include <array>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "RingBuffer.hpp"
+
+namespace
+{
+struct Reading
+{
+    float temperature;
+    float humidity;
+    uint32_t epochTime;
+};
+
+constexpr std::size_t iterations = 1000000;
+constexpr std::size_t passes = 100000;
+constexpr std::size_t batchSize = 64;
+
+template <uint16_t length>
+double putNs()
+{
+    RingBuffer<Reading, length> ringBuffer;
+    return benchmark::nsPerIteration(iterations,
+                                     [&](std::size_t idx)
+                                     {
+                                         ringBuffer.put({21.5F, 40.0F, static_cast<uint32_t>(idx)});
+                                         benchmark::doNotOptimize(ringBuffer);
+                                     });
+}
+
+template <uint16_t length>
+double iterateNs()
+{
+    RingBuffer<Reading, length> ringBuffer;
+    for (uint32_t idx = 0; idx < length * 2 + 7; ++idx)
+    {
+        ringBuffer.put({static_cast<float>(idx), 40.0F, idx});
+    }
+
+    return benchmark::nsPerIteration(passes,
+                                     [&](std::size_t)
+                                     {
+                                         float sum = 0;
+                                         for (const auto &reading : ringBuffer)
+                                         {
+                                             sum += reading.temperature;
+                                         }
+                                         benchmark::doNotOptimize(sum);
+                                     })
+           / length;
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(RingBufferBenchmark)  // NOLINT
+{
+};
+// clang-format on
+
+TEST(RingBufferBenchmark, Put)  // NOLINT
+{
+    benchmark::report("RingBuffer<Reading, 220> put", putNs<220>(), "ns/reading");
+    benchmark::report("RingBuffer<Reading, 256> put", putNs<256>(), "ns/reading");
+}
+
+TEST(RingBufferBenchmark, Iterate)  // NOLINT
+{
+    benchmark::report("RingBuffer<Reading, 220> iterate", iterateNs<220>(), "ns/reading");
+    benchmark::report("RingBuffer<Reading, 256> iterate", iterateNs<256>(), "ns/reading");
+}
+
+TEST(RingBufferBenchmark, BatchInsert)  // NOLINT
+{
+    std::vector<Reading> batch;
+    for (uint32_t idx = 0; idx < batchSize; ++idx)
+    {
+        batch.push_back({21.5F, 40.0F, idx});
+    }
+
+    RingBuffer<Reading, 220> ringBuffer;
+    auto putLoopNs = benchmark::nsPerIteration(passes,
+                                               [&](std::size_t)
+                                               {
+                                                   for (const auto &reading : batch)
+                                                   {
+                                                       ringBuffer.put(reading);
+                                                   }
+                                                   benchmark::doNotOptimize(ringBuffer);
+                                               });
+
+    auto putNNs = benchmark::nsPerIteration(passes,
+                                            [&](std::size_t)
+                                            {
+                                                ringBuffer.putN(batch.data(), batch.size());
+                                                benchmark::doNotOptimize(ringBuffer);
+                                            });
+
+    benchmark::report("RingBuffer<Reading, 220> put x64", putLoopNs / batchSize, "ns/reading");
+    benchmark::report("RingBuffer<Reading, 220> putN(64)", putNNs / batchSize, "ns/reading");
+}
+
+TEST(RingBufferBenchmark, BulkCopy)  // NOLINT
+{
+    RingBuffer<Reading, 220> ringBuffer;
+    for (uint32_t idx = 0; idx < 300; ++idx)
+    {
+        ringBuffer.put({21.5F, 40.0F, idx});
+    }
+    std::array<Reading, 220> output{};
+
+    auto iteratorNs = benchmark::nsPerIteration(passes,
+                                                [&](std::size_t)
+                                                {
+                                                    std::size_t idx = 0;
+                                                    for (const auto &reading : ringBuffer)
+                                                    {
+                                                        output[idx++] = reading;
+                                                    }
+                                                    benchmark::doNotOptimize(output);
+                                                });
+
+    auto spansNs = benchmark::nsPerIteration(passes,
+                                             [&](std::size_t)
+                                             {
+                                                 auto *destination = output.data();
+                                                 for (const auto &span : ringBuffer.spans())
+                                                 {
+                                                     std::memcpy(destination, span.data,
+                                                                 span.size * sizeof(Reading));
+                                                     destination += span.size;
+                                                 }
+                                                 benchmark::doNotOptimize(output);
+                                             });
+
+    benchmark::report("RingBuffer<Reading, 220> copy by iterator", iteratorNs, "ns/buffer");
+    benchmark::report("RingBuffer<Reading, 220> copy by spans", spansNs, "ns/buffer");
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace benchmark
+{
+// Keeps the compiler from optimizing away a computed value, the address escapes so that big
+// objects are not copied into a temporary
+template <typename T>
+void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+template <typename Fun>
+double nsPerIteration(std::size_t iterations, Fun fun)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t idx = 0; idx < iterations; ++idx)
+    {
+        fun(idx);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+
+    return static_cast<double>(elapsedNs) / static_cast<double>(iterations);
+}
+
+inline void report(const char *name, double value, const char *unit)
+{
+    std::printf("\n%-60s %12.2f %s", name, value, unit);
+}
+}  // namespace benchmark
@@ -24,6 +24,20 @@ class ConfStorageMock : public IConfStorage
         return *static_cast<State *>(returnVal);
     }
 
+    void requestSave() override
+    {
+        mock("ConfStorageMock").actualCall("requestSave");
+    }
+
+    State flush() override
+    {
+        static auto defaultState = State::OK;
+        mock("ConfStorageMock").actualCall("flush");
+        auto *returnVal = mock("ConfStorageMock").returnPointerValueOrDefault(&defaultState);
+
+        return *static_cast<State *>(returnVal);
+    }
+
     void setSensorUpdatePeriodMins(uint16_t minutes) override
     {
         mock("ConfStorageMock")
@@ -50,6 +64,20 @@ class ConfStorageMock : public IConfStorage
             .returnUnsignedLongIntValueOrDefault(0);
     }
 
+    void setOutlierThreshold(float threshold) override
+    {
+        mock("ConfStorageMock")
+            .actualCall("setOutlierThreshold")
+            .withDoubleParameter("threshold", threshold);
+    }
+
+    [[nodiscard]] float getOutlierThreshold() const override
+    {
+        return static_cast<float>(mock("ConfStorageMock")
+                                      .actualCall("getOutlierThreshold")
+                                      .returnDoubleValueOrDefault(0));
+    }
+
     void setWifiConfig(const std::string &ssid, const std::string &pass) override
     {
         mock("ConfStorageMock")
@@ -125,6 +153,20 @@ class ConfStorageMock : public IConfStorage
             .returnStringValueOrDefault("");
     }
 
+    [[nodiscard]] uint32_t getConfigVersion() const override
+    {
+        return mock("ConfStorageMock")
+            .actualCall("getConfigVersion")
+            .returnUnsignedIntValueOrDefault(0);
+    }
+
+    [[nodiscard]] uint32_t getSensorsVersion() const override
+    {
+        return mock("ConfStorageMock")
+            .actualCall("getSensorsVersion")
+            .returnUnsignedIntValueOrDefault(0);
+    }
+
     bool isSensorMapped(IDType identifier) override
     {
         return mock("ConfStorageMock")
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <CppUTestExt/MockSupport.h>
+
+#include "adapters/IEspNow32Adp.hpp"
+
+class EspNow32AdpMock : public IEspNow32Adp
+{
+public:
+    [[nodiscard]] Status init() const override
+    {
+        mock("EspNow32AdpMock").actualCall("init");
+        return Status::OK;
+    }
+
+    void deinit() const override
+    {
+        mock("EspNow32AdpMock").actualCall("deinit");
+    }
+
+    void registerOnSendCb(const OnSendCb &onSendCb) override
+    {
+        m_onSendCb = onSendCb;
+    }
+
+    void registerOnRecvCb(const OnRecvCb &onRecvCb) override
+    {
+        m_onRecvCb = onRecvCb;
+    }
+
+    void addPeer(const MacAddr &, uint8_t channel) const override
+    {
+        mock("EspNow32AdpMock").actualCall("addPeer").withParameter("channel", channel);
+    }
+
+    void deletePeer(const MacAddr &) const override
+    {
+        mock("EspNow32AdpMock").actualCall("deletePeer");
+    }
+
+    Status sendData(const MacAddr &, uint8_t *, size_t length) const override
+    {
+        mock("EspNow32AdpMock").actualCall("sendData").withParameter("length", length);
+        return Status::OK;
+    }
+
+    // Testability functions
+
+    void receive(const MacAddr &mac, const uint8_t *data, uint8_t length)
+    {
+        m_onRecvCb(mac, data, length);
+    }
+
+    void sent(const MacAddr &mac, Status status)
+    {
+        m_onSendCb(mac, status);
+    }
+
+private:
+    OnSendCb m_onSendCb;
+    OnRecvCb m_onRecvCb;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "adapters/IMappedRegion.hpp"
+
+// Native counterpart of PartitionMappedRegion, maps a whole file with mmap
+class FileMappedRegion : public IMappedRegion
+{
+public:
+    explicit FileMappedRegion(const std::string &path)
+    {
+        auto descriptor = ::open(path.c_str(), O_RDONLY);  // NOLINT
+        if (descriptor < 0)
+        {
+            return;
+        }
+
+        struct stat status
+        {
+        };
+        if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+        {
+            auto size = static_cast<std::size_t>(status.st_size);
+            auto *mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapped != MAP_FAILED)  // NOLINT
+            {
+                m_data = static_cast<const uint8_t *>(mapped);
+                m_size = size;
+            }
+        }
+        ::close(descriptor);
+    }
+
+    FileMappedRegion(const FileMappedRegion &) = delete;
+    FileMappedRegion(FileMappedRegion &&) noexcept = delete;
+    FileMappedRegion &operator=(const FileMappedRegion &) = delete;
+    FileMappedRegion &operator=(FileMappedRegion &&) noexcept = delete;
+
+    ~FileMappedRegion() override
+    {
+        if (m_data != nullptr)
+        {
+            ::munmap(const_cast<uint8_t *>(m_data), m_size);  // NOLINT
+        }
+    }
+
+    [[nodiscard]] const uint8_t *data() const override
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] std::size_t size() const override
+    {
+        return m_size;
+    }
+
+private:
+    const uint8_t *m_data{nullptr};
+    std::size_t m_size{0};
+};
@@ -2,6 +2,8 @@
 
 #include <CppUTestExt/MockSupport.h>
 
+#include <cstring>
+
 namespace fs
 {
 class File
@@ -18,9 +20,41 @@ public:
         return *static_cast<std::string *>(returnVal);
     }
 
-    void print(const char *data)
+    std::size_t print(const char *data)
+    {
+        return mock("File")
+            .actualCall("print")
+            .withStringParameter("data", data)
+            .returnUnsignedLongIntValueOrDefault(std::strlen(data));
+    }
+
+    std::size_t read(uint8_t *buffer, std::size_t size)
+    {
+        return mock("File")
+            .actualCall("read")
+            .withParameter("size", size)
+            .returnUnsignedLongIntValueOrDefault(0);
+    }
+
+    std::size_t write(const uint8_t *buffer, std::size_t size)
+    {
+        return mock("File")
+            .actualCall("write")
+            .withParameter("size", size)
+            .returnUnsignedLongIntValueOrDefault(size);
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return mock("File").actualCall("size").returnUnsignedLongIntValueOrDefault(0);
+    }
+
+    bool seek(std::size_t position)
     {
-        mock("File").actualCall("print").withStringParameter("data", data);
+        return mock("File")
+            .actualCall("seek")
+            .withParameter("position", position)
+            .returnBoolValueOrDefault(true);
     }
 };
 
@@ -16,4 +16,54 @@ class FileSystem32AdpMock : public IFileSystem32Adp
         auto filePtr = std::unique_ptr<IRaiiFile>(static_cast<IRaiiFile *>(voidPtr));
         return filePtr;
     }
+
+    [[nodiscard]] bool exists(const std::string &path) const override
+    {
+        return mock("FileSystem32AdpMock")
+            .actualCall("exists")
+            .withParameter("path", path.c_str())
+            .returnBoolValueOrDefault(true);
+    }
+
+    bool truncate(const std::string &path, std::size_t size) const override
+    {
+        return mock("FileSystem32AdpMock")
+            .actualCall("truncate")
+            .withParameter("path", path.c_str())
+            .withParameter("size", size)
+            .returnBoolValueOrDefault(true);
+    }
+
+    bool remove(const std::string &path) const override
+    {
+        return mock("FileSystem32AdpMock")
+            .actualCall("remove")
+            .withParameter("path", path.c_str())
+            .returnBoolValueOrDefault(true);
+    }
+
+    bool rename(const std::string &from, const std::string &to) const override
+    {
+        return mock("FileSystem32AdpMock")
+            .actualCall("rename")
+            .withParameter("from", from.c_str())
+            .withParameter("to", to.c_str())
+            .returnBoolValueOrDefault(true);
+    }
+
+    [[nodiscard]] std::size_t freeBytes() const override
+    {
+        constexpr unsigned long defaultFreeBytes = 1024 * 1024;
+        return mock("FileSystem32AdpMock")
+            .actualCall("freeBytes")
+            .returnUnsignedLongIntValueOrDefault(defaultFreeBytes);
+    }
+
+    [[nodiscard]] std::size_t totalBytes() const override
+    {
+        constexpr unsigned long defaultTotalBytes = 1408 * 1024;
+        return mock("FileSystem32AdpMock")
+            .actualCall("totalBytes")
+            .returnUnsignedLongIntValueOrDefault(defaultTotalBytes);
+    }
 };
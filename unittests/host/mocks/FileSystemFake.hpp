@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "adapters/IFileSystem32Adp.hpp"
+
+// In-memory file system, used where tests care about the stored bytes rather than the calls
+class FileSystemFake : public IFileSystem32Adp
+{
+    using Content = std::vector<uint8_t>;
+
+    class RaiiFileFake : public IRaiiFile
+    {
+    public:
+        RaiiFileFake(const FileSystemFake &fileSystem, Content &content, std::size_t position)
+            : m_fileSystem(fileSystem)
+            , m_content(content)
+            , m_position(position)
+        {
+        }
+
+        std::string readString() override
+        {
+            std::string str(m_content.begin() + m_position, m_content.end());
+            m_position = m_content.size();
+            return str;
+        }
+
+        std::size_t print(const std::string &str) override
+        {
+            return write(reinterpret_cast<const uint8_t *>(str.data()), str.size());  // NOLINT
+        }
+
+        std::size_t read(uint8_t *buffer, std::size_t size) override
+        {
+            auto toRead = std::min(size, m_content.size() - m_position);
+            std::copy_n(m_content.begin() + m_position, toRead, buffer);
+            m_position += toRead;
+            return toRead;
+        }
+
+        std::size_t write(const uint8_t *buffer, std::size_t size) override
+        {
+            auto overwritten = std::min(size, m_content.size() - m_position);
+            size = std::min(size, overwritten + m_fileSystem.roomLeft());
+            std::copy_n(buffer, overwritten, m_content.begin() + m_position);
+            m_content.insert(m_content.end(), buffer + overwritten, buffer + size);  // NOLINT
+            m_position += size;
+            return size;
+        }
+
+        [[nodiscard]] std::size_t size() const override
+        {
+            return m_content.size();
+        }
+
+        bool seek(std::size_t position) override
+        {
+            if (position > m_content.size())
+            {
+                return false;
+            }
+            m_position = position;
+            return true;
+        }
+
+    private:
+        const FileSystemFake &m_fileSystem;
+        Content &m_content;
+        std::size_t m_position{0};
+    };
+
+public:
+    [[nodiscard]] std::unique_ptr<IRaiiFile> open(const std::string &path, Mode mode) const override
+    {
+        if (mode == Mode::F_WRITE)
+        {
+            m_files[path].clear();
+        }
+        auto &content = m_files[path];
+        return std::make_unique<RaiiFileFake>(*this, content,
+                                              mode == Mode::F_APPEND ? content.size() : 0);
+    }
+
+    [[nodiscard]] bool exists(const std::string &path) const override
+    {
+        return m_files.find(path) != m_files.end();
+    }
+
+    bool truncate(const std::string &path, std::size_t size) const override
+    {
+        auto file = m_files.find(path);
+        if (file == m_files.end())
+        {
+            return false;
+        }
+        file->second.resize(std::min(size, file->second.size()));
+        return true;
+    }
+
+    bool remove(const std::string &path) const override
+    {
+        return m_files.erase(path) > 0;
+    }
+
+    bool rename(const std::string &from, const std::string &to) const override
+    {
+        auto file = m_files.find(from);
+        if (file == m_files.end())
+        {
+            return false;
+        }
+        m_files[to] = std::move(file->second);
+        m_files.erase(from);
+        return true;
+    }
+
+    [[nodiscard]] std::size_t freeBytes() const override
+    {
+        return roomLeft();
+    }
+
+    [[nodiscard]] std::size_t totalBytes() const override
+    {
+        return m_capacity;
+    }
+
+    // Testability functions
+
+    // Writes which don't fit are cut short, as on a full flash
+    void setCapacity(std::size_t capacity)
+    {
+        m_capacity = capacity;
+    }
+
+    Content &content(const std::string &path)
+    {
+        return m_files[path];
+    }
+
+private:
+    mutable std::map<std::string, Content> m_files;
+    std::size_t m_capacity{std::numeric_limits<std::size_t>::max()};
+
+    [[nodiscard]] std::size_t roomLeft() const
+    {
+        std::size_t used = 0;
+        for (const auto &[path, content] : m_files)
+        {
+            used += content.size();
+        }
+        return m_capacity > used ? m_capacity - used : 0;
+    }
+};
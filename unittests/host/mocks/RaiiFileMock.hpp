@@ -13,8 +13,40 @@ class RaiiFileMock : public IRaiiFile
         return mock("RaiiFileMock").actualCall("readString").returnStringValueOrDefault("");
     };
 
-    void print(const std::string &str) override
+    std::size_t print(const std::string &str) override
     {
-        mock("RaiiFileMock").actualCall("print").withStringParameter("str", str.c_str());
+        return mock("RaiiFileMock")
+            .actualCall("print")
+            .withStringParameter("str", str.c_str())
+            .returnUnsignedLongIntValueOrDefault(str.size());
+    };
+
+    std::size_t read(uint8_t *buffer, std::size_t size) override
+    {
+        return mock("RaiiFileMock")
+            .actualCall("read")
+            .withParameter("size", size)
+            .returnUnsignedLongIntValueOrDefault(0);
+    };
+
+    std::size_t write(const uint8_t *buffer, std::size_t size) override
+    {
+        return mock("RaiiFileMock")
+            .actualCall("write")
+            .withParameter("size", size)
+            .returnUnsignedLongIntValueOrDefault(size);
+    };
+
+    [[nodiscard]] std::size_t size() const override
+    {
+        return mock("RaiiFileMock").actualCall("size").returnUnsignedLongIntValueOrDefault(0);
+    };
+
+    bool seek(std::size_t position) override
+    {
+        return mock("RaiiFileMock")
+            .actualCall("seek")
+            .withParameter("position", position)
+            .returnBoolValueOrDefault(true);
     };
 };
@@ -4,7 +4,9 @@
 
 #include <cinttypes>
 #include <map>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "webserver/IWebRequest.hpp"
 #include "webserver/IWebServer.hpp"
@@ -31,6 +33,34 @@ public:
             .withParameter("content", content);
     }
 
+    void send(int code,
+              const std::string &contentType,
+              const std::shared_ptr<const std::string> &content) override
+    {
+        send(code, contentType, content->c_str());
+    }
+
+    void sendChunked(int code, const std::string &contentType, const Filler &filler) override
+    {
+        mock("WebRequestMock")
+            .actualCall("sendChunked")
+            .withParameter("code", code)
+            .withParameter("contentType", contentType.c_str());
+        m_filler = filler;
+    }
+
+    // Pulls the whole chunked response, chunkSize bytes at a time
+    std::string receiveChunked(std::size_t chunkSize)
+    {
+        std::string received;
+        std::vector<uint8_t> buffer(chunkSize);
+        while (auto len = m_filler(buffer.data(), buffer.size()))
+        {
+            received.append(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(len));
+        }
+        return received;
+    }
+
     void send(int code) override
     {
         mock("WebRequestMock").actualCall("send").withParameter("code", code);
@@ -68,4 +98,28 @@ public:
             return {};
         }
     }
+
+    std::optional<std::string> getHeader(const std::string &name) override
+    {
+        auto *value = mock("WebRequestMock")
+                          .actualCall("getHeader")
+                          .withParameter("name", name.c_str())
+                          .returnPointerValueOrDefault(nullptr);
+        if (value != nullptr)
+        {
+            return *static_cast<std::string *>(value);
+        }
+        return std::nullopt;
+    }
+
+    void addHeader(const std::string &name, const std::string &value) override
+    {
+        mock("WebRequestMock")
+            .actualCall("addHeader")
+            .withParameter("name", name.c_str())
+            .withParameter("value", value.c_str());
+    }
+
+private:
+    Filler m_filler;
 };
@@ -0,0 +1,102 @@
+#include <CppUTest/TestHarness.h>
+
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "ArchiveJsonStream.hpp"
+#include "ReadingsArchive.hpp"
+#include "ReadingsLog.hpp"
+#include "mocks/FileSystemFake.hpp"
+
+namespace
+{
+constexpr unsigned long secondsInDay = 86400;
+constexpr unsigned long dayStart = 19600 * secondsInDay;
+
+std::string receive(ArchiveJsonStream &stream, std::size_t chunkSize)
+{
+    std::string received;
+    std::vector<uint8_t> buffer(chunkSize);
+    while (auto len = stream.fill(buffer.data(), buffer.size()))
+    {
+        received.append(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(len));
+    }
+    return received;
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(ArchiveJsonStreamTest)  // NOLINT
+{
+    std::shared_ptr<FileSystemFake> fileSystem{std::make_shared<FileSystemFake>()};
+    std::shared_ptr<ReadingsLog> log{std::make_shared<ReadingsLog>(fileSystem, "/readings")};
+    ReadingsArchive archive{fileSystem, log, "/archive-"};
+
+    // A reading every 5 minutes for a day and a half, archived once the log segments are closed
+    void archiveReadings()
+    {
+        for (auto epoch = dayStart; epoch < dayStart + 3 * secondsInDay / 2; epoch += 300)
+        {
+            log->append({1, 20.0F + static_cast<float>(epoch % 7) / 10, 40.5, epoch});
+        }
+        for (auto idx = 0; idx < 700; ++idx)
+        {
+            log->append({2, 0.0, 0.0, dayStart + 2 * secondsInDay});
+        }
+        log->flush();
+        while (archive.compact(dayStart + 2 * secondsInDay))
+        {
+        }
+    }
+};
+// clang-format on
+
+TEST(ArchiveJsonStreamTest, archivedReadingsOfRangeAreStreamed)  // NOLINT
+{
+    archiveReadings();
+    ReadingsQuery query{1, ReadingsQuery::Resolution::RAW};
+    query.from = dayStart + 1000;
+    query.to = dayStart + secondsInDay + 1000;
+
+    auto expected = nlohmann::json::array();
+    archive.read(1, query.from.value(), query.to.value(),
+                 [&expected](unsigned long epoch, float temperature, float humidity)
+                 {
+                     auto hundredths = [](float value)
+                     { return static_cast<double>(CompressedBlock::quantize(value)) / 100; };
+                     expected.push_back({epoch, hundredths(temperature), hundredths(humidity)});
+                 });
+    CHECK_EQUAL(288, expected.size());
+
+    for (std::size_t chunkSize : {1, 7, 64, 4096})
+    {
+        ArchiveJsonStream stream(archive, query);
+        auto received = nlohmann::json::parse(receive(stream, chunkSize));
+
+        CHECK_EQUAL(1, received["identifier"].get<IDType>());
+        CHECK_EQUAL(expected.dump(), received["values"].dump());
+    }
+}
+
+TEST(ArchiveJsonStreamTest, valuesAreWrittenInHundredths)  // NOLINT
+{
+    archiveReadings();
+    ReadingsQuery query{1, ReadingsQuery::Resolution::RAW};
+    query.from = dayStart + 300;
+    query.to = dayStart + 300;
+
+    ArchiveJsonStream stream(archive, query);
+
+    auto expected = R"({"identifier":1,"values":[[)" + std::to_string(dayStart + 300)
+                    + R"(,20.6,40.5]]})";
+    CHECK_EQUAL(expected, receive(stream, 64));
+}
+
+TEST(ArchiveJsonStreamTest, emptyArchiveGivesNoValues)  // NOLINT
+{
+    ArchiveJsonStream stream(archive, ReadingsQuery{1, ReadingsQuery::Resolution::RAW});
+
+    CHECK_EQUAL(std::string(R"({"identifier":1,"values":[]})"), receive(stream, 16));
+}
@@ -0,0 +1,98 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cmath>
+#include <vector>
+
+#include "CompressedBlock.hpp"
+
+// clang-format off
+TEST_GROUP(CompressedBlockTest)  // NOLINT
+{
+    std::vector<CompressedBlock::Reading> decodeAll(const CompressedBlock &block)
+    {
+        return {block.begin(), block.end()};
+    }
+};
+// clang-format on
+
+constexpr auto quantizationTolerance = 0.005;
+
+TEST(CompressedBlockTest, EmptyBlockHasNoReadings)  // NOLINT
+{
+    CompressedBlock block;
+
+    CHECK_TRUE(block.empty());
+    CHECK_TRUE(block.begin() == block.end());
+}
+
+TEST(CompressedBlockTest, DecodesWhatWasAppended)  // NOLINT
+{
+    CompressedBlock block;
+    block.append(1000, 21.37, 45.5);
+    block.append(1060, 21.38, 45.4);
+    block.append(1121, 21.38, 45.4);
+    block.append(1500, -5.12, 99.99);
+
+    auto readings = decodeAll(block);
+
+    CHECK_EQUAL(4, readings.size());
+    CHECK_EQUAL(1000, readings[0].epochTime);
+    CHECK_EQUAL(1060, readings[1].epochTime);
+    CHECK_EQUAL(1121, readings[2].epochTime);
+    CHECK_EQUAL(1500, readings[3].epochTime);
+    CHECK_TRUE(std::fabs(readings[0].temperature - 21.37) < quantizationTolerance);
+    CHECK_TRUE(std::fabs(readings[1].humidity - 45.4) < quantizationTolerance);
+    CHECK_TRUE(std::fabs(readings[3].temperature + 5.12) < quantizationTolerance);
+    CHECK_TRUE(std::fabs(readings[3].humidity - 99.99) < quantizationTolerance);
+}
+
+TEST(CompressedBlockTest, HandlesLargeTimeGapsAndValueJumps)  // NOLINT
+{
+    CompressedBlock block;
+    block.append(100, -40.0, 0.0);
+    block.append(100 + 86400 * 30, 80.0, 100.0);
+    block.append(100 + 86400 * 30 + 1, -40.0, 0.0);
+
+    auto readings = decodeAll(block);
+
+    CHECK_EQUAL(3, readings.size());
+    CHECK_EQUAL(100 + 86400 * 30, readings[1].epochTime);
+    CHECK_EQUAL(100 + 86400 * 30 + 1, readings[2].epochTime);
+    CHECK_TRUE(std::fabs(readings[1].temperature - 80.0) < quantizationTolerance);
+    CHECK_TRUE(std::fabs(readings[2].temperature + 40.0) < quantizationTolerance);
+}
+
+TEST(CompressedBlockTest, RefusesReadingWhenBlockIsFull)  // NOLINT
+{
+    CompressedBlock block;
+    uint32_t epoch = 0;
+    float temperature = 0;
+
+    // Alternating big jumps take the longest codes
+    while (block.append(epoch, temperature, temperature))
+    {
+        epoch += 60 + (epoch % 7) * 1000;
+        temperature = temperature == 0 ? 50 : 0;
+    }
+
+    CHECK_TRUE(block.usedBits() <= CompressedBlock::blockBytes * 8);
+    CHECK_EQUAL(block.size(), decodeAll(block).size());
+}
+
+TEST(CompressedBlockTest, SlowlyChangingSeriesFitsSeveralTimesMoreReadings)  // NOLINT
+{
+    CompressedBlock block;
+    uint32_t epoch = 1700000000;
+    auto temperature = 21.5F;
+    auto humidity = 40.0F;
+
+    for (auto idx = 0; block.append(epoch, temperature, humidity); ++idx)
+    {
+        epoch += 60 + idx % 3;
+        temperature += (idx % 5 == 0) ? 0.01F : 0.0F;
+        humidity -= (idx % 7 == 0) ? 0.05F : 0.0F;
+    }
+
+    constexpr auto uncompressedReadingSize = 12;
+    CHECK_TRUE(block.size() * uncompressedReadingSize >= 5 * CompressedBlock::blockBytes);
+}
@@ -281,6 +281,30 @@ TEST(ConfStorageTest, CheckSimpleParameters)
     CHECK_TRUE(confStorage.getServerPort() == 88);
 }
 
+TEST(ConfStorageTest, VersionsChangeWithConfiguration)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "NotImportantInThisTest");
+
+    auto configVersion = confStorage.getConfigVersion();
+    auto sensorsVersion = confStorage.getSensorsVersion();
+
+    confStorage.setServerPort(88);
+    CHECK_TRUE(configVersion != confStorage.getConfigVersion());
+    CHECK_EQUAL(sensorsVersion, confStorage.getSensorsVersion());
+
+    configVersion = confStorage.getConfigVersion();
+    CHECK_TRUE(confStorage.addSensor(123, "sensor"));
+    CHECK_TRUE(configVersion != confStorage.getConfigVersion());
+    CHECK_TRUE(sensorsVersion != confStorage.getSensorsVersion());
+
+    configVersion = confStorage.getConfigVersion();
+    sensorsVersion = confStorage.getSensorsVersion();
+    CHECK_FALSE(confStorage.removeSensor(456));
+    CHECK_EQUAL(configVersion, confStorage.getConfigVersion());
+    CHECK_EQUAL(sensorsVersion, confStorage.getSensorsVersion());
+}
+
 TEST(ConfStorageTest, ShouldReturnConfigWithoutCredentials)
 {
     auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
@@ -294,8 +318,132 @@ TEST(ConfStorageTest, ShouldReturnConfigWithoutCredentials)
         {"sensors", {}},
         {"serverPort", 80},
         {"sensorUpdatePeriodMins", 1},
+        {"outlierThreshold", 3.0},
     };
 
     auto configWithoutCred = confStorage.getConfigWithoutCredentials();
     CHECK_TRUE(expected.dump() == configWithoutCred);
 }
+
+TEST(ConfStorageTest, RequestedSavesAreWrittenOnceOnUpdate)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "/config.json");
+    auto file = std::make_unique<RaiiFileMock>();
+
+    confStorage.addSensor(1, "first");
+    confStorage.requestSave();
+    confStorage.addSensor(2, "second");
+    confStorage.requestSave();
+    mock().checkExpectations();
+
+    std::string expectedFileContent
+        = R"({"admin":{"pass":"admin","user":"admin"},"sensorUpdatePeriodMins":1,)"
+          R"("sensors":{"1":"first","2":"second"},"serverPort":80})";
+    mock("RaiiFileMock").expectOneCall("print").withParameter("str", expectedFileContent.c_str());
+    mock("FileSystem32AdpMock")
+        .expectOneCall("open")
+        .withStringParameter("path", "/config.json")
+        .withParameter("mode", static_cast<int>(IFileSystem32Adp::Mode::F_WRITE))
+        .andReturnValue(file.release());
+
+    confStorage.update();
+    confStorage.update();
+}
+
+TEST(ConfStorageTest, RequestedSaveKeepsConfigurationFromTheTimeOfRequest)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "/config.json");
+    auto file = std::make_unique<RaiiFileMock>();
+
+    confStorage.setServerPort(8080);
+    confStorage.requestSave();
+    confStorage.setServerPort(9090);
+
+    std::string expectedFileContent
+        = R"({"admin":{"pass":"admin","user":"admin"},"sensorUpdatePeriodMins":1,)"
+          R"("sensors":null,"serverPort":8080})";
+    mock("RaiiFileMock").expectOneCall("print").withParameter("str", expectedFileContent.c_str());
+    mock("FileSystem32AdpMock").expectOneCall("open").ignoreOtherParameters().andReturnValue(
+        file.release());
+
+    CHECK_TRUE(ConfStorage::State::OK == confStorage.flush());
+}
+
+TEST(ConfStorageTest, FlushWithoutRequestedSaveDoesNotTouchFlash)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "/config.json");
+
+    mock("FileSystem32AdpMock").expectNoCall("open");
+
+    CHECK_TRUE(ConfStorage::State::OK == confStorage.flush());
+    confStorage.update();
+}
+
+TEST(ConfStorageTest, SaveSupersedesRequestedSave)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "/config.json");
+    auto file = std::make_unique<RaiiFileMock>();
+
+    confStorage.requestSave();
+
+    mock("RaiiFileMock").expectOneCall("print").ignoreOtherParameters();
+    mock("FileSystem32AdpMock").expectOneCall("open").ignoreOtherParameters().andReturnValue(
+        file.release());
+
+    confStorage.save();
+    confStorage.update();
+}
+
+TEST(ConfStorageTest, OutlierThresholdHasDefaultWhenMissingInConfiguration)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "NotImportantInThisTest");
+
+    CHECK_EQUAL(3.0, confStorage.getOutlierThreshold());
+    confStorage.setOutlierThreshold(0);
+    CHECK_EQUAL(0.0, confStorage.getOutlierThreshold());
+}
+
+TEST(ConfStorageTest, RequestedSaveIsRetriedWhenFileCantBeOpened)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "/config.json");
+    auto file = std::make_unique<RaiiFileMock>();
+
+    confStorage.requestSave();
+
+    mock("FileSystem32AdpMock").expectOneCall("open").ignoreOtherParameters().andReturnValue(
+        static_cast<void *>(nullptr));
+    CHECK_TRUE(ConfStorage::State::FAIL == confStorage.flush());
+    mock().checkExpectations();
+
+    mock("RaiiFileMock").expectOneCall("print").ignoreOtherParameters();
+    mock("FileSystem32AdpMock").expectOneCall("open").ignoreOtherParameters().andReturnValue(
+        file.release());
+    confStorage.update();
+}
+
+TEST(ConfStorageTest, PartiallyWrittenSaveFailsAndIsRetried)  // NOLINT
+{
+    auto fileSystemMock = std::make_shared<FileSystem32AdpMock>();
+    ConfStorage confStorage(fileSystemMock, "/config.json");
+    auto firstFile = std::make_unique<RaiiFileMock>();
+    auto secondFile = std::make_unique<RaiiFileMock>();
+
+    confStorage.requestSave();
+
+    mock("RaiiFileMock").expectOneCall("print").ignoreOtherParameters().andReturnValue(10UL);
+    mock("FileSystem32AdpMock").expectOneCall("open").ignoreOtherParameters().andReturnValue(
+        firstFile.release());
+    CHECK_TRUE(ConfStorage::State::FAIL == confStorage.flush());
+    mock().checkExpectations();
+
+    mock("RaiiFileMock").expectOneCall("print").ignoreOtherParameters();
+    mock("FileSystem32AdpMock").expectOneCall("open").ignoreOtherParameters().andReturnValue(
+        secondFile.release());
+    CHECK_TRUE(ConfStorage::State::OK == confStorage.flush());
+}
@@ -0,0 +1,85 @@
+#include <CppUTest/TestHarness.h>
+
+#include <vector>
+
+#include "DailyQuantiles.hpp"
+
+// clang-format off
+TEST_GROUP(DailyQuantilesTest)  // NOLINT
+{
+};
+// clang-format on
+
+namespace
+{
+constexpr uint32_t day = DailyQuantiles<1>::secondsPerDay;
+
+template <uint16_t daysNum>
+std::vector<QuantilesDay> daysOf(const DailyQuantiles<daysNum> &quantiles)
+{
+    std::vector<QuantilesDay> days;
+    quantiles.forEach([&days](const QuantilesDay &quantilesDay) { days.push_back(quantilesDay); });
+    return days;
+}
+}  // namespace
+
+TEST(DailyQuantilesTest, NoDaysWithoutReadings)  // NOLINT
+{
+    DailyQuantiles<3> quantiles;
+
+    CHECK_TRUE(daysOf(quantiles).empty());
+}
+
+TEST(DailyQuantilesTest, DayInProgressIsReported)  // NOLINT
+{
+    DailyQuantiles<3> quantiles;
+    quantiles.add(20.0, 40.0, day + 100);
+    quantiles.add(22.0, 50.0, day + 200);
+    quantiles.add(24.5, 60.0, day + 300);
+
+    auto days = daysOf(quantiles);
+
+    CHECK_EQUAL(1, days.size());
+    CHECK_EQUAL(day, days[0].startEpoch);
+    CHECK_EQUAL(3, days[0].count);
+    CHECK_EQUAL(2000, days[0].temperature.p5);
+    CHECK_EQUAL(2200, days[0].temperature.p50);
+    CHECK_EQUAL(2450, days[0].temperature.p95);
+    CHECK_EQUAL(4000, days[0].humidity.p5);
+    CHECK_EQUAL(5000, days[0].humidity.p50);
+    CHECK_EQUAL(6000, days[0].humidity.p95);
+}
+
+TEST(DailyQuantilesTest, DaysRollOverAtMidnight)  // NOLINT
+{
+    DailyQuantiles<3> quantiles;
+    quantiles.add(20.0, 40.0, day - 1);
+    quantiles.add(-5.0, 90.0, day);
+    quantiles.add(-7.0, 95.0, day + 1);
+
+    auto days = daysOf(quantiles);
+
+    CHECK_EQUAL(2, days.size());
+    CHECK_EQUAL(0, days[0].startEpoch);
+    CHECK_EQUAL(1, days[0].count);
+    CHECK_EQUAL(2000, days[0].temperature.p50);
+    CHECK_EQUAL(day, days[1].startEpoch);
+    CHECK_EQUAL(2, days[1].count);
+    CHECK_EQUAL(-700, days[1].temperature.p5);
+}
+
+TEST(DailyQuantilesTest, OldestDaysAreDropped)  // NOLINT
+{
+    DailyQuantiles<2> quantiles;
+    for (uint32_t idx = 0; idx < 5; ++idx)
+    {
+        quantiles.add(static_cast<float>(idx), 50.0, idx * day);
+    }
+
+    auto days = daysOf(quantiles);
+
+    // Two finished days and the one in progress
+    CHECK_EQUAL(3, days.size());
+    CHECK_EQUAL(2 * day, days[0].startEpoch);
+    CHECK_EQUAL(4 * day, days[2].startEpoch);
+}
@@ -70,11 +70,48 @@ TEST(EspNowPairingManagerTest, AddSensorToStorageWhenItPossibe)  // NOLINT
         .expectOneCall("addSensor")
         .withParameter("identifier", 123)
         .ignoreOtherParameters();
+    mock("ConfStorageMock").expectNoCall("requestSave");
+    mock("ConfStorageMock").expectNoCall("save");
     mock().ignoreOtherCalls();
 
     espNowPairingManager.addNewSensorToStorage(123);
 }
 
+TEST(EspNowPairingManagerTest, SensorsPairedInOneWindowAreSavedOnceWhenItCloses)  // NOLINT
+{
+    auto confStorageMock = std::make_shared<ConfStorageMock>();
+    auto arduino32AdpMock = std::make_shared<Arduino32AdpMock>();
+
+    EspNowPairingManager espNowPairingManager(confStorageMock, arduino32AdpMock, nullptr);
+    constexpr auto pairingTimeoutMilis = 10;
+
+    mock("Arduino32Adp").expectOneCall("millis").andReturnValue(0);
+    espNowPairingManager.enablePairingForPeriod(pairingTimeoutMilis);
+
+    mock("ConfStorageMock").expectNCalls(3, "addSensor").ignoreOtherParameters();
+    mock("ConfStorageMock").expectNCalls(3, "isAvailableSpaceForNextSensor");
+    for (IDType identifier = 1; identifier <= 3; ++identifier)
+    {
+        mock("ConfStorageMock")
+            .expectOneCall("isSensorMapped")
+            .withParameter("identifier", identifier)
+            .andReturnValue(false);
+        espNowPairingManager.addNewSensorToStorage(identifier);
+    }
+
+    mock("Arduino32Adp").expectOneCall("millis").andReturnValue(5);
+    espNowPairingManager.update();
+    mock().checkExpectations();
+
+    mock("Arduino32Adp").expectOneCall("millis").andReturnValue(15);
+    mock("ConfStorageMock").expectOneCall("requestSave");
+    espNowPairingManager.update();
+    CHECK_FALSE(espNowPairingManager.isPairingEnabled());
+
+    mock("ConfStorageMock").expectNoCall("requestSave");
+    espNowPairingManager.update();
+}
+
 TEST(EspNowPairingManagerTest, NotAddSensorToStorageWhenSensorIsAlreadyMapped)  // NOLINT
 {
     auto confStorageMock = std::make_shared<ConfStorageMock>();
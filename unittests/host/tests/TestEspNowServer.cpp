@@ -0,0 +1,356 @@
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+#include <memory>
+#include <vector>
+
+#include "EspNowServer.hpp"
+#include "mocks/Arduino32AdpMock.hpp"
+#include "mocks/ConfStorageMock.hpp"
+#include "mocks/EspNow32AdpMock.hpp"
+#include "mocks/Wifi32AdpMock.hpp"
+
+namespace
+{
+struct Reading
+{
+    float temperature;
+    float humidity;
+    IDType identifier;
+};
+}  // namespace
+
+// clang-format off
+TEST_GROUP(EspNowServerTest)  // NOLINT
+{
+    void setup() override
+    {
+        mock().ignoreOtherCalls();
+        espNowServer.init([this](float temp, float hum, IDType identifier)
+                          { readings.push_back({temp, hum, identifier}); });
+    }
+
+    void teardown() override
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+
+    void receiveReading(IDType identifier, float temperature, float humidity,
+                        const MacAddr &mac = MacAddr{})
+    {
+        auto buffer = SensorDataMsg::create(identifier, temperature, humidity).serialize();
+        espNowAdp->receive(mac, buffer.data(), buffer.size());
+    }
+
+    void receivePairRequest(IDType identifier, const MacAddr &mac)
+    {
+        auto pairReqMsg = PairReqMsg::create();
+        pairReqMsg.ID = identifier;
+        auto buffer = pairReqMsg.serialize();
+        espNowAdp->receive(mac, buffer.data(), buffer.size());
+    }
+
+    void expectUpdatePeriodMins(unsigned updatesNum, unsigned long minutes)
+    {
+        mock("ConfStorageMock")
+            .expectNCalls(updatesNum, "getSensorUpdatePeriodMins")
+            .andReturnValue(minutes);
+    }
+
+    void expectMillis(int millis, unsigned callsNum = 1)
+    {
+        mock("Arduino32Adp").expectNCalls(callsNum, "millis").andReturnValue(millis);
+    }
+
+    std::shared_ptr<ConfStorageMock> confStorage{std::make_shared<ConfStorageMock>()};
+    EspNow32AdpMock *espNowAdp{new EspNow32AdpMock()};
+    std::shared_ptr<Arduino32AdpMock> arduinoAdp{std::make_shared<Arduino32AdpMock>()};
+    std::shared_ptr<EspNowPairingManager> pairingManager{
+        std::make_shared<EspNowPairingManager>(confStorage, arduinoAdp)};
+    EspNowServer espNowServer{std::unique_ptr<EspNow32AdpMock>(espNowAdp), pairingManager,
+                              std::make_shared<Wifi32AdpMock>(), confStorage, arduinoAdp};
+    std::vector<Reading> readings;
+};
+// clang-format on
+
+TEST(EspNowServerTest, ReceivedFramesAreProcessedOnUpdate)  // NOLINT
+{
+    receiveReading(7, 21.5, 40.5);
+    CHECK_TRUE(readings.empty());
+
+    espNowServer.update();
+
+    CHECK_EQUAL(1, readings.size());
+    CHECK_EQUAL(7, readings[0].identifier);
+    CHECK_EQUAL(21.5, readings[0].temperature);
+    CHECK_EQUAL(40.5, readings[0].humidity);
+}
+
+TEST(EspNowServerTest, FramesAreProcessedInBatchesInArrivalOrder)  // NOLINT
+{
+    for (IDType identifier = 1; identifier <= 10; ++identifier)
+    {
+        receiveReading(identifier, 20.0, 50.0);
+    }
+
+    espNowServer.update();
+    CHECK_EQUAL(8, readings.size());
+    espNowServer.update();
+    CHECK_EQUAL(10, readings.size());
+
+    for (std::size_t idx = 0; idx < readings.size(); ++idx)
+    {
+        CHECK_EQUAL(idx + 1, readings[idx].identifier);
+    }
+}
+
+TEST(EspNowServerTest, FramesAreDroppedAndCountedWhenQueueIsFull)  // NOLINT
+{
+    for (IDType identifier = 1; identifier <= 20; ++identifier)
+    {
+        receiveReading(identifier, 20.0, 50.0);
+    }
+
+    auto stats = espNowServer.ingestStats();
+    CHECK_EQUAL(20, stats.received);
+    CHECK_EQUAL(4, stats.dropped);
+
+    espNowServer.update();
+    espNowServer.update();
+    CHECK_EQUAL(16, readings.size());
+    CHECK_EQUAL(16, readings.back().identifier);
+}
+
+TEST(EspNowServerTest, OversizedFramesAreCountedAndIgnored)  // NOLINT
+{
+    std::vector<uint8_t> frame(200, 0);
+    espNowAdp->receive(MacAddr{}, frame.data(), frame.size());
+    espNowServer.update();
+
+    CHECK_TRUE(readings.empty());
+    CHECK_EQUAL(1, espNowServer.ingestStats().oversized);
+    CHECK_EQUAL(0, espNowServer.ingestStats().dropped);
+}
+
+TEST(EspNowServerTest, FloodFromOneSenderIsThrottled)  // NOLINT
+{
+    constexpr MacAddr flooding{{1, 2, 3, 4, 5, 6}};
+    constexpr MacAddr regular{{1, 2, 3, 4, 5, 7}};
+    expectUpdatePeriodMins(3, 10);
+    espNowServer.update();
+    for (int idx = 0; idx < 9; ++idx)
+    {
+        receiveReading(1, 20.0, 50.0, flooding);
+    }
+    receiveReading(2, 20.0, 50.0, regular);
+
+    espNowServer.update();
+    espNowServer.update();
+
+    CHECK_EQUAL(5, readings.size());
+    CHECK_EQUAL(2, readings.back().identifier);
+    CHECK_EQUAL(5, espNowServer.throttledFrames(flooding));
+    CHECK_EQUAL(0, espNowServer.throttledFrames(regular));
+    CHECK_EQUAL(5, espNowServer.ingestStats().throttled);
+}
+
+TEST(EspNowServerTest, ThrottledFramesDoNotTakePlacesInQueue)  // NOLINT
+{
+    constexpr MacAddr flooding{{1, 2, 3, 4, 5, 6}};
+    expectUpdatePeriodMins(3, 10);
+    espNowServer.update();
+    for (int idx = 0; idx < 30; ++idx)
+    {
+        receiveReading(1, 20.0, 50.0, flooding);
+    }
+    for (uint8_t idx = 1; idx <= 10; ++idx)
+    {
+        receiveReading(idx + 1, 20.0, 50.0, MacAddr{{1, 2, 3, 4, 6, idx}});
+    }
+
+    espNowServer.update();
+    espNowServer.update();
+
+    CHECK_EQUAL(0, espNowServer.ingestStats().dropped);
+    CHECK_EQUAL(26, espNowServer.ingestStats().throttled);
+    CHECK_EQUAL(14, readings.size());
+    CHECK_EQUAL(11, readings.back().identifier);
+}
+
+TEST(EspNowServerTest, ThrottledSenderRegainsFramesOverTime)  // NOLINT
+{
+    constexpr MacAddr sender{{1, 2, 3, 4, 5, 6}};
+    constexpr int halfPeriodMs = 5 * 60 * 1000;
+    expectUpdatePeriodMins(3, 10);
+    espNowServer.update();
+
+    // Taken for every received frame and once by the update processing them
+    expectMillis(1000, 6);
+    for (int idx = 0; idx < 5; ++idx)
+    {
+        receiveReading(1, 20.0, 50.0, sender);
+    }
+    espNowServer.update();
+    CHECK_EQUAL(4, readings.size());
+
+    expectMillis(1000 + halfPeriodMs, 3);
+    receiveReading(1, 20.0, 50.0, sender);
+    receiveReading(1, 20.0, 50.0, sender);
+    espNowServer.update();
+
+    CHECK_EQUAL(5, readings.size());
+    CHECK_EQUAL(2, espNowServer.throttledFrames(sender));
+}
+
+TEST(EspNowServerTest, LongerPeriodDoesNotThrottleSensorsPairedBefore)  // NOLINT
+{
+    constexpr MacAddr sender{{1, 2, 3, 4, 5, 6}};
+    constexpr int periodMs = 60 * 1000;
+    expectUpdatePeriodMins(2, 1);
+    espNowServer.update();
+    expectMillis(1000, 2);
+    receiveReading(1, 20.0, 50.0, sender);
+    espNowServer.update();
+
+    // Raised in the configuration, the sensor keeps sending every minute
+    expectUpdatePeriodMins(6, 10);
+    for (int idx = 1; idx <= 6; ++idx)
+    {
+        expectMillis(1000 + idx * periodMs, 2);
+        receiveReading(1, 20.0, 50.0, sender);
+        espNowServer.update();
+    }
+
+    CHECK_EQUAL(7, readings.size());
+    CHECK_EQUAL(0, espNowServer.throttledFrames(sender));
+}
+
+TEST(EspNowServerTest, NoThrottlingWithoutUpdatePeriod)  // NOLINT
+{
+    expectUpdatePeriodMins(3, 0);
+    espNowServer.update();
+    for (int idx = 0; idx < 12; ++idx)
+    {
+        receiveReading(1, 20.0, 50.0);
+    }
+
+    espNowServer.update();
+    espNowServer.update();
+
+    CHECK_EQUAL(12, readings.size());
+    CHECK_EQUAL(0, espNowServer.ingestStats().throttled);
+}
+
+namespace
+{
+MacAddr transmitterMac(uint8_t idx)
+{
+    return MacAddr{{0xA0, 0xB0, 0xC0, 0xD0, 0xE0, idx}};
+}
+}  // namespace
+
+TEST(EspNowServerTest, PairRequestIsAnsweredAndPeerRemovedOnDelivery)  // NOLINT
+{
+    pairingManager->enablePairingForPeriod();
+    receivePairRequest(5, transmitterMac(1));
+
+    mock("EspNow32AdpMock").expectOneCall("addPeer").ignoreOtherParameters();
+    mock("EspNow32AdpMock").expectOneCall("sendData").ignoreOtherParameters();
+    espNowServer.update();
+    mock().checkExpectations();
+
+    mock("EspNow32AdpMock").expectOneCall("deletePeer");
+    espNowAdp->sent(transmitterMac(1), IEspNow32Adp::Status::OK);
+    espNowServer.update();
+}
+
+TEST(EspNowServerTest, UndeliveredPairResponseIsRetransmitted)  // NOLINT
+{
+    pairingManager->enablePairingForPeriod();
+    receivePairRequest(5, transmitterMac(1));
+
+    mock("EspNow32AdpMock").expectOneCall("addPeer").ignoreOtherParameters();
+    mock("EspNow32AdpMock").expectNCalls(2, "sendData").ignoreOtherParameters();
+    expectMillis(0);
+    espNowServer.update();
+
+    espNowAdp->sent(transmitterMac(1), IEspNow32Adp::Status::FAIL);
+    expectMillis(10);
+    espNowServer.update();
+    expectMillis(30);
+    espNowServer.update();
+    mock().checkExpectations();
+
+    mock("EspNow32AdpMock").expectOneCall("deletePeer");
+    espNowAdp->sent(transmitterMac(1), IEspNow32Adp::Status::OK);
+    expectMillis(40);
+    espNowServer.update();
+}
+
+TEST(EspNowServerTest, LateStatusOfTimedOutAttemptIsNotTakenForRetry)  // NOLINT
+{
+    pairingManager->enablePairingForPeriod();
+    receivePairRequest(5, transmitterMac(1));
+
+    mock("EspNow32AdpMock").expectNCalls(2, "sendData").ignoreOtherParameters();
+    for (int millis : {0, 100, 120})
+    {
+        expectMillis(millis);
+        espNowServer.update();
+    }
+
+    // Delivery of the first attempt says nothing about the retry
+    espNowAdp->sent(transmitterMac(1), IEspNow32Adp::Status::OK);
+    expectMillis(130);
+    espNowServer.update();
+    mock().checkExpectations();
+
+    mock("EspNow32AdpMock").expectOneCall("deletePeer");
+    espNowAdp->sent(transmitterMac(1), IEspNow32Adp::Status::OK);
+    expectMillis(140);
+    espNowServer.update();
+}
+
+TEST(EspNowServerTest, HandshakeWithoutDeliveryIsGivenUp)  // NOLINT
+{
+    pairingManager->enablePairingForPeriod();
+    receivePairRequest(5, transmitterMac(1));
+
+    mock("EspNow32AdpMock").expectNCalls(2, "sendData").ignoreOtherParameters();
+    mock("EspNow32AdpMock").expectOneCall("deletePeer");
+    for (int millis : {0, 100, 120, 500})
+    {
+        expectMillis(millis);
+        espNowServer.update();
+    }
+}
+
+TEST(EspNowServerTest, FewHandshakesAreInFlightAtOnce)  // NOLINT
+{
+    pairingManager->enablePairingForPeriod();
+    for (uint8_t idx = 1; idx <= 6; ++idx)
+    {
+        receivePairRequest(idx, transmitterMac(idx));
+    }
+
+    mock("EspNow32AdpMock").expectNCalls(4, "sendData").ignoreOtherParameters();
+    espNowServer.update();
+    mock().checkExpectations();
+
+    mock("EspNow32AdpMock").expectNCalls(2, "deletePeer");
+    mock("EspNow32AdpMock").expectNCalls(2, "sendData").ignoreOtherParameters();
+    espNowAdp->sent(transmitterMac(1), IEspNow32Adp::Status::OK);
+    espNowAdp->sent(transmitterMac(2), IEspNow32Adp::Status::OK);
+    espNowServer.update();
+}
+
+TEST(EspNowServerTest, RepeatedPairRequestDoesNotStartAnotherHandshake)  // NOLINT
+{
+    pairingManager->enablePairingForPeriod();
+    receivePairRequest(5, transmitterMac(1));
+    receivePairRequest(5, transmitterMac(1));
+
+    mock("EspNow32AdpMock").expectOneCall("sendData").ignoreOtherParameters();
+    espNowServer.update();
+}
@@ -0,0 +1,78 @@
+#include <CppUTest/TestHarness.h>
+
+#include "HampelFilter.hpp"
+
+namespace
+{
+constexpr float threshold = 3.0F;
+constexpr float minDeviation = 0.5F;
+}  // namespace
+
+// clang-format off
+TEST_GROUP(HampelFilterTest)  // NOLINT
+{
+    // Temperature wobbling by a few hundredths around 21 degrees
+    void fillWindow()
+    {
+        for (auto idx = 0; idx < 7; ++idx)
+        {
+            CHECK_FALSE(filter.check(21.0F + static_cast<float>(idx % 3) * 0.04F, threshold,
+                                     minDeviation));
+        }
+    }
+
+    HampelFilter<7> filter;
+};
+// clang-format on
+
+TEST(HampelFilterTest, NothingIsFlaggedUntilWindowIsFull)  // NOLINT
+{
+    for (auto value : {21.0F, 35.0F, 21.0F, -10.0F, 21.0F, 21.0F, 60.0F})
+    {
+        CHECK_FALSE(filter.check(value, threshold, minDeviation));
+    }
+}
+
+TEST(HampelFilterTest, SpikeIsFlagged)  // NOLINT
+{
+    fillWindow();
+
+    CHECK_TRUE(filter.check(29.5F, threshold, minDeviation));
+    CHECK_FALSE(filter.check(21.02F, threshold, minDeviation));
+}
+
+TEST(HampelFilterTest, ChangesWithinMinDeviationPassFlatSignal)  // NOLINT
+{
+    for (auto idx = 0; idx < 7; ++idx)
+    {
+        filter.check(21.0F, threshold, minDeviation);
+    }
+
+    CHECK_FALSE(filter.check(21.4F, threshold, minDeviation));
+    CHECK_TRUE(filter.check(21.6F, threshold, minDeviation));
+}
+
+TEST(HampelFilterTest, DeviationIsScaledByNoiseOfWindow)  // NOLINT
+{
+    // Median 21 and MAD 1, three sigmas are about 4.45 degrees
+    for (auto value : {19.0F, 20.0F, 21.0F, 22.0F, 23.0F, 21.0F, 20.0F})
+    {
+        filter.check(value, threshold, minDeviation);
+    }
+
+    CHECK_FALSE(filter.check(25.0F, threshold, minDeviation));
+    CHECK_TRUE(filter.check(26.5F, threshold, minDeviation));
+}
+
+TEST(HampelFilterTest, LastingStepStopsBeingFlagged)  // NOLINT
+{
+    fillWindow();
+
+    auto flagged = 0;
+    for (auto idx = 0; idx < 7; ++idx)
+    {
+        flagged += filter.check(26.0F, threshold, minDeviation) ? 1 : 0;
+    }
+
+    CHECK_EQUAL(4, flagged);
+}
@@ -0,0 +1,67 @@
+#include <CppUTest/TestHarness.h>
+
+#include "HourOfDayHistogram.hpp"
+
+// clang-format off
+TEST_GROUP(HourOfDayHistogramTest)  // NOLINT
+{
+};
+// clang-format on
+
+namespace
+{
+constexpr unsigned long hour = 60 * 60;
+constexpr unsigned long day = 24 * hour;
+}  // namespace
+
+TEST(HourOfDayHistogramTest, EmptyWithoutReadings)  // NOLINT
+{
+    HourOfDayHistogram<0, 10, 10> histogram;
+
+    for (auto count : histogram.counts())
+    {
+        CHECK_EQUAL(0, count);
+    }
+}
+
+TEST(HourOfDayHistogramTest, SameHourOfDifferentDaysIsCountedTogether)  // NOLINT
+{
+    HourOfDayHistogram<0, 10, 10> histogram;
+    histogram.add(15.0, 5 * hour);
+    histogram.add(19.9, day + 5 * hour + 3599);
+    histogram.add(20.0, 2 * day + 5 * hour);
+    histogram.add(15.0, 6 * hour);
+
+    CHECK_EQUAL(2, histogram.at(5, 1));
+    CHECK_EQUAL(1, histogram.at(5, 2));
+    CHECK_EQUAL(1, histogram.at(6, 1));
+}
+
+TEST(HourOfDayHistogramTest, OutOfRangeValuesGoToEdgeBins)  // NOLINT
+{
+    HourOfDayHistogram<-10, 2, 25> histogram;
+    histogram.add(-40.0, 0);
+    histogram.add(-10.0, 0);
+    histogram.add(40.0, 0);
+    histogram.add(85.0, 0);
+
+    CHECK_EQUAL(2, histogram.at(0, 0));
+    CHECK_EQUAL(2, histogram.at(0, 24));
+}
+
+TEST(HourOfDayHistogramTest, CountsAreHalvedInsteadOfOverflowing)  // NOLINT
+{
+    constexpr unsigned maxCount = 0xFFFF;
+    HourOfDayHistogram<0, 10, 2> histogram;
+    histogram.add(15.0, hour);
+    for (unsigned idx = 0; idx < maxCount; ++idx)
+    {
+        histogram.add(5.0, 0);
+    }
+    CHECK_EQUAL(maxCount, histogram.at(0, 0));
+
+    histogram.add(5.0, 0);
+
+    CHECK_EQUAL(maxCount / 2 + 1, histogram.at(0, 0));
+    CHECK_EQUAL(0, histogram.at(1, 1));
+}
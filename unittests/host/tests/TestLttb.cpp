@@ -0,0 +1,64 @@
+#include <CppUTest/TestHarness.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "Lttb.hpp"
+
+// clang-format off
+TEST_GROUP(LttbTest)  // NOLINT
+{
+    std::vector<std::size_t> select(const std::vector<double> &values, std::size_t threshold)
+    {
+        return lttb::select(
+            values.size(), threshold, [](std::size_t idx) { return idx; },
+            [&values](std::size_t idx) { return std::array<double, 1>{values[idx]}; });
+    }
+};
+// clang-format on
+
+TEST(LttbTest, KeepsAllPointsBelowThreshold)  // NOLINT
+{
+    CHECK_TRUE((std::vector<std::size_t>{0, 1, 2}) == select({1, 2, 3}, 3));
+    CHECK_TRUE((std::vector<std::size_t>{0, 1, 2}) == select({1, 2, 3}, 10));
+}
+
+TEST(LttbTest, KeepsFirstAndLastPointsForTinyThresholds)  // NOLINT
+{
+    std::vector<double> values{1, 5, 2, 8, 3};
+
+    CHECK_TRUE((std::vector<std::size_t>{0, 4}) == select(values, 2));
+    CHECK_TRUE((std::vector<std::size_t>{4}) == select(values, 1));
+}
+
+TEST(LttbTest, ReturnsExactlyThresholdPointsInOrder)  // NOLINT
+{
+    std::vector<double> values;
+    for (auto idx = 0; idx < 1000; ++idx)
+    {
+        values.push_back(idx % 17);
+    }
+
+    auto selected = select(values, 50);
+
+    CHECK_EQUAL(50, selected.size());
+    CHECK_EQUAL(0, selected.front());
+    CHECK_EQUAL(999, selected.back());
+    for (std::size_t idx = 1; idx < selected.size(); ++idx)
+    {
+        CHECK_TRUE(selected[idx - 1] < selected[idx]);
+    }
+}
+
+TEST(LttbTest, KeepsSpikes)  // NOLINT
+{
+    std::vector<double> values(100, 20.0);
+    values[37] = 35.0;
+    values[71] = 5.0;
+
+    auto selected = select(values, 10);
+
+    CHECK_TRUE(std::find(selected.begin(), selected.end(), 37) != selected.end());
+    CHECK_TRUE(std::find(selected.begin(), selected.end(), 71) != selected.end());
+}
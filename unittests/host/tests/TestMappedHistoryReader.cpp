@@ -0,0 +1,177 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "MappedHistoryReader.hpp"
+#include "ReadingsArchive.hpp"
+#include "ReadingsLog.hpp"
+#include "mocks/FileMappedRegion.hpp"
+#include "mocks/FileSystemFake.hpp"
+
+namespace
+{
+constexpr unsigned long secondsInDay = 86400;
+constexpr unsigned long firstDay = 19600;
+constexpr unsigned long dayStart = firstDay * secondsInDay;
+constexpr unsigned long daysNum = 2;
+constexpr unsigned long period = 300;
+// More than a segment of the readings log holds
+constexpr unsigned long recordsToCloseSegment = 700;
+
+struct Reading
+{
+    unsigned long epochTime;
+    float temperature;
+    float humidity;
+};
+
+std::string dayPath(unsigned long day)
+{
+    return "/archive-d" + std::to_string(day) + ".bin";
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(MappedHistoryReaderTest)  // NOLINT
+{
+    void setup() override
+    {
+        for (unsigned long day = 0; day < daysNum; ++day)
+        {
+            auto start = dayStart + day * secondsInDay;
+            for (auto epoch = start; epoch < start + secondsInDay; epoch += period)
+            {
+                for (IDType identifier = 1; identifier <= 3; ++identifier)
+                {
+                    log->append({identifier, static_cast<float>(epoch % 4000) / 100.0F,
+                                 50.0F + static_cast<float>(identifier), epoch + identifier});
+                }
+            }
+            compactAll(start + secondsInDay);
+        }
+        for (unsigned long idx = 0; idx < recordsToCloseSegment; ++idx)
+        {
+            log->append({4, 0.0, 0.0, dayStart + daysNum * secondsInDay});
+        }
+        log->flush();
+        compactAll(dayStart + daysNum * secondsInDay);
+
+        // Day files are written one after another, the oldest first
+        for (unsigned long day = 0; day < daysNum; ++day)
+        {
+            const auto &bytes = fileSystem->content(dayPath(firstDay + day));
+            image.insert(image.end(), bytes.begin(), bytes.end());
+        }
+    }
+
+    void teardown() override
+    {
+        if (!path.empty())
+        {
+            std::remove(path.c_str());
+        }
+    }
+
+    void compactAll(unsigned long now)
+    {
+        while (archive.compact(now))
+        {
+        }
+    }
+
+    std::unique_ptr<IMappedRegion> mapImage(const std::vector<uint8_t> &bytes)
+    {
+        std::string pattern = "/tmp/mappedHistoryXXXXXX";
+        auto descriptor = ::mkstemp(pattern.data());
+        CHECK_TRUE(descriptor >= 0);
+        CHECK_EQUAL(bytes.size(), ::write(descriptor, bytes.data(), bytes.size()));
+        ::close(descriptor);
+        path = pattern;
+        return std::make_unique<FileMappedRegion>(path);
+    }
+
+    static std::vector<Reading> readAll(const IHistoryReader &reader, IDType identifier,
+                                        unsigned long from, unsigned long to)
+    {
+        std::vector<Reading> readings;
+        reader.read(identifier, from, to, [&readings](unsigned long epoch, float temp, float hum)
+                    { readings.push_back({epoch, temp, hum}); });
+        return readings;
+    }
+
+    static void checkSameReadings(const std::vector<Reading> &expected,
+                                  const std::vector<Reading> &actual)
+    {
+        CHECK_EQUAL(expected.size(), actual.size());
+        for (std::size_t idx = 0; idx < expected.size(); ++idx)
+        {
+            CHECK_EQUAL(expected[idx].epochTime, actual[idx].epochTime);
+            CHECK_EQUAL(expected[idx].temperature, actual[idx].temperature);
+            CHECK_EQUAL(expected[idx].humidity, actual[idx].humidity);
+        }
+    }
+
+    std::shared_ptr<FileSystemFake> fileSystem{std::make_shared<FileSystemFake>()};
+    std::shared_ptr<ReadingsLog> log{std::make_shared<ReadingsLog>(fileSystem, "/readings")};
+    ReadingsArchive archive{fileSystem, log, "/archive-"};
+    std::vector<uint8_t> image;
+    std::string path;
+};
+// clang-format on
+
+TEST(MappedHistoryReaderTest, ReadsTheSameAsArchiveFiles)  // NOLINT
+{
+    MappedHistoryReader reader(mapImage(image));
+    auto from = dayStart + 12345;
+    auto to = dayStart + secondsInDay + 6789;
+
+    auto expected = readAll(archive, 2, from, to);
+    auto actual = readAll(reader, 2, from, to);
+
+    CHECK_TRUE(reader.valid());
+    CHECK_FALSE(expected.empty());
+    checkSameReadings(expected, actual);
+}
+
+TEST(MappedHistoryReaderTest, ImageIsFoundAtTheEndOfErasedPartition)  // NOLINT
+{
+    constexpr std::size_t partitionSize = 64 * 1024;
+    std::vector<uint8_t> partition(partitionSize - image.size(), 0xFF);
+    partition.insert(partition.end(), image.begin(), image.end());
+
+    MappedHistoryReader reader(mapImage(partition));
+
+    CHECK_TRUE(reader.valid());
+    CHECK_EQUAL(daysNum * secondsInDay / period,
+                readAll(reader, 3, 0, dayStart + daysNum * secondsInDay).size());
+}
+
+TEST(MappedHistoryReaderTest, ReadsNothingOfUnknownSensorOrOutsideRange)  // NOLINT
+{
+    MappedHistoryReader reader(mapImage(image));
+    auto end = dayStart + daysNum * secondsInDay;
+
+    CHECK_TRUE(readAll(reader, 5, 0, end).empty());
+    CHECK_TRUE(readAll(reader, 1, 0, dayStart).empty());
+    CHECK_TRUE(readAll(reader, 1, end + 1, end + secondsInDay).empty());
+}
+
+TEST(MappedHistoryReaderTest, ErasedPartitionIsNotValid)  // NOLINT
+{
+    MappedHistoryReader reader(mapImage(std::vector<uint8_t>(4096, 0xFF)));
+
+    CHECK_FALSE(reader.valid());
+    CHECK_EQUAL(0, reader.read(1, 0, dayStart + secondsInDay, [](auto, auto, auto) {}));
+}
+
+TEST(MappedHistoryReaderTest, MissingRegionIsNotValid)  // NOLINT
+{
+    MappedHistoryReader reader(std::make_unique<FileMappedRegion>("/nonexistent/history"));
+
+    CHECK_FALSE(reader.valid());
+}
@@ -0,0 +1,93 @@
+#include <CppUTest/TestHarness.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "P2Quantile.hpp"
+
+// clang-format off
+TEST_GROUP(P2QuantileTest)  // NOLINT
+{
+};
+// clang-format on
+
+namespace
+{
+// Uniform samples in [0, 100), the raw engine output is the same on every platform
+std::vector<float> randomSamples(std::size_t count)
+{
+    constexpr uint32_t resolution = 10000;
+    std::mt19937 engine(1);  // NOLINT
+    std::vector<float> samples;
+    for (std::size_t idx = 0; idx < count; ++idx)
+    {
+        samples.push_back(static_cast<float>(engine() % resolution) / 100.0F);
+    }
+    return samples;
+}
+
+float exactPercentile(std::vector<float> samples, float quantile)
+{
+    std::sort(samples.begin(), samples.end());
+    auto rank = static_cast<std::size_t>(std::ceil(quantile * samples.size()));
+    return samples[std::max<std::size_t>(rank, 1) - 1];
+}
+}  // namespace
+
+TEST(P2QuantileTest, NoValueWithoutSamples)  // NOLINT
+{
+    P2Quantile<50> median;
+
+    CHECK_FALSE(median.value().has_value());
+    CHECK_EQUAL(0, median.count());
+}
+
+TEST(P2QuantileTest, ExactWithFewSamples)  // NOLINT
+{
+    P2Quantile<50> median;
+    P2Quantile<95> upper;
+    for (auto value : {30.0F, 10.0F, 20.0F})
+    {
+        median.add(value);
+        upper.add(value);
+    }
+
+    CHECK_EQUAL(20.0, median.value().value());
+    CHECK_EQUAL(30.0, upper.value().value());
+    CHECK_EQUAL(3, median.count());
+}
+
+TEST(P2QuantileTest, EstimatesPercentilesOfLongSeries)  // NOLINT
+{
+    constexpr auto samplesNum = 1440;
+    constexpr auto tolerance = 1.0;
+    auto samples = randomSamples(samplesNum);
+
+    P2Quantile<5> lower;
+    P2Quantile<50> median;
+    P2Quantile<95> upper;
+    for (auto value : samples)
+    {
+        lower.add(value);
+        median.add(value);
+        upper.add(value);
+    }
+
+    DOUBLES_EQUAL(exactPercentile(samples, 0.05F), lower.value().value(), tolerance);
+    DOUBLES_EQUAL(exactPercentile(samples, 0.5F), median.value().value(), tolerance);
+    DOUBLES_EQUAL(exactPercentile(samples, 0.95F), upper.value().value(), tolerance);
+    CHECK_EQUAL(samplesNum, median.count());
+}
+
+TEST(P2QuantileTest, ConstantSeries)  // NOLINT
+{
+    P2Quantile<95> upper;
+    for (int idx = 0; idx < 100; ++idx)
+    {
+        upper.add(21.5);
+    }
+
+    CHECK_EQUAL(21.5, upper.value().value());
+}
@@ -0,0 +1,333 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ReadingsArchive.hpp"
+#include "ReadingsLog.hpp"
+#include "mocks/FileSystemFake.hpp"
+
+namespace
+{
+constexpr unsigned long secondsInDay = 86400;
+constexpr unsigned long firstDay = 19600;
+constexpr unsigned long dayStart = firstDay * secondsInDay;
+constexpr unsigned long period = 600;
+constexpr auto readingsPerDay = secondsInDay / period;
+// More than a segment of the readings log holds
+constexpr unsigned long recordsToCloseSegment = 700;
+constexpr auto quantizationTolerance = 0.005;
+
+struct Reading
+{
+    unsigned long epochTime;
+    float temperature;
+    float humidity;
+};
+
+std::string dayPath(unsigned long day)
+{
+    return "/archive-d" + std::to_string(day) + ".bin";
+}
+
+// LittleFS reports free space in whole blocks, so a write may fail even though it seemed to fit
+class OvercommittedFileSystem : public FileSystemFake
+{
+public:
+    [[nodiscard]] std::size_t freeBytes() const override
+    {
+        constexpr std::size_t reportedFreeBytes = 1024 * 1024;
+        return reportedFreeBytes;
+    }
+};
+}  // namespace
+
+// clang-format off
+TEST_GROUP(ReadingsArchiveTest)  // NOLINT
+{
+    std::vector<Reading> readAll(const ReadingsArchive &archive, IDType identifier,
+                                 unsigned long from, unsigned long to)
+    {
+        std::vector<Reading> readings;
+        auto visited = archive.read(identifier, from, to,
+                                    [&readings](unsigned long epoch, float temp, float hum)
+                                    { readings.push_back({epoch, temp, hum}); });
+        CHECK_EQUAL(readings.size(), visited);
+        return readings;
+    }
+
+    static float temperatureAt(unsigned long epoch)
+    {
+        return static_cast<float>((epoch / period) % 1000) / 100.0F;
+    }
+
+    // Two sensors reporting every 10 minutes. The log keeps only a few segments, so it is archived
+    // at the end of every day, as the background maintenance would do.
+    void fillDays(ReadingsArchive &archive, unsigned long days)
+    {
+        for (unsigned long day = 0; day < days; ++day)
+        {
+            auto start = dayStart + day * secondsInDay;
+            for (auto epoch = start; epoch < start + secondsInDay; epoch += period)
+            {
+                log->append({1, temperatureAt(epoch), 40.0, epoch});
+                log->append({2, -temperatureAt(epoch), 60.0, epoch + 1});
+            }
+            compactAll(archive, start + secondsInDay);
+        }
+        closeSegment(archive, dayStart + days * secondsInDay);
+    }
+
+    // Records of the segment being written to are archived once it is closed
+    void closeSegment(ReadingsArchive &archive, unsigned long epoch)
+    {
+        for (unsigned long idx = 0; idx < recordsToCloseSegment; ++idx)
+        {
+            log->append({3, 0.0, 0.0, epoch});
+        }
+        log->flush();
+        compactAll(archive, epoch);
+    }
+
+    static std::size_t compactAll(ReadingsArchive &archive, unsigned long now)
+    {
+        std::size_t steps = 0;
+        while (archive.compact(now))
+        {
+            ++steps;
+        }
+        return steps;
+    }
+
+    std::shared_ptr<FileSystemFake> fileSystem{std::make_shared<FileSystemFake>()};
+    std::shared_ptr<ReadingsLog> log{std::make_shared<ReadingsLog>(fileSystem, "/readings")};
+};
+// clang-format on
+
+TEST(ReadingsArchiveTest, ReadsReadingsOfOneSensorFromRange)  // NOLINT
+{
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    for (unsigned long idx = 0; idx < 100; ++idx)
+    {
+        log->append({1, 20.0F + idx, 40.0, dayStart + idx * 60});
+        log->append({2, 30.0, 50.0, dayStart + idx * 60 + 1});
+    }
+    closeSegment(archive, dayStart + secondsInDay - 1);
+
+    auto readings = readAll(archive, 1, dayStart + 10 * 60, dayStart + 19 * 60);
+
+    CHECK_EQUAL(10, readings.size());
+    CHECK_EQUAL(dayStart + 10 * 60, readings.front().epochTime);
+    CHECK_EQUAL(dayStart + 19 * 60, readings.back().epochTime);
+    CHECK_TRUE(std::fabs(readings.front().temperature - 30.0) < quantizationTolerance);
+    CHECK_TRUE(std::fabs(readings.front().humidity - 40.0) < quantizationTolerance);
+}
+
+TEST(ReadingsArchiveTest, OnlyClosedLogSegmentsAreArchived)  // NOLINT
+{
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    log->append({1, 20.0, 40.0, dayStart});
+    log->flush();
+
+    compactAll(archive, dayStart);
+    CHECK_FALSE(fileSystem->exists(dayPath(firstDay)));
+    CHECK_TRUE(readAll(archive, 1, dayStart, dayStart).empty());
+
+    closeSegment(archive, dayStart + 1);
+    CHECK_TRUE(fileSystem->exists(dayPath(firstDay)));
+    CHECK_EQUAL(1, readAll(archive, 1, dayStart, dayStart).size());
+}
+
+TEST(ReadingsArchiveTest, SegmentIsArchivedInBoundedStepsAndWrittenOnce)  // NOLINT
+{
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    compactAll(archive, dayStart);
+    for (unsigned long idx = 0; idx < recordsToCloseSegment; ++idx)
+    {
+        log->append({1, 20.0, 40.0, dayStart + idx});
+    }
+
+    CHECK_TRUE(archive.compact(dayStart));
+    CHECK_FALSE(fileSystem->exists(dayPath(firstDay)));
+
+    CHECK_TRUE(compactAll(archive, dayStart) > 3);
+    CHECK_TRUE(fileSystem->exists(dayPath(firstDay)));
+}
+
+TEST(ReadingsArchiveTest, ReadingsSpanningSeveralDaysAreReadInOrder)  // NOLINT
+{
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    fillDays(archive, 3);
+
+    auto readings = readAll(archive, 2, dayStart + secondsInDay / 2, dayStart + 3 * secondsInDay);
+
+    CHECK_EQUAL(5 * readingsPerDay / 2, readings.size());
+    for (std::size_t idx = 1; idx < readings.size(); ++idx)
+    {
+        CHECK_EQUAL(readings[idx - 1].epochTime + period, readings[idx].epochTime);
+    }
+    CHECK_TRUE(std::fabs(readings.front().temperature
+                         + temperatureAt(dayStart + secondsInDay / 2))
+               < quantizationTolerance);
+}
+
+TEST(ReadingsArchiveTest, ArchiveIsSmallerThanTheLog)  // NOLINT
+{
+    constexpr std::size_t logFrameSize = 25;
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    fillDays(archive, 1);
+
+    auto archivedBytes = fileSystem->content(dayPath(firstDay)).size();
+    CHECK_TRUE(archivedBytes * 3 < 2 * readingsPerDay * logFrameSize);
+}
+
+TEST(ReadingsArchiveTest, DaysOlderThanRetentionAreDropped)  // NOLINT
+{
+    constexpr auto budgetBytes = 1024 * 1024;
+    constexpr auto retentionDays = 2;
+    ReadingsArchive archive(fileSystem, log, "/archive-", budgetBytes, retentionDays);
+    fillDays(archive, 5);
+
+    CHECK_FALSE(fileSystem->exists(dayPath(firstDay)));
+    CHECK_FALSE(fileSystem->exists(dayPath(firstDay + 1)));
+    CHECK_TRUE(fileSystem->exists(dayPath(firstDay + 3)));
+    CHECK_TRUE(readAll(archive, 1, dayStart, dayStart + 2 * secondsInDay - 1).empty());
+    CHECK_EQUAL(readingsPerDay, readAll(archive, 1, dayStart + 3 * secondsInDay,
+                                        dayStart + 4 * secondsInDay - 1)
+                                    .size());
+}
+
+TEST(ReadingsArchiveTest, OldestDaysAreDroppedToStayWithinBudget)  // NOLINT
+{
+    std::size_t dayBytes = 0;
+    {
+        ReadingsArchive unlimited(fileSystem, log, "/archive-");
+        fillDays(unlimited, 1);
+        dayBytes = fileSystem->content(dayPath(firstDay)).size();
+    }
+    fileSystem = std::make_shared<FileSystemFake>();
+    log = std::make_shared<ReadingsLog>(fileSystem, "/readings");
+
+    auto budgetBytes = 5 * dayBytes / 2;
+    ReadingsArchive archive(fileSystem, log, "/archive-", budgetBytes);
+    fillDays(archive, 5);
+
+    std::size_t usedBytes = 0;
+    for (auto day = firstDay; day <= firstDay + 5; ++day)
+    {
+        if (fileSystem->exists(dayPath(day)))
+        {
+            usedBytes += fileSystem->content(dayPath(day)).size();
+        }
+    }
+    CHECK_TRUE(usedBytes <= budgetBytes);
+    CHECK_FALSE(fileSystem->exists(dayPath(firstDay)));
+    CHECK_TRUE(fileSystem->exists(dayPath(firstDay + 4)));
+}
+
+TEST(ReadingsArchiveTest, DefaultBudgetLeavesTheLogItsPartOfThePartition)  // NOLINT
+{
+    constexpr std::size_t partitionBytes = 1408 * 1024;
+    auto budgetBytes = ReadingsArchive::budgetFor(partitionBytes);
+    CHECK_TRUE(budgetBytes > 0);
+    CHECK_TRUE(budgetBytes < partitionBytes - ReadingsLog::maxBytes());
+    CHECK_EQUAL(0, ReadingsArchive::budgetFor(ReadingsLog::maxBytes()));
+
+    fileSystem->setCapacity(partitionBytes);
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    fillDays(archive, 3);
+
+    CHECK_TRUE(fileSystem->exists(dayPath(firstDay)));
+    CHECK_TRUE(fileSystem->exists(dayPath(firstDay + 2)));
+}
+
+TEST(ReadingsArchiveTest, ChunkIsDroppedWhenFileSystemHasNoRoom)  // NOLINT
+{
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    compactAll(archive, dayStart);
+    fileSystem->setCapacity(40 * 1024);
+
+    fillDays(archive, 1);
+
+    CHECK_FALSE(fileSystem->exists(dayPath(firstDay)));
+    CHECK_TRUE(readAll(archive, 1, dayStart, dayStart + secondsInDay).empty());
+}
+
+TEST(ReadingsArchiveTest, FailedWriteIsCutOffAndRetried)  // NOLINT
+{
+    auto overcommitted = std::make_shared<OvercommittedFileSystem>();
+    auto overcommittedLog = std::make_shared<ReadingsLog>(overcommitted, "/readings");
+    ReadingsArchive archive(overcommitted, overcommittedLog, "/archive-");
+    compactAll(archive, dayStart);
+
+    for (unsigned long idx = 0; idx < recordsToCloseSegment; ++idx)
+    {
+        overcommittedLog->append({1, 20.0, 40.0, dayStart + idx});
+    }
+    overcommittedLog->flush();
+    overcommitted->setCapacity(overcommitted->content("/readings0.log").size()
+                               + overcommitted->content("/readings1.log").size() + 64);
+
+    // The write is retried on every step, until it succeeds
+    for (auto step = 0; step < 20; ++step)
+    {
+        CHECK_TRUE(archive.compact(dayStart));
+    }
+    CHECK_FALSE(overcommitted->exists(dayPath(firstDay)));
+
+    overcommitted->setCapacity(1024 * 1024);
+    compactAll(archive, dayStart);
+
+    CHECK_TRUE(readAll(archive, 1, dayStart, dayStart + secondsInDay).size() > 600);
+}
+
+TEST(ReadingsArchiveTest, ArchivingResumesAfterRestartWithoutDuplicates)  // NOLINT
+{
+    {
+        ReadingsArchive archive(fileSystem, log, "/archive-");
+        fillDays(archive, 1);
+        for (auto epoch = dayStart + secondsInDay; epoch < dayStart + 2 * secondsInDay;
+             epoch += period)
+        {
+            log->append({1, 20.0, 40.0, epoch});
+        }
+    }
+
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    closeSegment(archive, dayStart + 2 * secondsInDay);
+
+    auto readings = readAll(archive, 1, dayStart, dayStart + 2 * secondsInDay);
+    CHECK_EQUAL(2 * readingsPerDay, readings.size());
+}
+
+TEST(ReadingsArchiveTest, LogSegmentsReusedBeforeArchivingAreSkipped)  // NOLINT
+{
+    constexpr unsigned long skippedRecords = 4000;
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    closeSegment(archive, dayStart);
+    for (unsigned long idx = 0; idx < skippedRecords; ++idx)
+    {
+        log->append({1, 20.0, 40.0, dayStart + 1 + idx});
+    }
+    log->flush();
+
+    compactAll(archive, dayStart);
+
+    auto readings = readAll(archive, 1, dayStart, dayStart + secondsInDay);
+    CHECK_FALSE(readings.empty());
+    CHECK_TRUE(readings.size() < skippedRecords);
+    CHECK_TRUE(readings.front().epochTime > dayStart + recordsToCloseSegment);
+}
+
+TEST(ReadingsArchiveTest, TimeRangeCoversArchivedDays)  // NOLINT
+{
+    ReadingsArchive archive(fileSystem, log, "/archive-");
+    CHECK_TRUE(archive.timeRange().first > archive.timeRange().second);
+
+    fillDays(archive, 2);
+
+    CHECK_EQUAL(dayStart, archive.timeRange().first);
+    CHECK_EQUAL(dayStart + 3 * secondsInDay - 1, archive.timeRange().second);
+}
@@ -0,0 +1,161 @@
+#include <CppUTest/TestHarness.h>
+
+#include <vector>
+
+#include "ReadingsBlockPool.hpp"
+
+// clang-format off
+TEST_GROUP(ReadingsBlockPoolTest)  // NOLINT
+{
+    using Pool = ReadingsBlockPool<4, 3>;
+
+    std::vector<uint32_t> epochs(const Pool &pool, const Pool::Chain &chain)
+    {
+        std::vector<uint32_t> result;
+        pool.forEach(chain, [&result](uint32_t epochTime, double, double)
+                     { result.push_back(epochTime); });
+        return result;
+    }
+
+    Pool pool;
+};
+// clang-format on
+
+TEST(ReadingsBlockPoolTest, ChainSpansSeveralBlocksInOrder)  // NOLINT
+{
+    Pool::Chain chain;
+    for (uint32_t epoch = 1; epoch <= 7; ++epoch)
+    {
+        pool.put(chain, epoch, 20.0, 40.0);
+    }
+
+    CHECK_EQUAL(7, chain.size);
+    CHECK_EQUAL(1, pool.freeBlocks());
+    CHECK_TRUE((std::vector<uint32_t>{1, 2, 3, 4, 5, 6, 7}) == epochs(pool, chain));
+    CHECK_EQUAL(1, pool.firstEpoch(chain).value());
+    CHECK_EQUAL(7, pool.last(chain)->epochTime);
+}
+
+TEST(ReadingsBlockPoolTest, EmptyChainHasNoReadings)  // NOLINT
+{
+    Pool::Chain chain;
+
+    CHECK_TRUE(chain.empty());
+    CHECK_FALSE(pool.firstEpoch(chain).has_value());
+    CHECK_FALSE(pool.last(chain).has_value());
+    CHECK_TRUE(epochs(pool, chain).empty());
+}
+
+TEST(ReadingsBlockPoolTest, ReleasedBlocksReturnToPool)  // NOLINT
+{
+    Pool::Chain chain;
+    for (uint32_t epoch = 1; epoch <= 12; ++epoch)
+    {
+        pool.put(chain, epoch, 20.0, 40.0);
+    }
+    CHECK_EQUAL(0, pool.freeBlocks());
+
+    pool.release(chain);
+
+    CHECK_TRUE(chain.empty());
+    CHECK_EQUAL(4, pool.freeBlocks());
+}
+
+TEST(ReadingsBlockPoolTest, SingleChainReusesItsOldestBlock)  // NOLINT
+{
+    Pool::Chain chain;
+    for (uint32_t epoch = 1; epoch <= 13; ++epoch)
+    {
+        pool.put(chain, epoch, 20.0, 40.0);
+    }
+
+    CHECK_EQUAL(10, chain.size);
+    CHECK_EQUAL(4, pool.firstEpoch(chain).value());
+    CHECK_EQUAL(13, pool.last(chain)->epochTime);
+}
+
+TEST(ReadingsBlockPoolTest, GloballyOldestFullBlockIsReclaimed)  // NOLINT
+{
+    Pool::Chain fast;
+    Pool::Chain slow;
+    pool.put(slow, 1, 20.0, 40.0);
+    for (uint32_t epoch = 10; epoch < 19; ++epoch)
+    {
+        pool.put(fast, epoch, 20.0, 40.0);
+    }
+
+    // Slow sensor has the oldest reading, but its only block is still being filled
+    pool.put(fast, 19, 20.0, 40.0);
+
+    CHECK_TRUE((std::vector<uint32_t>{1}) == epochs(pool, slow));
+    CHECK_TRUE((std::vector<uint32_t>{13, 14, 15, 16, 17, 18, 19}) == epochs(pool, fast));
+
+    pool.put(slow, 20, 20.0, 40.0);
+    pool.put(slow, 21, 20.0, 40.0);
+    pool.put(slow, 22, 20.0, 40.0);
+
+    CHECK_TRUE((std::vector<uint32_t>{1, 20, 21, 22}) == epochs(pool, slow));
+    CHECK_TRUE((std::vector<uint32_t>{16, 17, 18, 19}) == epochs(pool, fast));
+}
+
+TEST(ReadingsBlockPoolTest, QuantizesValues)  // NOLINT
+{
+    Pool::Chain chain;
+    pool.put(chain, 1, 21.299999, 45.504);
+
+    auto last = pool.last(chain);
+    CHECK_EQUAL(21.3, last->temperature);
+    CHECK_EQUAL(45.5, last->humidity);
+}
+
+TEST(ReadingsBlockPoolTest, RangeIsFoundByEpoch)  // NOLINT
+{
+    Pool::Chain chain;
+    for (uint32_t epoch = 10; epoch <= 100; epoch += 10)
+    {
+        pool.put(chain, epoch, static_cast<float>(epoch), 40.0);
+    }
+
+    auto middle = pool.range(chain, 25, 70);
+    CHECK_EQUAL(5, middle.size());
+    CHECK_EQUAL(30, middle.at(0).epochTime);
+    CHECK_EQUAL(30.0, middle.at(0).temperature);
+    CHECK_EQUAL(70, middle.at(4).epochTime);
+
+    CHECK_EQUAL(10, pool.range(chain, 0, 1000).size());
+    CHECK_EQUAL(1, pool.range(chain, 100, 100).size());
+    CHECK_EQUAL(0, pool.range(chain, 101, 1000).size());
+    CHECK_EQUAL(0, pool.range(chain, 45, 48).size());
+    CHECK_EQUAL(0, pool.range(chain, 70, 30).size());
+}
+
+TEST(ReadingsBlockPoolTest, ChainAtQuotaReusesItsOwnOldestBlock)  // NOLINT
+{
+    Pool::Chain limited;
+    Pool::Chain other;
+    pool.setQuota(limited, 2);
+    for (uint32_t epoch = 1; epoch <= 9; ++epoch)
+    {
+        pool.put(limited, epoch, 20.0, 40.0);
+    }
+    pool.put(other, 100, 20.0, 40.0);
+
+    CHECK_EQUAL(2, limited.blocks);
+    CHECK_TRUE((std::vector<uint32_t>{4, 5, 6, 7, 8, 9}) == epochs(pool, limited));
+    CHECK_EQUAL(1, pool.freeBlocks());
+}
+
+TEST(ReadingsBlockPoolTest, LoweringQuotaKeepsNewestReadings)  // NOLINT
+{
+    Pool::Chain chain;
+    for (uint32_t epoch = 1; epoch <= 10; ++epoch)
+    {
+        pool.put(chain, epoch, 20.0, 40.0);
+    }
+
+    pool.setQuota(chain, 2);
+
+    CHECK_EQUAL(2, chain.blocks);
+    CHECK_TRUE((std::vector<uint32_t>{7, 8, 9, 10}) == epochs(pool, chain));
+    CHECK_EQUAL(2, pool.freeBlocks());
+}
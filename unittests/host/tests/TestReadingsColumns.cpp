@@ -0,0 +1,106 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ReadingsColumns.hpp"
+
+// clang-format off
+TEST_GROUP(ReadingsColumnsTest)  // NOLINT
+{
+};
+// clang-format on
+
+constexpr auto maxQuantizationError = 0.005;
+
+TEST(ReadingsColumnsTest, EpochsAreStoredLosslessly)  // NOLINT
+{
+    ReadingsColumns<3> columns;
+    columns.put(0, 0, 0);
+    columns.put(1700000000, 0, 0);
+    columns.put(0xFFFFFFFF, 0, 0);
+
+    CHECK_EQUAL(0, columns.epochAt(0));
+    CHECK_EQUAL(1700000000, columns.epochAt(1));
+    CHECK_EQUAL(0xFFFFFFFF, columns.epochAt(2));
+}
+
+TEST(ReadingsColumnsTest, ValuesAreRoundedToHundredths)  // NOLINT
+{
+    ReadingsColumns<4> columns;
+    columns.put(0, 21.299999, 45.5);
+    columns.put(1, -12.345, 0.004);
+    columns.put(2, 99.996, 99.995);
+
+    CHECK_EQUAL(21.3, columns.temperatureAt(0));
+    CHECK_EQUAL(45.5, columns.humidityAt(0));
+    CHECK_TRUE(std::fabs(columns.temperatureAt(1) + 12.345) <= maxQuantizationError);
+    CHECK_EQUAL(0.0, columns.humidityAt(1));
+    CHECK_EQUAL(100.0, columns.temperatureAt(2));
+    CHECK_EQUAL(100.0, columns.humidityAt(2));
+}
+
+TEST(ReadingsColumnsTest, ValuesOutsideOfRangeAreClamped)  // NOLINT
+{
+    ReadingsColumns<2> columns;
+    columns.put(0, 1000.0, -5.0);
+    columns.put(1, -1000.0, 1000.0);
+
+    CHECK_EQUAL(327.67, columns.temperatureAt(0));
+    CHECK_EQUAL(0.0, columns.humidityAt(0));
+    CHECK_EQUAL(-327.67, columns.temperatureAt(1));
+    CHECK_EQUAL(655.35, columns.humidityAt(1));
+}
+
+TEST(ReadingsColumnsTest, OldestReadingsAreOverwritten)  // NOLINT
+{
+    ReadingsColumns<3> columns;
+    for (uint32_t epoch = 1; epoch <= 5; ++epoch)
+    {
+        columns.put(epoch, static_cast<float>(epoch), static_cast<float>(epoch) * 2);
+    }
+
+    std::vector<uint32_t> epochs;
+    std::vector<double> humidities;
+    columns.forEach(
+        [&](uint32_t epochTime, double, double humidity)
+        {
+            epochs.push_back(epochTime);
+            humidities.push_back(humidity);
+        });
+
+    CHECK_EQUAL(3, columns.size());
+    CHECK_TRUE((std::vector<uint32_t>{3, 4, 5}) == epochs);
+    CHECK_TRUE((std::vector<double>{6, 8, 10}) == humidities);
+    CHECK_EQUAL(3, columns.epochAt(0));
+    CHECK_EQUAL(5, columns.epochAt(2));
+}
+
+TEST(ReadingsColumnsTest, SuspectFlagFollowsItsReading)  // NOLINT
+{
+    ReadingsColumns<3> columns;
+    for (uint32_t epoch = 1; epoch <= 4; ++epoch)
+    {
+        columns.put(epoch, 20.0, 40.0, epoch == 3);
+    }
+
+    CHECK_FALSE(columns.suspectAt(0));
+    CHECK_TRUE(columns.suspectAt(1));
+    CHECK_FALSE(columns.suspectAt(2));
+}
+
+TEST(ReadingsColumnsTest, SingleMetricIteration)  // NOLINT
+{
+    ReadingsColumns<2> columns;
+    columns.put(10, 1.5, 50.0);
+    columns.put(20, 2.5, 60.0);
+    columns.put(30, 3.5, 70.0);
+
+    std::vector<double> temperatures;
+    columns.forEachTemperature([&](uint32_t, double value) { temperatures.push_back(value); });
+    std::vector<double> humidities;
+    columns.forEachHumidity([&](uint32_t, double value) { humidities.push_back(value); });
+
+    CHECK_TRUE((std::vector<double>{2.5, 3.5}) == temperatures);
+    CHECK_TRUE((std::vector<double>{60.0, 70.0}) == humidities);
+}
@@ -0,0 +1,106 @@
+#include <CppUTest/TestHarness.h>
+
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "ReadingsJsonStream.hpp"
+#include "ReadingsStorage.hpp"
+
+namespace
+{
+std::string receive(ReadingsJsonStream &stream, std::size_t chunkSize)
+{
+    std::string received;
+    std::vector<uint8_t> buffer(chunkSize);
+    while (auto len = stream.fill(buffer.data(), buffer.size()))
+    {
+        received.append(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(len));
+    }
+    return received;
+}
+}  // namespace
+
+// clang-format off
+TEST_GROUP(ReadingsJsonStreamTest)  // NOLINT
+{
+    ReadingsStorage storage;
+    IDType sensorId = 1;
+
+    void addReadings(unsigned long from, unsigned long to, unsigned long step)
+    {
+        for (auto epoch = from; epoch < to; epoch += step)
+        {
+            storage.addReading(sensorId, 20.0F + static_cast<float>(epoch % 7) / 10,
+                               40.0F + static_cast<float>(epoch % 11), epoch);
+        }
+    }
+};
+// clang-format on
+
+TEST(ReadingsJsonStreamTest, rawReadingsAreStreamedAsSerializedAtOnce)  // NOLINT
+{
+    // A few batches, so values continue across batches and across chunks
+    addReadings(1000, 1000 + 100 * 60, 60);
+    ReadingsQuery query{sensorId, ReadingsQuery::Resolution::RAW};
+    query.from = 1100;
+    auto expected = storage.getReadingsAsJsonStr(query);
+
+    for (std::size_t chunkSize : {1, 7, 64, 4096})
+    {
+        ReadingsJsonStream stream(storage, query);
+        STRCMP_EQUAL(expected.c_str(), receive(stream, chunkSize).c_str());
+    }
+    CHECK_EQUAL(98, nlohmann::json::parse(expected)["values"].size());
+}
+
+TEST(ReadingsJsonStreamTest, rollupsAreStreamedWithResolution)  // NOLINT
+{
+    addReadings(0, 3 * 24 * 3600, 600);
+    ReadingsQuery query{sensorId, ReadingsQuery::Resolution::HOURLY};
+    auto expected = storage.getReadingsAsJsonStr(query);
+
+    ReadingsJsonStream stream(storage, query);
+    STRCMP_EQUAL(expected.c_str(), receive(stream, 100).c_str());
+    STRCMP_EQUAL("hour", nlohmann::json::parse(expected)["resolution"].get<std::string>().c_str());
+}
+
+TEST(ReadingsJsonStreamTest, readingsSharingAnEpochAcrossBatchesAreAllStreamed)  // NOLINT
+{
+    // The first batch ends in the middle of the readings stored at 3000
+    addReadings(1000, 1000 + 30 * 60, 60);
+    for (int idx = 0; idx < 5; ++idx)
+    {
+        storage.addReading(sensorId, 21.0F + static_cast<float>(idx), 45.0F, 3000);
+    }
+    addReadings(3060, 3060 + 3 * 60, 60);
+    ReadingsQuery query{sensorId, ReadingsQuery::Resolution::RAW};
+    auto expected = storage.getReadingsAsJsonStr(query);
+
+    ReadingsJsonStream stream(storage, query);
+    STRCMP_EQUAL(expected.c_str(), receive(stream, 64).c_str());
+    CHECK_EQUAL(38, nlohmann::json::parse(expected)["values"].size());
+}
+
+TEST(ReadingsJsonStreamTest, unknownSensorHasNoValues)  // NOLINT
+{
+    ReadingsJsonStream stream(storage, ReadingsQuery{5});
+
+    STRCMP_EQUAL(R"({"identifier":5,"values":[]})", receive(stream, 16).c_str());
+}
+
+TEST(ReadingsJsonStreamTest, readingsStoredWhileStreamingAreAppended)  // NOLINT
+{
+    addReadings(1000, 1000 + 40 * 60, 60);
+    ReadingsJsonStream stream(storage, ReadingsQuery{sensorId, ReadingsQuery::Resolution::RAW});
+    std::vector<uint8_t> buffer(64);
+    std::string received(reinterpret_cast<char *>(buffer.data()),  // NOLINT
+                         stream.fill(buffer.data(), buffer.size()));
+
+    storage.addReading(sensorId, 30.0, 50.0, 5000);
+    received += receive(stream, 64);
+
+    auto values = nlohmann::json::parse(received)["values"];
+    CHECK_EQUAL(41, values.size());
+    CHECK_EQUAL(5000, values.back()[0].get<int>());
+}
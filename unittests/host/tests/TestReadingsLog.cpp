@@ -0,0 +1,179 @@
+#include <CppUTest/TestHarness.h>
+
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+#include "ReadingsLog.hpp"
+#include "ReadingsStorage.hpp"
+#include "mocks/FileSystemFake.hpp"
+
+// clang-format off
+TEST_GROUP(ReadingsLogTest)  // NOLINT
+{
+    std::vector<ReadingsLog::Record> replayAll(ReadingsLog &log)
+    {
+        std::vector<ReadingsLog::Record> records;
+        log.replay([&records](const ReadingsLog::Record &record) { records.push_back(record); });
+        return records;
+    }
+
+    std::shared_ptr<FileSystemFake> fileSystem{std::make_shared<FileSystemFake>()};
+};
+// clang-format on
+
+TEST(ReadingsLogTest, NothingIsWrittenBeforeFlush)  // NOLINT
+{
+    ReadingsLog log(fileSystem, "/readings");
+    log.append({1, 10.0, 20.0, 30});
+
+    CHECK_FALSE(fileSystem->exists("/readings0.log"));
+}
+
+TEST(ReadingsLogTest, ReplayFlushedRecords)  // NOLINT
+{
+    {
+        ReadingsLog log(fileSystem, "/readings");
+        log.append({1, 10.5, 20.5, 30});
+        log.append({2, 11.5, 21.5, 31});
+        log.flush();
+    }
+
+    ReadingsLog log(fileSystem, "/readings");
+    auto records = replayAll(log);
+
+    CHECK_EQUAL(2, records.size());
+    CHECK_EQUAL(1, records[0].identifier);
+    CHECK_EQUAL(10.5, records[0].temperature);
+    CHECK_EQUAL(20.5, records[0].humidity);
+    CHECK_EQUAL(30, records[0].epochTime);
+    CHECK_EQUAL(2, records[1].identifier);
+    CHECK_EQUAL(31, records[1].epochTime);
+}
+
+TEST(ReadingsLogTest, FullBatchIsFlushedAutomatically)  // NOLINT
+{
+    ReadingsLog log(fileSystem, "/readings");
+    for (auto idx = 0; idx < 16; ++idx)
+    {
+        log.append({1, 10.0, 20.0, static_cast<unsigned long>(idx)});
+    }
+
+    ReadingsLog reopenedLog(fileSystem, "/readings");
+    CHECK_EQUAL(16, replayAll(reopenedLog).size());
+}
+
+TEST(ReadingsLogTest, TornTailIsTruncatedOnReplay)  // NOLINT
+{
+    {
+        ReadingsLog log(fileSystem, "/readings");
+        log.append({1, 10.0, 20.0, 30});
+        log.append({1, 11.0, 21.0, 31});
+        log.flush();
+    }
+
+    // Simulate power loss in the middle of the second record
+    auto &content = fileSystem->content("/readings0.log");
+    auto sizeWithOneRecord = content.size() - (content.size() - 8) / 2;
+    content.resize(content.size() - 5);
+
+    {
+        ReadingsLog log(fileSystem, "/readings");
+        auto records = replayAll(log);
+        CHECK_EQUAL(1, records.size());
+        CHECK_EQUAL(30, records[0].epochTime);
+        CHECK_EQUAL(sizeWithOneRecord, content.size());
+
+        log.append({1, 12.0, 22.0, 32});
+        log.flush();
+    }
+
+    ReadingsLog log(fileSystem, "/readings");
+    auto records = replayAll(log);
+    CHECK_EQUAL(2, records.size());
+    CHECK_EQUAL(30, records[0].epochTime);
+    CHECK_EQUAL(32, records[1].epochTime);
+}
+
+TEST(ReadingsLogTest, CorruptedRecordStopsReplay)  // NOLINT
+{
+    {
+        ReadingsLog log(fileSystem, "/readings");
+        log.append({1, 10.0, 20.0, 30});
+        log.append({1, 11.0, 21.0, 31});
+        log.flush();
+    }
+
+    auto &content = fileSystem->content("/readings0.log");
+    content[content.size() - 10] ^= 0xFF;
+
+    ReadingsLog log(fileSystem, "/readings");
+    CHECK_EQUAL(1, replayAll(log).size());
+}
+
+TEST(ReadingsLogTest, SegmentsRotateAndReplayInOrder)  // NOLINT
+{
+    constexpr unsigned long readingsNum = 3000;
+    {
+        ReadingsLog log(fileSystem, "/readings");
+        for (unsigned long epoch = 0; epoch < readingsNum; ++epoch)
+        {
+            log.append({1, 10.0, 20.0, epoch});
+        }
+        log.flush();
+    }
+
+    CHECK_TRUE(fileSystem->exists("/readings3.log"));
+
+    ReadingsLog log(fileSystem, "/readings");
+    auto records = replayAll(log);
+
+    CHECK_TRUE(records.size() < readingsNum);
+    CHECK_EQUAL(readingsNum - 1, records.back().epochTime);
+    for (std::size_t idx = 1; idx < records.size(); ++idx)
+    {
+        CHECK_EQUAL(records[idx - 1].epochTime + 1, records[idx].epochTime);
+    }
+}
+
+TEST(ReadingsLogTest, ReadingsStorageRestoresHistoryFromLog)  // NOLINT
+{
+    {
+        auto log = std::make_shared<ReadingsLog>(fileSystem, "/readings");
+        ReadingsStorage storage(log);
+        storage.addReading(1, 10.0, 20.0, 30);
+        storage.addReading(1, 11.0, 21.0, 31);
+        log->flush();
+    }
+
+    ReadingsStorage storage(std::make_shared<ReadingsLog>(fileSystem, "/readings"));
+    storage.restoreFromLog();
+
+    auto expected = nlohmann::json(
+        {{"identifier", 1}, {"values", {{30, 10.0, 20.0}, {31, 11.0, 21.0}}}});
+    CHECK_EQUAL(expected.dump(), storage.getReadingsAsJsonStr(1));
+}
+
+TEST(ReadingsLogTest, ClosedSegmentsAreReadFromPosition)  // NOLINT
+{
+    ReadingsLog log(fileSystem, "/readings");
+    for (unsigned long epoch = 0; epoch < 1000; ++epoch)
+    {
+        log.append({1, 10.0, 20.0, epoch});
+    }
+    log.flush();
+
+    auto closed = log.closedSegments();
+    CHECK_EQUAL(1, closed.size());
+    CHECK_EQUAL(0, closed.front());
+
+    std::vector<ReadingsLog::Record> records;
+    auto read = log.readSegment(0, 600, 100,
+                                [&records](const ReadingsLog::Record &record)
+                                { records.push_back(record); });
+
+    CHECK_EQUAL(records.size(), read.value());
+    CHECK_TRUE(records.size() < 100);
+    CHECK_EQUAL(600, records.front().epochTime);
+    CHECK_FALSE(log.readSegment(4, 0, 100, [](const ReadingsLog::Record &) {}).has_value());
+}
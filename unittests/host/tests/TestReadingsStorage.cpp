@@ -1,6 +1,11 @@
 #include <CppUTest/TestHarness.h>
 
+#include <algorithm>
+#include <atomic>
 #include <nlohmann/json.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "ReadingsStorage.hpp"
 
@@ -149,3 +154,567 @@ TEST(ReadingStorageTest, getLastReadingsReturnsEmptyValuesWhenSensorIdNotExistin
     auto results = storage.getLastReadingAsJsonStr(3);
     CHECK_TRUE(results == expected.dump());
 }
+
+TEST(ReadingStorageTest, returnFiveMinutesRollupWithMinMaxAvgAndCount)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    IDType sensorId = 1;
+    storage.addReading(sensorId, 10.0, 40.0, 0);
+    storage.addReading(sensorId, 20.0, 50.0, 60);
+    storage.addReading(sensorId, 30.0, 60.0, 299);
+    storage.addReading(sensorId, 15.0, 45.0, 300);
+
+    auto expected = nlohmann::json({{"identifier", sensorId},
+                                    {"resolution", "5min"},
+                                    {"values",
+                                     {{0, 20.0, 50.0, 10.0, 30.0, 40.0, 60.0, 3},
+                                      {300, 15.0, 45.0, 15.0, 15.0, 45.0, 45.0, 1}}}});
+
+    auto results = storage.getReadingsAsJsonStr(
+        {sensorId, ReadingsQuery::Resolution::MINUTES_5, std::nullopt, std::nullopt});
+    CHECK_EQUAL(expected.dump(), results);
+}
+
+TEST(ReadingStorageTest, rollupsAreLimitedToRequestedTimeRange)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    IDType sensorId = 1;
+    constexpr auto secondsInHour = 3600;
+    for (auto hour = 0; hour < 5; ++hour)
+    {
+        storage.addReading(sensorId, 10.0, 40.0, hour * secondsInHour);
+    }
+
+    auto results = nlohmann::json::parse(storage.getReadingsAsJsonStr(
+        {sensorId, ReadingsQuery::Resolution::HOURLY, secondsInHour + 1, 3 * secondsInHour}));
+
+    CHECK_EQUAL(3, results["values"].size());
+    CHECK_EQUAL(secondsInHour, results["values"][0][0]);
+    CHECK_EQUAL(3 * secondsInHour, results["values"][2][0]);
+}
+
+TEST(ReadingStorageTest, autoResolutionPicksRollupWhenRawHistoryIsTooShort)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    IDType sensorId = 1;
+    constexpr auto readingsNum = 2000;
+    constexpr auto periodSecs = 20;
+    for (auto idx = 0; idx < readingsNum; ++idx)
+    {
+        // All sensors in use share the raw readings pool
+        for (IDType otherId = sensorId; otherId < sensorId + ConfStorage::maxSensorsNum; ++otherId)
+        {
+            storage.addReading(otherId, 10.0, 40.0, idx * periodSecs);
+        }
+    }
+
+    auto recent = nlohmann::json::parse(storage.getReadingsAsJsonStr(
+        {sensorId, ReadingsQuery::Resolution::AUTO, (readingsNum - 10) * periodSecs}));
+    CHECK_FALSE(recent.contains("resolution"));
+    CHECK_EQUAL(10, recent["values"].size());
+
+    auto lastHours = nlohmann::json::parse(storage.getReadingsAsJsonStr(
+        {sensorId, ReadingsQuery::Resolution::AUTO, (readingsNum - 1000) * periodSecs}));
+    CHECK_EQUAL("5min", lastHours["resolution"]);
+
+    auto whole = nlohmann::json::parse(
+        storage.getReadingsAsJsonStr({sensorId, ReadingsQuery::Resolution::AUTO, 0}));
+    CHECK_EQUAL("hour", whole["resolution"]);
+}
+
+TEST(ReadingStorageTest, queriesForUnknownSensorDoNotTakeSpace)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    for (IDType sensorId = 100; sensorId < 200; ++sensorId)
+    {
+        storage.getReadingsAsJsonStr(sensorId);
+        storage.getLastReadingAsJsonStr(sensorId);
+    }
+
+    for (IDType sensorId = 0; sensorId < ConfStorage::maxSensorsNum; ++sensorId)
+    {
+        storage.addReading(sensorId, 10.0, 20.0, 30);
+    }
+
+    auto expected = nlohmann::json({{"identifier", 0}, {"values", {{30, 10.0, 20.0}}}});
+    CHECK_EQUAL(expected.dump(), storage.getReadingsAsJsonStr(0));
+}
+
+TEST(ReadingStorageTest, sensorSilentForLongestTimeIsDroppedWhenStorageIsFull)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    for (IDType sensorId = 0; sensorId < ConfStorage::maxSensorsNum; ++sensorId)
+    {
+        storage.addReading(sensorId, 10.0, 20.0, 30);
+    }
+    for (IDType sensorId = 1; sensorId < ConfStorage::maxSensorsNum; ++sensorId)
+    {
+        storage.addReading(sensorId, 10.0, 20.0, 40);
+    }
+
+    IDType newSensorId = 1000;
+    storage.addReading(newSensorId, 11.0, 21.0, 50);
+
+    auto empty = nlohmann::json({{"identifier", 0}, {"values", nlohmann::json::array()}});
+    auto added = nlohmann::json({{"identifier", newSensorId}, {"values", {{50, 11.0, 21.0}}}});
+    CHECK_EQUAL(empty.dump(), storage.getReadingsAsJsonStr(0));
+    CHECK_EQUAL(added.dump(), storage.getReadingsAsJsonStr(newSensorId));
+}
+
+TEST(ReadingStorageTest, rawReadingsAreDownsampledToMaxPoints)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    IDType sensorId = 1;
+    for (auto idx = 0; idx < 1000; ++idx)
+    {
+        auto temperature = idx == 500 ? 30.0 : 20.0;
+        storage.addReading(sensorId, temperature, 40.0, idx * 60);
+    }
+
+    ReadingsQuery query{sensorId, ReadingsQuery::Resolution::RAW, 100 * 60, 899 * 60};
+    query.maxPoints = 20;
+    auto results = nlohmann::json::parse(storage.getReadingsAsJsonStr(query));
+
+    CHECK_EQUAL(20, results["values"].size());
+    CHECK_EQUAL(100 * 60, results["values"].front()[0]);
+    CHECK_EQUAL(899 * 60, results["values"].back()[0]);
+
+    auto spike = std::find_if(results["values"].begin(), results["values"].end(),
+                              [](const auto &reading) { return reading[1] == 30.0; });
+    CHECK_TRUE(spike != results["values"].end());
+}
+
+TEST(ReadingStorageTest, repeatedReadsShareSerializedReadings)  // NOLINT
+{
+    ReadingsStorage storage;
+    IDType sensorId = 1;
+    for (unsigned long epoch = 1000; epoch < 2000; epoch += 100)
+    {
+        storage.addReading(sensorId, 20.0, 40.0, epoch);
+    }
+
+    ReadingsQuery query{sensorId};
+    query.from = 1050;
+    query.maxPoints = 100;
+    auto first = storage.getReadings(query);
+    // Starts at the same reading, so the response is the same
+    query.from = 1090;
+    auto second = storage.getReadings(query);
+
+    CHECK_TRUE(first == second);
+    CHECK_EQUAL(9, nlohmann::json::parse(*first)["values"].size());
+}
+
+TEST(ReadingStorageTest, newReadingReplacesSerializedReadings)  // NOLINT
+{
+    ReadingsStorage storage;
+    IDType sensorId = 1;
+    storage.addReading(sensorId, 20.0, 40.0, 1000);
+    auto before = storage.getReadings(ReadingsQuery{sensorId});
+
+    storage.addReading(sensorId, 21.0, 41.0, 1100);
+    auto after = storage.getReadings(ReadingsQuery{sensorId});
+
+    CHECK_TRUE(before != after);
+    CHECK_EQUAL(1, nlohmann::json::parse(*before)["values"].size());
+    CHECK_EQUAL(2, nlohmann::json::parse(*after)["values"].size());
+}
+
+TEST(ReadingStorageTest, readingsOfOtherSensorsKeepSerializedReadings)  // NOLINT
+{
+    ReadingsStorage storage;
+    storage.addReading(1, 20.0, 40.0, 1000);
+    auto before = storage.getReadings(ReadingsQuery{1});
+
+    storage.addReading(2, 21.0, 41.0, 1100);
+
+    CHECK_TRUE(before == storage.getReadings(ReadingsQuery{1}));
+}
+
+TEST(ReadingStorageTest, rollupResponsesAreSharedToo)  // NOLINT
+{
+    ReadingsStorage storage;
+    storage.addReading(1, 20.0, 40.0, 1000);
+    storage.addReading(1, 20.0, 40.0, 5000);
+
+    ReadingsQuery hourly{1, ReadingsQuery::Resolution::HOURLY};
+    auto first = storage.getReadings(hourly);
+    auto second = storage.getReadings(hourly);
+    ReadingsQuery daily{1, ReadingsQuery::Resolution::DAILY};
+    auto otherResolution = storage.getReadings(daily);
+
+    CHECK_TRUE(first == second);
+    CHECK_TRUE(first != otherResolution);
+    CHECK_EQUAL(2, nlohmann::json::parse(*first)["values"].size());
+    CHECK_EQUAL(1, nlohmann::json::parse(*otherResolution)["values"].size());
+}
+
+TEST(ReadingStorageTest, binaryEncodingsCarryTheSameDocument)  // NOLINT
+{
+    ReadingsStorage storage;
+    storage.addReading(1, 21.3, 40.5, 1000);
+    storage.addReading(1, 21.4, 40.25, 1060);
+
+    ReadingsQuery query{1};
+    auto json = nlohmann::json::parse(*storage.getReadings(query));
+    query.encoding = ReadingsQuery::Encoding::CBOR;
+    auto cbor = storage.getReadings(query);
+    query.encoding = ReadingsQuery::Encoding::MSGPACK;
+    auto msgpack = storage.getReadings(query);
+
+    CHECK_TRUE(json == nlohmann::json::from_cbor(*cbor));
+    CHECK_TRUE(json == nlohmann::json::from_msgpack(*msgpack));
+}
+
+TEST(ReadingStorageTest, packedReadingsAreColumnsOfCentiValues)  // NOLINT
+{
+    ReadingsStorage storage;
+    IDType sensorId = 0x0102;
+    storage.addReading(sensorId, -1.5, 40.25, 1000);
+    storage.addReading(sensorId, 21.3, 41.0, 1200);
+
+    ReadingsQuery query{sensorId, ReadingsQuery::Resolution::RAW};
+    query.encoding = ReadingsQuery::Encoding::PACKED;
+    auto packed = storage.getReadings(query);
+
+    // Header, two one byte time deltas, two i16 and two u16 columns, one byte of suspect bits
+    const std::vector<uint8_t> expected{
+        1,    static_cast<uint8_t>(ReadingsQuery::Resolution::RAW), 0, 0,  // version, resolution
+        0x02, 0x01, 0,    0,    0,    0,    0,    0,                       // identifier
+        2,    0,    0,    0,                                               // count
+        0xE8, 0x03, 0,    0,                                               // first epoch 1000
+        3,    0,    0,    0,                                               // time column bytes
+        0,    0xC8, 0x01,                                                  // deltas 0 and 200
+        0x6A, 0xFF, 0x52, 0x08,                                            // -150, 2130
+        0xB9, 0x0F, 0x04, 0x10,                                            // 4025, 4100
+        0};
+    CHECK_EQUAL(expected.size(), packed->size());
+    CHECK_TRUE(std::equal(expected.begin(), expected.end(),
+                          reinterpret_cast<const uint8_t *>(packed->data())));  // NOLINT
+}
+
+TEST(ReadingStorageTest, encodingsAreSharedSeparately)  // NOLINT
+{
+    ReadingsStorage storage;
+    storage.addReading(1, 20.0, 40.0, 1000);
+
+    ReadingsQuery query{1};
+    auto json = storage.getReadings(query);
+    query.encoding = ReadingsQuery::Encoding::PACKED;
+    auto packed = storage.getReadings(query);
+
+    CHECK_TRUE(json != packed);
+    CHECK_TRUE(packed == storage.getReadings(query));
+    CHECK_EQUAL('{', storage.getReadingsAsJsonStr(query).front());
+}
+
+TEST(ReadingStorageTest, readingsETagChangesWithResponse)  // NOLINT
+{
+    ReadingsStorage storage;
+    storage.addReading(1, 20.0, 40.0, 1000);
+    storage.addReading(2, 20.0, 40.0, 1000);
+
+    ReadingsQuery query{1};
+    auto first = storage.getReadingsETag(query);
+    CHECK_TRUE(first == storage.getReadingsETag(query));
+
+    storage.addReading(2, 21.0, 41.0, 1100);
+    CHECK_TRUE(first == storage.getReadingsETag(query));
+
+    query.encoding = ReadingsQuery::Encoding::PACKED;
+    CHECK_TRUE(first != storage.getReadingsETag(query));
+    query.encoding = ReadingsQuery::Encoding::JSON;
+
+    storage.addReading(1, 21.0, 41.0, 1100);
+    CHECK_TRUE(first != storage.getReadingsETag(query));
+
+    CHECK_FALSE(storage.getReadingsETag(ReadingsQuery{3}).has_value());
+}
+
+TEST(ReadingStorageTest, statsOfLastHourAndDay)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    IDType sensorId = 1;
+    storage.addReading(sensorId, 5.0, 80.0, 0);
+    storage.addReading(sensorId, 20.0, 40.0, 80000);
+    storage.addReading(sensorId, 22.0, 50.0, 80060);
+
+    auto results = nlohmann::json::parse(storage.getStatsAsJsonStr(sensorId));
+
+    CHECK_EQUAL(sensorId, results["identifier"]);
+    CHECK_EQUAL(2, results["1h"]["count"]);
+    CHECK_EQUAL(20.0, results["1h"]["temperature"]["min"]);
+    CHECK_EQUAL(22.0, results["1h"]["temperature"]["max"]);
+    CHECK_EQUAL(21.0, results["1h"]["temperature"]["mean"]);
+    CHECK_EQUAL(1.0, results["1h"]["temperature"]["stddev"]);
+    CHECK_EQUAL(3, results["24h"]["count"]);
+    CHECK_EQUAL(5.0, results["24h"]["temperature"]["min"]);
+    CHECK_EQUAL(80.0, results["24h"]["humidity"]["max"]);
+}
+
+TEST(ReadingStorageTest, dailyQuantiles)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    constexpr unsigned long day = 24 * 60 * 60;
+    IDType sensorId = 1;
+    storage.addReading(sensorId, 20.0, 40.0, 100);
+    storage.addReading(sensorId, 22.0, 50.0, 200);
+    storage.addReading(sensorId, 24.0, 60.0, 300);
+    storage.addReading(sensorId, 10.0, 70.0, day + 100);
+
+    auto results = nlohmann::json::parse(storage.getQuantilesAsJsonStr(sensorId));
+
+    auto expected = nlohmann::json::parse(R"([[0, 22.0, 50.0, 20.0, 24.0, 40.0, 60.0, 3],
+                                              [86400, 10.0, 70.0, 10.0, 10.0, 70.0, 70.0, 1]])");
+    CHECK_EQUAL(sensorId, results["identifier"]);
+    CHECK_EQUAL(expected.dump(), results["values"].dump());
+}
+
+TEST(ReadingStorageTest, quantilesOfUnknownSensorAreEmpty)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    auto results = nlohmann::json::parse(storage.getQuantilesAsJsonStr(5));
+
+    CHECK_EQUAL(0, results["values"].size());
+}
+
+TEST(ReadingStorageTest, hourOfDayHeatmap)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    constexpr unsigned long day = 24 * 60 * 60;
+    constexpr unsigned long hour = 60 * 60;
+    IDType sensorId = 1;
+    storage.addReading(sensorId, 21.0, 45.0, 3 * hour);
+    storage.addReading(sensorId, 21.5, 45.0, day + 3 * hour + 60);
+    storage.addReading(sensorId, -30.0, 100.0, 23 * hour);
+
+    auto results = nlohmann::json::parse(storage.getHeatmapAsJsonStr(sensorId));
+
+    auto temperature = results["temperature"];
+    auto humidity = results["humidity"];
+    const int temperatureBins = temperature["bins"];
+    const int humidityBins = humidity["bins"];
+    CHECK_EQUAL(sensorId, results["identifier"]);
+    CHECK_EQUAL(-10, temperature["min"]);
+    CHECK_EQUAL(24 * temperatureBins, temperature["counts"].size());
+    // 21 and 21.5 degrees fall into the 20-22 bin, -30 into the lowest one, 45 percent into the
+    // 40-50 bin
+    CHECK_EQUAL(2, temperature["counts"][3 * temperatureBins + 15]);
+    CHECK_EQUAL(1, temperature["counts"][23 * temperatureBins]);
+    CHECK_EQUAL(2, humidity["counts"][3 * humidityBins + 4]);
+    CHECK_EQUAL(1, humidity["counts"][23 * humidityBins + humidityBins - 1]);
+}
+
+TEST(ReadingStorageTest, heatmapOfUnknownSensorIsNull)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    auto expected = nlohmann::json({{"identifier", 5}, {"humidity", nullptr},
+                                    {"temperature", nullptr}});
+    CHECK_EQUAL(expected.dump(), storage.getHeatmapAsJsonStr(5));
+}
+
+TEST(ReadingStorageTest, statsOfUnknownSensorAreNull)  // NOLINT
+{
+    ReadingsStorage storage;
+
+    auto expected = nlohmann::json({{"identifier", 5}, {"1h", nullptr}, {"24h", nullptr}});
+    CHECK_EQUAL(expected.dump(), storage.getStatsAsJsonStr(5));
+}
+
+namespace
+{
+constexpr unsigned long secondsInHour = 60 * 60;
+constexpr unsigned long fastPeriodSecs = 60;
+constexpr unsigned long slowPeriodSecs = 15 * 60;
+constexpr unsigned long readingsPerBlock = 32;
+
+// Feeds a sensor reporting every minute and one every quarter, returns horizons of their raw
+// readings at the end
+std::pair<unsigned long, unsigned long> rawHorizonsOfFastAndSlowSensor(unsigned long horizonSecs)
+{
+    constexpr unsigned long end = 6 * 24 * secondsInHour;
+    constexpr IDType fastSensor = 1;
+    constexpr IDType slowSensor = 2;
+
+    ReadingsStorage storage;
+    storage.setRawHistoryHorizon(horizonSecs);
+    for (unsigned long epoch = 0; epoch < end; epoch += fastPeriodSecs)
+    {
+        storage.addReading(fastSensor, 20.0, 40.0, epoch);
+        if (epoch % slowPeriodSecs == 0)
+        {
+            storage.addReading(slowSensor, 20.0, 40.0, epoch);
+        }
+    }
+
+    auto firstRawEpoch = [&storage](IDType sensorId)
+    {
+        auto results = nlohmann::json::parse(
+            storage.getReadingsAsJsonStr({sensorId, ReadingsQuery::Resolution::RAW}));
+        return results["values"][0][0].get<unsigned long>();
+    };
+    return {end - firstRawEpoch(fastSensor), end - firstRawEpoch(slowSensor)};
+}
+}  // namespace
+
+TEST(ReadingStorageTest, sensorsCoverConfiguredHorizonWhenPoolIsBigEnough)  // NOLINT
+{
+    constexpr auto horizon = 24 * secondsInHour;
+    auto [fastHorizon, slowHorizon] = rawHorizonsOfFastAndSlowSensor(horizon);
+
+    // Whole blocks are kept, so at most the partially filled one and one more are extra
+    CHECK_TRUE(fastHorizon >= horizon);
+    CHECK_TRUE(fastHorizon <= horizon + 2 * readingsPerBlock * fastPeriodSecs);
+    CHECK_TRUE(slowHorizon >= horizon);
+    CHECK_TRUE(slowHorizon <= horizon + 2 * readingsPerBlock * slowPeriodSecs);
+}
+
+TEST(ReadingStorageTest, sensorsCoverEqualShorterHorizonWhenPoolIsTooSmall)  // NOLINT
+{
+    constexpr auto horizon = 96 * secondsInHour;
+    auto [fastHorizon, slowHorizon] = rawHorizonsOfFastAndSlowSensor(horizon);
+
+    CHECK_TRUE(fastHorizon < horizon);
+    CHECK_TRUE(slowHorizon < horizon);
+    CHECK_TRUE(fastHorizon * 10 >= slowHorizon * 9);
+    CHECK_TRUE(slowHorizon * 10 >= fastHorizon * 9);
+}
+
+TEST(ReadingStorageTest, spikeIsStoredAsSuspectAndLeftOutOfRollupsAndStats)  // NOLINT
+{
+    ReadingsStorage storage;
+    storage.setOutlierThreshold(3.0);
+
+    IDType sensorId = 1;
+    for (auto idx = 0; idx < 10; ++idx)
+    {
+        storage.addReading(sensorId, idx == 8 ? 85.0 : 21.0, 40.0, idx * 60);
+    }
+
+    auto raw = nlohmann::json::parse(storage.getReadingsAsJsonStr(sensorId));
+    CHECK_EQUAL(10, raw["values"].size());
+    CHECK_EQUAL(4, raw["values"][8].size());
+    CHECK_TRUE(raw["values"][8][3].get<bool>());
+    CHECK_EQUAL(3, raw["values"][9].size());
+
+    auto stats = nlohmann::json::parse(storage.getStatsAsJsonStr(sensorId));
+    CHECK_EQUAL(9, stats["1h"]["count"]);
+    CHECK_EQUAL(21.0, stats["1h"]["temperature"]["max"]);
+
+    auto rollup = nlohmann::json::parse(storage.getReadingsAsJsonStr(
+        {sensorId, ReadingsQuery::Resolution::HOURLY, std::nullopt, std::nullopt}));
+    CHECK_EQUAL(9, rollup["values"][0][7]);
+}
+
+TEST(ReadingStorageTest, suspectReadingsAreLeftOutOfDownsampledReadings)  // NOLINT
+{
+    ReadingsStorage storage;
+    storage.setOutlierThreshold(3.0);
+
+    IDType sensorId = 1;
+    for (auto idx = 0; idx < 100; ++idx)
+    {
+        storage.addReading(sensorId, idx == 50 ? -20.0 : 21.0, 40.0, idx * 60);
+    }
+
+    ReadingsQuery query{sensorId, ReadingsQuery::Resolution::RAW};
+    query.maxPoints = 10;
+    auto results = nlohmann::json::parse(storage.getReadingsAsJsonStr(query));
+
+    CHECK_EQUAL(10, results["values"].size());
+    for (const auto &reading : results["values"])
+    {
+        CHECK_EQUAL(21.0, reading[1]);
+    }
+}
+
+TEST(ReadingStorageTest, concurrentReadersGetConsistentReadingsWhileSensorsReport)  // NOLINT
+{
+    // More sensors than the table holds, so readers race with evictions, block reclaims and
+    // rebalancing too
+    constexpr IDType sensorsNum = ConfStorage::maxSensorsNum + 4;
+    constexpr unsigned long rounds = 3000;
+    constexpr unsigned long periodSecs = 60;
+    constexpr std::size_t readersNum = 2;
+
+    // Humidity identifies the sensor and temperature the epoch, so a torn read shows up
+    auto temperatureAt = [](unsigned long epoch) { return ((epoch / periodSecs) % 500) / 10.0; };
+
+    ReadingsStorage storage;
+    std::atomic<bool> done{false};
+    std::thread writer(
+        [&]
+        {
+            for (unsigned long epoch = 0; epoch < rounds * periodSecs; epoch += periodSecs)
+            {
+                for (IDType sensorId = 0; sensorId < sensorsNum; ++sensorId)
+                {
+                    storage.addReading(sensorId, temperatureAt(epoch), sensorId, epoch);
+                }
+            }
+            done.store(true);
+        });
+
+    auto read = [&](std::size_t seed, std::size_t &queries, std::size_t &inconsistent)
+    {
+        for (auto sensorId = static_cast<IDType>(seed); !done.load(); ++sensorId)
+        {
+            sensorId %= sensorsNum;
+            auto raw = nlohmann::json::parse(storage.getReadingsAsJsonStr(sensorId));
+            unsigned long previousEpoch = 0;
+            for (const auto &reading : raw["values"])
+            {
+                auto epoch = reading[0].get<unsigned long>();
+                inconsistent += reading[1] != temperatureAt(epoch) ? 1 : 0;
+                inconsistent += reading[2] != static_cast<double>(sensorId) ? 1 : 0;
+                inconsistent += epoch < previousEpoch ? 1 : 0;
+                previousEpoch = epoch;
+            }
+
+            auto last = nlohmann::json::parse(storage.getLastReadingAsJsonStr(sensorId));
+            for (const auto &reading : last["values"])
+            {
+                inconsistent += reading[2] != static_cast<double>(sensorId) ? 1 : 0;
+            }
+
+            auto hourly = nlohmann::json::parse(storage.getReadingsAsJsonStr(
+                {sensorId, ReadingsQuery::Resolution::HOURLY, std::nullopt, std::nullopt}));
+            for (const auto &bucket : hourly["values"])
+            {
+                inconsistent += bucket[3] > bucket[1] || bucket[1] > bucket[4] ? 1 : 0;
+                inconsistent += bucket[5] != static_cast<double>(sensorId) ? 1 : 0;
+            }
+            ++queries;
+        }
+    };
+
+    std::vector<std::thread> readers;
+    std::vector<std::size_t> queries(readersNum, 0);
+    std::vector<std::size_t> inconsistent(readersNum, 0);
+    for (std::size_t idx = 0; idx < readersNum; ++idx)
+    {
+        readers.emplace_back(read, idx * 7, std::ref(queries[idx]), std::ref(inconsistent[idx]));
+    }
+    writer.join();
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    for (std::size_t idx = 0; idx < readersNum; ++idx)
+    {
+        CHECK_TRUE(queries[idx] > 0);
+        CHECK_EQUAL(0, inconsistent[idx]);
+    }
+}
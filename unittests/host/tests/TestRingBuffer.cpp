@@ -1,5 +1,6 @@
 #include <CppUTest/TestHarness.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "RingBuffer.hpp"
@@ -22,6 +23,12 @@ TEST(RingBufferTest, ReadingLastValueWhenOverload)  // NOLINT
     CHECK_EQUAL(rb.getLast(), 4);
 }
 
+TEST(RingBufferTest, LastOfEmptyBufferIsDefault)  // NOLINT
+{
+    RingBuffer<int, 5> rb;
+    CHECK_EQUAL(0, rb.getLast());
+}
+
 TEST(RingBufferTest, ReadingWithIteratorsNotFullBuffer)  // NOLINT
 {
     RingBuffer<int, 3> rb;
@@ -164,3 +171,124 @@ TEST(RingBufferTest, NumberOfIterationThroughBufferAfterOverride)  // NOLINT
 
     CHECK_EQUAL(3, itNum);
 }
+
+TEST(RingBufferTest, SizeAndEmpty)  // NOLINT
+{
+    RingBuffer<int, 3> rb;
+    CHECK_TRUE(rb.empty());
+    CHECK_EQUAL(0, rb.size());
+
+    rb.put(1);
+    rb.put(2);
+    CHECK_FALSE(rb.empty());
+    CHECK_FALSE(rb.full());
+    CHECK_EQUAL(2, rb.size());
+
+    rb.put(3);
+    rb.put(4);
+    CHECK_TRUE(rb.full());
+    CHECK_EQUAL(3, rb.size());
+
+    rb.clear();
+    CHECK_TRUE(rb.empty());
+    CHECK_TRUE(rb.begin() == rb.end());
+}
+
+TEST(RingBufferTest, IndexFromOldest)  // NOLINT
+{
+    RingBuffer<int, 4> rb;
+    for (auto value = 1; value <= 6; ++value)
+    {
+        rb.put(value);
+    }
+
+    CHECK_EQUAL(3, rb[0]);
+    CHECK_EQUAL(4, rb[1]);
+    CHECK_EQUAL(6, rb[3]);
+    CHECK_EQUAL(6, rb.getLast());
+
+    rb[0] = 10;
+    CHECK_EQUAL(10, *rb.begin());
+}
+
+TEST(RingBufferTest, RandomAccessIterators)  // NOLINT
+{
+    RingBuffer<int, 5> rb;
+    for (auto value = 1; value <= 8; ++value)
+    {
+        rb.put(value * 10);
+    }
+
+    const auto &constRb = rb;
+    auto begin = constRb.begin();
+    auto end = constRb.end();
+
+    CHECK_EQUAL(5, end - begin);
+    CHECK_EQUAL(60, begin[2]);
+    CHECK_EQUAL(80, *(end - 1));
+    CHECK_EQUAL(50, *(--(begin + 2)));
+    CHECK_TRUE(begin < end);
+
+    auto found = std::lower_bound(begin, end, 65);
+    CHECK_EQUAL(70, *found);
+    CHECK_EQUAL(3, found - begin);
+
+    RingBuffer<int, 5>::const_iterator converted = rb.begin();
+    CHECK_TRUE(converted == constRb.begin());
+}
+
+TEST(RingBufferTest, SpansCoverAllElementsInOrder)  // NOLINT
+{
+    RingBuffer<int, 4> rb;
+    rb.put(1);
+    rb.put(2);
+
+    auto spans = rb.spans();
+    CHECK_EQUAL(2, spans[0].size);
+    CHECK_EQUAL(0, spans[1].size);
+
+    rb.put(3);
+    rb.put(4);
+    rb.put(5);
+    rb.put(6);
+
+    std::vector<int> values;
+    for (const auto &span : rb.spans())
+    {
+        values.insert(values.end(), span.begin(), span.end());
+    }
+
+    CHECK_TRUE((std::vector<int>{3, 4, 5, 6}) == values);
+    CHECK_EQUAL(2, rb.spans()[0].size);
+}
+
+TEST(RingBufferTest, PutNIsSameAsPuttingOneByOne)  // NOLINT
+{
+    std::vector<int> values;
+    for (auto value = 0; value < 20; ++value)
+    {
+        values.push_back(value);
+    }
+
+    for (std::size_t prefill = 0; prefill < 8; ++prefill)
+    {
+        for (std::size_t count = 0; count <= values.size(); ++count)
+        {
+            RingBuffer<int, 7> bulk;
+            RingBuffer<int, 7> single;
+            for (std::size_t idx = 0; idx < prefill; ++idx)
+            {
+                bulk.put(-1);
+                single.put(-1);
+            }
+
+            bulk.putN(values.data(), count);
+            for (std::size_t idx = 0; idx < count; ++idx)
+            {
+                single.put(values[idx]);
+            }
+
+            CHECK_TRUE(std::equal(bulk.begin(), bulk.end(), single.begin(), single.end()));
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include <CppUTest/TestHarness.h>
+
+#include "SenderRateLimiter.hpp"
+
+// clang-format off
+TEST_GROUP(SenderRateLimiterTest)  // NOLINT
+{
+};
+// clang-format on
+
+namespace
+{
+constexpr uint32_t refillIntervalMs = 1000;
+constexpr float burst = 2;
+
+MacAddr macOf(uint8_t idx)
+{
+    return MacAddr{{0x10, 0x20, 0x30, 0x40, 0x50, idx}};
+}
+}  // namespace
+
+TEST(SenderRateLimiterTest, EverythingIsAdmittedWithoutRate)  // NOLINT
+{
+    SenderRateLimiter<2> limiter;
+
+    for (int idx = 0; idx < 100; ++idx)
+    {
+        CHECK_TRUE(limiter.admit(macOf(1), 0));
+    }
+}
+
+TEST(SenderRateLimiterTest, BurstThenOneFramePerInterval)  // NOLINT
+{
+    SenderRateLimiter<2> limiter;
+    limiter.setRate(refillIntervalMs, burst);
+
+    CHECK_TRUE(limiter.admit(macOf(1), 0));
+    CHECK_TRUE(limiter.admit(macOf(1), 0));
+    CHECK_FALSE(limiter.admit(macOf(1), 500));
+    CHECK_TRUE(limiter.admit(macOf(1), 1000));
+    CHECK_FALSE(limiter.admit(macOf(1), 1000));
+
+    CHECK_EQUAL(2, limiter.throttled(macOf(1)));
+    CHECK_EQUAL(2, limiter.throttledTotal());
+}
+
+TEST(SenderRateLimiterTest, RefillSurvivesMillisWrapAround)  // NOLINT
+{
+    constexpr uint32_t beforeWrap = 0xFFFFFFFF - 499;
+    SenderRateLimiter<2> limiter;
+    limiter.setRate(refillIntervalMs, burst);
+
+    CHECK_TRUE(limiter.admit(macOf(1), beforeWrap));
+    CHECK_TRUE(limiter.admit(macOf(1), beforeWrap));
+    CHECK_FALSE(limiter.admit(macOf(1), beforeWrap));
+
+    CHECK_TRUE(limiter.admit(macOf(1), 500));
+}
+
+TEST(SenderRateLimiterTest, SendersWithoutSlotShareOneBucket)  // NOLINT
+{
+    SenderRateLimiter<2> limiter;
+    limiter.setRate(refillIntervalMs, burst);
+    limiter.admit(macOf(1), 0);
+    limiter.admit(macOf(2), 0);
+
+    CHECK_TRUE(limiter.admit(macOf(3), 0));
+    CHECK_TRUE(limiter.admit(macOf(4), 0));
+    CHECK_FALSE(limiter.admit(macOf(5), 0));
+
+    CHECK_EQUAL(0, limiter.throttled(macOf(5)));
+    CHECK_EQUAL(1, limiter.throttledTotal());
+}
+
+TEST(SenderRateLimiterTest, SlotOfQuietSenderIsReused)  // NOLINT
+{
+    SenderRateLimiter<1> limiter;
+    limiter.setRate(refillIntervalMs, burst);
+    limiter.admit(macOf(1), 0);
+    limiter.admit(macOf(1), 0);
+    limiter.admit(macOf(1), 0);
+
+    // Sender 1 refilled its bucket, so the new sender takes its slot and a full bucket
+    CHECK_TRUE(limiter.admit(macOf(2), 2000));
+    CHECK_TRUE(limiter.admit(macOf(2), 2000));
+    CHECK_FALSE(limiter.admit(macOf(2), 2000));
+    CHECK_EQUAL(1, limiter.throttled(macOf(2)));
+    CHECK_EQUAL(0, limiter.throttled(macOf(1)));
+}
+
+TEST(SenderRateLimiterTest, ThrottledSendersAreReportedOnce)  // NOLINT
+{
+    SenderRateLimiter<2> limiter;
+    limiter.setRate(refillIntervalMs, burst);
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        limiter.admit(macOf(1), 0);
+        limiter.admit(macOf(2), 0);
+    }
+    limiter.admit(macOf(2), 0);
+
+    int reports = 0;
+    uint32_t throttledOfSecond = 0;
+    limiter.reportThrottled(
+        [&](const auto &sender)
+        {
+            ++reports;
+            if (sender.mac == macOf(2))
+            {
+                throttledOfSecond = sender.throttled;
+            }
+        });
+    limiter.reportThrottled([&reports]([[maybe_unused]] const auto &sender) { ++reports; });
+
+    CHECK_EQUAL(2, reports);
+    CHECK_EQUAL(3, throttledOfSecond);
+}
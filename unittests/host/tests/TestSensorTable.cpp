@@ -0,0 +1,110 @@
+#include <CppUTest/TestHarness.h>
+
+#include <cstdlib>
+#include <map>
+
+#include "SensorTable.hpp"
+
+// clang-format off
+TEST_GROUP(SensorTableTest)  // NOLINT
+{
+};
+// clang-format on
+
+TEST(SensorTableTest, FindDoesNotInsert)  // NOLINT
+{
+    SensorTable<int, 4> table;
+
+    CHECK_TRUE(table.find(123) == nullptr);
+    CHECK_EQUAL(0, table.size());
+}
+
+TEST(SensorTableTest, InsertReturnsExistingValue)  // NOLINT
+{
+    SensorTable<int, 4> table;
+    *table.insert(123) = 5;
+
+    CHECK_EQUAL(5, *table.insert(123));
+    CHECK_EQUAL(5, *table.find(123));
+    CHECK_EQUAL(1, table.size());
+}
+
+TEST(SensorTableTest, InsertFailsWhenFull)  // NOLINT
+{
+    SensorTable<int, 3> table;
+    *table.insert(1) = 1;
+    *table.insert(2) = 2;
+    *table.insert(3) = 3;
+
+    CHECK_TRUE(table.full());
+    CHECK_TRUE(table.insert(4) == nullptr);
+    CHECK_EQUAL(3, *table.find(3));
+}
+
+TEST(SensorTableTest, ErasedValueIsResetAndSpaceReused)  // NOLINT
+{
+    SensorTable<int, 2> table;
+    *table.insert(1) = 1;
+    *table.insert(2) = 2;
+
+    CHECK_TRUE(table.erase(1));
+    CHECK_FALSE(table.erase(1));
+    CHECK_TRUE(table.find(1) == nullptr);
+    CHECK_EQUAL(0, *table.insert(3));
+    CHECK_EQUAL(2, *table.find(2));
+}
+
+TEST(SensorTableTest, ErasedValueIsResetInPlace)  // NOLINT
+{
+    struct Unassignable
+    {
+        int value{0};
+
+        Unassignable() = default;
+        Unassignable(const Unassignable &) = delete;
+        Unassignable &operator=(const Unassignable &) = delete;
+    };
+
+    SensorTable<Unassignable, 1> table;
+    auto *value = table.insert(1);
+    value->value = 5;
+
+    CHECK_TRUE(table.erase(1));
+    CHECK_TRUE(value == table.insert(2));
+    CHECK_EQUAL(0, value->value);
+}
+
+TEST(SensorTableTest, BehavesLikeMapUnderRandomOperations)  // NOLINT
+{
+    constexpr std::size_t capacity = 7;
+    SensorTable<IDType, capacity> table;
+    std::map<IDType, IDType> reference;
+
+    std::srand(1);
+    for (auto step = 0; step < 20000; ++step)
+    {
+        // Small key space forces collisions, removals and reinsertions
+        IDType identifier = std::rand() % 24;
+        if (std::rand() % 3 == 0)
+        {
+            CHECK_EQUAL(reference.erase(identifier) == 1, table.erase(identifier));
+        }
+        else if (reference.count(identifier) == 1 || reference.size() < capacity)
+        {
+            *table.insert(identifier) = identifier * 10;
+            reference[identifier] = identifier * 10;
+        }
+
+        CHECK_EQUAL(reference.size(), table.size());
+    }
+
+    for (IDType identifier = 0; identifier < 24; ++identifier)
+    {
+        auto *value = table.find(identifier);
+        CHECK_EQUAL(reference.count(identifier) == 1, value != nullptr);
+        if (value != nullptr)
+        {
+            CHECK_EQUAL(reference[identifier], *value);
+        }
+    }
+}
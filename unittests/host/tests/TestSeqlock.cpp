@@ -0,0 +1,74 @@
+#include <CppUTest/TestHarness.h>
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <thread>
+
+#include "Seqlock.hpp"
+
+// clang-format off
+TEST_GROUP(SeqlockTest)  // NOLINT
+{
+};
+// clang-format on
+
+TEST(SeqlockTest, ReadReturnsResultOfSection)  // NOLINT
+{
+    Seqlock seqlock;
+    int value = 0;
+    seqlock.write([&value] { value = 42; });
+
+    CHECK_EQUAL(42, seqlock.read([&value] { return value; }));
+}
+
+TEST(SeqlockTest, FinishedWritesAreCounted)  // NOLINT
+{
+    Seqlock seqlock;
+    CHECK_EQUAL(0, seqlock.writes());
+
+    seqlock.write([] {});
+    seqlock.write([] {});
+
+    CHECK_EQUAL(2, seqlock.writes());
+}
+
+TEST(SeqlockTest, ConcurrentReadersNeverSeeHalfWrittenData)  // NOLINT
+{
+    constexpr uint32_t writesNum = 100000;
+    Seqlock seqlock;
+    std::array<uint32_t, 32> words{};
+    std::atomic<bool> done{false};
+
+    std::thread writer(
+        [&]
+        {
+            for (uint32_t sequence = 1; sequence <= writesNum; ++sequence)
+            {
+                seqlock.write([&words, sequence] { words.fill(sequence); });
+            }
+            done.store(true);
+        });
+
+    uint32_t reads = 0;
+    uint32_t torn = 0;
+    uint32_t lastSequence = 0;
+    uint32_t reordered = 0;
+    while (!done.load())
+    {
+        auto copy = seqlock.read([&words] { return words; });
+        for (auto word : copy)
+        {
+            torn += word != copy[0] ? 1 : 0;
+        }
+        reordered += copy[0] < lastSequence ? 1 : 0;
+        lastSequence = copy[0];
+        ++reads;
+    }
+    writer.join();
+
+    CHECK_EQUAL(0, torn);
+    CHECK_EQUAL(0, reordered);
+    CHECK_TRUE(reads > 0);
+    CHECK_EQUAL(writesNum, seqlock.writes());
+}
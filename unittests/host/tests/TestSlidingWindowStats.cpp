@@ -0,0 +1,129 @@
+#include <CppUTest/TestHarness.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "SlidingWindowStats.hpp"
+
+// clang-format off
+TEST_GROUP(SlidingWindowStatsTest)  // NOLINT
+{
+};
+// clang-format on
+
+constexpr auto statsTolerance = 0.0001;
+
+TEST(SlidingWindowStatsTest, NoStatsWithoutReadings)  // NOLINT
+{
+    SlidingWindowStats<3600, 6> stats;
+
+    CHECK_FALSE(stats.stats().has_value());
+}
+
+TEST(SlidingWindowStatsTest, MinMaxMeanAndStddev)  // NOLINT
+{
+    SlidingWindowStats<3600, 6> stats;
+    stats.add(20.0, 40.0, 0);
+    stats.add(22.0, 50.0, 700);
+    stats.add(24.0, 60.0, 1400);
+    stats.add(26.0, 70.0, 2100);
+
+    auto result = stats.stats().value();
+
+    CHECK_EQUAL(4, result.count);
+    CHECK_EQUAL(20.0, result.temperature.min);
+    CHECK_EQUAL(26.0, result.temperature.max);
+    DOUBLES_EQUAL(23.0, result.temperature.mean, statsTolerance);
+    DOUBLES_EQUAL(std::sqrt(5.0), result.temperature.stddev, statsTolerance);
+    CHECK_EQUAL(40.0, result.humidity.min);
+    CHECK_EQUAL(70.0, result.humidity.max);
+    DOUBLES_EQUAL(55.0, result.humidity.mean, statsTolerance);
+}
+
+TEST(SlidingWindowStatsTest, OldReadingsLeaveTheWindow)  // NOLINT
+{
+    SlidingWindowStats<3600, 6> stats;
+    stats.add(-10.0, 90.0, 0);
+    stats.add(30.0, 10.0, 600);
+    stats.add(20.0, 50.0, 3599);
+
+    CHECK_EQUAL(-10.0, stats.stats()->temperature.min);
+
+    stats.add(21.0, 51.0, 3600);
+    auto result = stats.stats().value();
+
+    CHECK_EQUAL(3, result.count);
+    CHECK_EQUAL(20.0, result.temperature.min);
+    CHECK_EQUAL(30.0, result.temperature.max);
+    CHECK_EQUAL(51.0, result.humidity.max);
+
+    stats.add(22.0, 52.0, 4200);
+    result = stats.stats().value();
+
+    CHECK_EQUAL(3, result.count);
+    CHECK_EQUAL(22.0, result.temperature.max);
+    CHECK_EQUAL(50.0, result.humidity.min);
+}
+
+TEST(SlidingWindowStatsTest, LongGapClearsWindow)  // NOLINT
+{
+    SlidingWindowStats<3600, 6> stats;
+    stats.add(-10.0, 90.0, 0);
+    stats.add(30.0, 10.0, 600);
+    stats.add(20.0, 50.0, 86400);
+
+    auto result = stats.stats().value();
+    CHECK_EQUAL(1, result.count);
+    CHECK_EQUAL(20.0, result.temperature.min);
+    CHECK_EQUAL(20.0, result.temperature.max);
+    DOUBLES_EQUAL(0.0, result.temperature.stddev, statsTolerance);
+}
+
+TEST(SlidingWindowStatsTest, MatchesFullScanOverSlotAlignedWindow)  // NOLINT
+{
+    constexpr uint32_t window = 24 * 60 * 60;
+    constexpr uint16_t slots = 24;
+    constexpr uint32_t slotSeconds = window / slots;
+    SlidingWindowStats<window, slots> stats;
+
+    struct Reading
+    {
+        unsigned long epochTime;
+        double temperature;
+    };
+    std::vector<Reading> readings;
+
+    std::srand(2);
+    unsigned long epoch = 1700000000;
+    for (auto idx = 0; idx < 5000; ++idx)
+    {
+        epoch += 30 + std::rand() % 120;
+        auto temperature = static_cast<float>(std::rand() % 6000 - 2000) / 100;
+        stats.add(temperature, 50.0, epoch);
+        readings.push_back({epoch, temperature});
+
+        auto windowStart = epoch - epoch % slotSeconds - (window - slotSeconds);
+        double min = 1000;
+        double max = -1000;
+        double sum = 0;
+        uint32_t count = 0;
+        for (const auto &reading : readings)
+        {
+            if (reading.epochTime >= windowStart)
+            {
+                min = std::min(min, reading.temperature);
+                max = std::max(max, reading.temperature);
+                sum += reading.temperature;
+                ++count;
+            }
+        }
+
+        auto result = stats.stats().value();
+        CHECK_EQUAL(count, result.count);
+        DOUBLES_EQUAL(min, result.temperature.min, statsTolerance);
+        DOUBLES_EQUAL(max, result.temperature.max, statsTolerance);
+        DOUBLES_EQUAL(sum / count, result.temperature.mean, statsTolerance);
+    }
+}
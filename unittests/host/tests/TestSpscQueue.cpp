@@ -0,0 +1,179 @@
+#include <CppUTest/TestHarness.h>
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <thread>
+#include <vector>
+
+#include "SpscQueue.hpp"
+
+// clang-format off
+TEST_GROUP(SpscQueueTest)  // NOLINT
+{
+};
+// clang-format on
+
+TEST(SpscQueueTest, PoppedInPushOrder)  // NOLINT
+{
+    SpscQueue<int, 4> queue;
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    int value = 0;
+    CHECK_TRUE(queue.pop(value));
+    CHECK_EQUAL(1, value);
+    CHECK_TRUE(queue.pop(value));
+    CHECK_EQUAL(2, value);
+    CHECK_EQUAL(1, queue.size());
+}
+
+TEST(SpscQueueTest, PopFromEmptyQueueFails)  // NOLINT
+{
+    SpscQueue<int, 4> queue;
+    int value = 5;
+
+    CHECK_FALSE(queue.pop(value));
+    CHECK_EQUAL(5, value);
+    CHECK_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, PushToFullQueueFails)  // NOLINT
+{
+    SpscQueue<int, 4> queue;
+    for (auto idx = 0; idx < 4; ++idx)
+    {
+        CHECK_TRUE(queue.push(idx));
+    }
+
+    CHECK_FALSE(queue.push(4));
+    CHECK_FALSE(queue.pushWith([](int &) { FAIL("Full queue shouldn't fill a slot"); }));
+    CHECK_EQUAL(4, queue.size());
+}
+
+TEST(SpscQueueTest, SlotsAreReusedAfterWrapping)  // NOLINT
+{
+    SpscQueue<int, 4> queue;
+    std::vector<int> consumed;
+    for (auto idx = 0; idx < 10; ++idx)
+    {
+        queue.push(idx);
+        queue.push(idx + 100);
+        queue.consume([&consumed](int value) { consumed.push_back(value); });
+    }
+
+    CHECK_EQUAL(20, consumed.size());
+    CHECK_EQUAL(9, consumed[18]);
+    CHECK_EQUAL(109, consumed[19]);
+}
+
+TEST(SpscQueueTest, ConsumeTakesAtMostRequestedNumberOfElements)  // NOLINT
+{
+    SpscQueue<int, 8> queue;
+    for (auto idx = 0; idx < 6; ++idx)
+    {
+        queue.push(idx);
+    }
+
+    std::vector<int> consumed;
+    CHECK_EQUAL(4, queue.consume([&consumed](int value) { consumed.push_back(value); }, 4));
+    CHECK_EQUAL(2, queue.consume([&consumed](int value) { consumed.push_back(value); }, 4));
+    CHECK_EQUAL(0, queue.consume([&consumed](int value) { consumed.push_back(value); }, 4));
+    CHECK_EQUAL(6, consumed.size());
+    CHECK_EQUAL(5, consumed.back());
+}
+
+TEST(SpscQueueTest, ConcurrentProducerAndConsumerNeitherLoseNorReorderElements)  // NOLINT
+{
+    // Big elements make a torn slot visible, every word has to match the sequence number
+    struct Element
+    {
+        std::array<uint32_t, 16> words;
+    };
+    constexpr uint32_t elementsNum = 200000;
+
+    SpscQueue<Element, 16> queue;
+    std::atomic<uint32_t> dropped{0};
+
+    std::thread producer(
+        [&]
+        {
+            for (uint32_t sequence = 0; sequence < elementsNum; ++sequence)
+            {
+                auto pushed = queue.pushWith([sequence](Element &element)
+                                             { element.words.fill(sequence); });
+                if (!pushed)
+                {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+
+    uint32_t consumed = 0;
+    uint32_t torn = 0;
+    uint32_t reordered = 0;
+    int64_t lastSequence = -1;
+    auto check = [&](const Element &element)
+    {
+        for (auto word : element.words)
+        {
+            torn += word != element.words[0] ? 1 : 0;
+        }
+        reordered += static_cast<int64_t>(element.words[0]) <= lastSequence ? 1 : 0;
+        lastSequence = element.words[0];
+        ++consumed;
+    };
+
+    while (consumed + dropped.load() < elementsNum)
+    {
+        if (queue.consume(check, 4) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    queue.consume(check);
+
+    CHECK_EQUAL(0, torn);
+    CHECK_EQUAL(0, reordered);
+    CHECK_EQUAL(elementsNum, consumed + dropped.load());
+}
+
+TEST(SpscQueueTest, ConcurrentProducerRetryingOnFullQueueDeliversEverything)  // NOLINT
+{
+    constexpr uint32_t elementsNum = 200000;
+    SpscQueue<uint32_t, 8> queue;
+
+    std::thread producer(
+        [&]
+        {
+            for (uint32_t sequence = 0; sequence < elementsNum; ++sequence)
+            {
+                while (!queue.push(sequence))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    uint32_t expected = 0;
+    uint32_t mismatches = 0;
+    while (expected < elementsNum)
+    {
+        auto consumed = queue.consume(
+            [&](uint32_t value)
+            {
+                mismatches += value != expected ? 1 : 0;
+                ++expected;
+            });
+        if (consumed == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    CHECK_EQUAL(0, mismatches);
+    CHECK_TRUE(queue.empty());
+}
@@ -42,7 +42,21 @@ TEST_GROUP(WebPageMainTest)  // NOLINT
         mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/logout");
         mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/sensorIDsToNames");
         mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/configuration");
+        mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/sensorData/all");
         mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/sensorData");
+        mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/stats");
+        mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/quantiles");
+        mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/heatmap");
+        mock("WebServerMock").expectOneCall("onGet").withParameter("url", "/archive");
+    }
+
+    // Readings are encoded as the Accept header asks
+    static void expectVaryOnAccept()
+    {
+        mock("WebRequestMock")
+            .expectOneCall("addHeader")
+            .withParameter("name", "Vary")
+            .withParameter("value", "Accept");
     }
 
     void mockAuthentication(bool authenticate)
@@ -62,9 +76,9 @@ TEST_GROUP(WebPageMainTest)  // NOLINT
         mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
 
         webPageMain.startServer(
-            []([[maybe_unused]] const std::size_t &identifier)
+            []([[maybe_unused]] const ReadingsQuery &query)
             {
-                return R"({"some": "data"})";
+                return std::make_shared<const std::string>(R"({"some": "data"})");
             });
     }
 
@@ -74,6 +88,7 @@ TEST_GROUP(WebPageMainTest)  // NOLINT
 };
 
 constexpr static auto HTML_OK = 200;
+constexpr static auto HTML_NOT_MODIFIED = 304;
 constexpr static auto HTML_BAD_REQ = 400;
 constexpr static auto HTML_UNAUTH = 401;
 constexpr static auto HTML_NOT_FOUND = 404;
@@ -248,7 +263,7 @@ TEST(WebPageMainTest, ActionSetCredentialsWhenAuthenticated)  // NOLINT
         .withParameter("pass", "pass")
         .withParameter("user", "user");
 
-    mock("ConfStorageMock").expectOneCall("save");
+    mock("ConfStorageMock").expectOneCall("requestSave");
     mock("WebRequestMock")
         .expectOneCall("send")
         .withParameter("code", HTML_OK)
@@ -405,7 +420,7 @@ TEST(WebPageMainTest, UpdateSensorsMappingWhenAuthorized)  // NOLINT
     mockAuthentication(true);
 
     mock("ConfStorageMock").expectNCalls(3, "addSensor").ignoreOtherParameters();
-    mock("ConfStorageMock").expectNCalls(3, "save");
+    mock("ConfStorageMock").expectOneCall("requestSave");
 
     mock("WebRequestMock")
         .expectOneCall("send")
@@ -498,7 +513,7 @@ TEST(WebPageMainTest, UpdateSensorsMappingOnlyForCorrectOne)  // NOLINT
         .expectNCalls(1, "addSensor")
         .withParameter("identifier", 123456)
         .withParameter("name", "correct sensor");
-    mock("ConfStorageMock").expectNCalls(1, "save");
+    mock("ConfStorageMock").expectOneCall("requestSave");
     mock("WebRequestMock")
         .expectOneCall("send")
         .withParameter("code", HTML_OK)
@@ -528,7 +543,7 @@ TEST(WebPageMainTest, SetPropertiesWhenAuthorizedAndCorrectDataIncoming)  // NOL
 
     mock("ConfStorageMock").expectOneCall("setSensorUpdatePeriodMins").withParameter("minutes", 11);
     mock("ConfStorageMock").expectOneCall("setServerPort").withParameter("port", 22);
-    mock("ConfStorageMock").expectOneCall("save");
+    mock("ConfStorageMock").expectOneCall("requestSave");
     mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_OK);
 
     startServerMock(sut);
@@ -537,6 +552,54 @@ TEST(WebPageMainTest, SetPropertiesWhenAuthorizedAndCorrectDataIncoming)  // NOL
     webServerMock->callPostWithBody("/setProperties", webRequestMock, incomingProperties.dump());
 }
 
+TEST(WebPageMainTest, SetOutlierThresholdWithProperties)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    auto incomingProperties = nlohmann::json({
+        {"sensorUpdatePeriodMins", 11},
+        {"serverPort", 22},
+        {"outlierThreshold", 2.5},
+    });
+
+    mockOnGetAndOnPostCalls();
+    mockAuthentication(true);
+
+    mock("ConfStorageMock").expectOneCall("setSensorUpdatePeriodMins").withParameter("minutes", 11);
+    mock("ConfStorageMock").expectOneCall("setServerPort").withParameter("port", 22);
+    mock("ConfStorageMock").expectOneCall("setOutlierThreshold").withParameter("threshold", 2.5);
+    mock("ConfStorageMock").expectOneCall("requestSave");
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_OK);
+
+    startServerMock(sut);
+
+    WebRequestMock webRequestMock;
+    webServerMock->callPostWithBody("/setProperties", webRequestMock, incomingProperties.dump());
+}
+
+TEST(WebPageMainTest, NotSetPropertiesWhenOutlierThresholdIsNegative)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    auto incomingProperties = nlohmann::json({
+        {"sensorUpdatePeriodMins", 11},
+        {"serverPort", 22},
+        {"outlierThreshold", -1},
+    });
+
+    mockOnGetAndOnPostCalls();
+    mockAuthentication(true);
+
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_BAD_REQ);
+
+    startServerMock(sut);
+
+    WebRequestMock webRequestMock;
+    webServerMock->callPostWithBody("/setProperties", webRequestMock, incomingProperties.dump());
+}
+
 TEST(WebPageMainTest, NotSetPropertiesWhenWrongTypeOfData)  // NOLINT
 {
     WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
@@ -608,7 +671,7 @@ TEST(WebPageMainTest, RemoveSensorWhenAuthorizedAndCorrectDataIncoming)  // NOLI
     mockAuthentication(true);
 
     mock("ConfStorageMock").expectOneCall("removeSensor").withParameter("identifier", 1);
-    mock("ConfStorageMock").expectOneCall("save");
+    mock("ConfStorageMock").expectOneCall("requestSave");
     mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_OK);
 
     startServerMock(sut);
@@ -722,6 +785,12 @@ TEST(WebPageMainTest, sensorIDsToNames)  // NOLINT
 
     auto sensorsMappingStr = sensorsMapping.dump();
 
+    mock("ConfStorageMock").expectOneCall("getSensorsVersion").andReturnValue(3U);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "If-None-Match");
+    mock("WebRequestMock")
+        .expectOneCall("addHeader")
+        .withParameter("name", "ETag")
+        .withParameter("value", R"("00000000-s3")");
     mock("ConfStorageMock")
         .expectOneCall("getSensorsMapping")
         .andReturnValue(sensorsMappingStr.c_str());
@@ -752,6 +821,12 @@ TEST(WebPageMainTest, getConfigurationWhenAuthorized)  // NOLINT
 
     auto someConfigurationStr = someConfiguration.dump();
 
+    mock("ConfStorageMock").expectOneCall("getConfigVersion").andReturnValue(5U);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "If-None-Match");
+    mock("WebRequestMock")
+        .expectOneCall("addHeader")
+        .withParameter("name", "ETag")
+        .withParameter("value", R"("00000000-c5")");
     mock("ConfStorageMock")
         .expectOneCall("getConfigWithoutCredentials")
         .andReturnValue(someConfigurationStr.c_str());
@@ -767,6 +842,115 @@ TEST(WebPageMainTest, getConfigurationWhenAuthorized)  // NOLINT
     webServerMock->callGet("/configuration", webRequestMock);
 }
 
+TEST(WebPageMainTest, sensorIDsToNamesNotModifiedWhenClientHasCurrentVersion)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock, 0xABCD);
+
+    mockOnGetAndOnPostCalls();
+
+    std::string ifNoneMatch = R"("0000abcd-s2", W/"0000abcd-s3")";
+
+    mock("ConfStorageMock").expectOneCall("getSensorsVersion").andReturnValue(3U);
+    mock("WebRequestMock")
+        .expectOneCall("getHeader")
+        .withParameter("name", "If-None-Match")
+        .andReturnValue(&ifNoneMatch);
+    mock("WebRequestMock")
+        .expectOneCall("addHeader")
+        .withParameter("name", "ETag")
+        .withParameter("value", R"("0000abcd-s3")");
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_NOT_MODIFIED);
+
+    startServerMock(sut);
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorIDsToNames", webRequestMock);
+}
+
+TEST(WebPageMainTest, getSensorDataNotModifiedWhenClientHasCurrentVersion)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock, 1);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"identifier", "123"}};
+    std::string ifNoneMatch = R"("00000001-readings")";
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
+    mock("WebRequestMock")
+        .expectOneCall("getHeader")
+        .withParameter("name", "If-None-Match")
+        .andReturnValue(&ifNoneMatch);
+    mock("WebRequestMock")
+        .expectOneCall("addHeader")
+        .withParameter("name", "ETag")
+        .withParameter("value", ifNoneMatch.c_str());
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_NOT_MODIFIED);
+
+    sut.startServer(
+        []([[maybe_unused]] const ReadingsQuery &query) -> std::shared_ptr<const std::string>
+        {
+            FAIL("readings aren't serialized for a current copy");
+            return nullptr;
+        },
+        {}, {}, {}, {},
+        [](const ReadingsQuery &query) -> std::optional<std::string>
+        {
+            CHECK_EQUAL(123, query.identifier);
+            return "readings";
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+}
+
+TEST(WebPageMainTest, getSensorDataTaggedWithVersion)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock, 1);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams
+        = {{"identifier", "123"}, {"maxPoints", "300"}};
+    std::string ifNoneMatch = R"("00000001-older")";
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
+    mock("WebRequestMock")
+        .expectOneCall("getHeader")
+        .withParameter("name", "If-None-Match")
+        .andReturnValue(&ifNoneMatch);
+    mock("WebRequestMock")
+        .expectOneCall("addHeader")
+        .withParameter("name", "ETag")
+        .withParameter("value", R"("00000001-readings")");
+    mock("WebRequestMock")
+        .expectOneCall("send")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json")
+        .withParameter("content", R"({"some": "data"})");
+
+    sut.startServer(
+        []([[maybe_unused]] const ReadingsQuery &query)
+        { return std::make_shared<const std::string>(R"({"some": "data"})"); },
+        {}, {}, {}, {},
+        []([[maybe_unused]] const ReadingsQuery &query) -> std::optional<std::string>
+        { return "readings"; });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+}
+
 TEST(WebPageMainTest, getSensorDataForSensor)  // NOLINT
 {
     WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
@@ -779,6 +963,8 @@ TEST(WebPageMainTest, getSensorDataForSensor)  // NOLINT
     mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
     mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
     mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
     mock("WebRequestMock")
         .expectOneCall("send")
         .withParameter("code", HTML_OK)
@@ -786,9 +972,9 @@ TEST(WebPageMainTest, getSensorDataForSensor)  // NOLINT
         .withParameter("content", R"({"some": "data"})");
 
     sut.startServer(
-        []([[maybe_unused]] const std::size_t &identifier)
+        []([[maybe_unused]] const ReadingsQuery &query)
         {
-            return R"({"some": "data"})";
+            return std::make_shared<const std::string>(R"({"some": "data"})");
         });
 
     WebRequestMock webRequestMock;
@@ -810,9 +996,9 @@ TEST(WebPageMainTest, NotGetSensorDataWhenNoIdentifierParameter)  // NOLINT
     mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_BAD_REQ);
 
     sut.startServer(
-        []([[maybe_unused]] const std::size_t &identifier)
+        []([[maybe_unused]] const ReadingsQuery &query)
         {
-            return R"({"some": "data"})";
+            return std::make_shared<const std::string>(R"({"some": "data"})");
         });
 
     WebRequestMock webRequestMock;
@@ -835,11 +1021,518 @@ TEST(WebPageMainTest, NotGetSensorDataWhenParameterIsWrong)  // NOLINT
     mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_BAD_REQ);
 
     sut.startServer(
-        []([[maybe_unused]] const std::size_t &identifier)
+        []([[maybe_unused]] const ReadingsQuery &query)
+        {
+            return std::make_shared<const std::string>(R"({"some": "data"})");
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+}
+
+TEST(WebPageMainTest, getSensorDataPassesResolutionAndTimeRange)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams
+        = {{"identifier", "123"}, {"resolution", "hour"}, {"from", "1000"}, {"to", "2000"},
+           {"maxPoints", "300"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
+    mock("WebRequestMock")
+        .expectOneCall("send")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json")
+        .withParameter("content", R"({"some": "data"})");
+
+    ReadingsQuery receivedQuery{};
+    sut.startServer(
+        [&receivedQuery](const ReadingsQuery &query)
+        {
+            receivedQuery = query;
+            return std::make_shared<const std::string>(R"({"some": "data"})");
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+
+    CHECK_EQUAL(123, receivedQuery.identifier);
+    CHECK_TRUE(receivedQuery.resolution == ReadingsQuery::Resolution::HOURLY);
+    CHECK_EQUAL(1000, receivedQuery.from.value());
+    CHECK_EQUAL(2000, receivedQuery.to.value());
+    CHECK_EQUAL(300, receivedQuery.maxPoints.value());
+}
+
+TEST(WebPageMainTest, getSensorDataStreamsSelectionWithoutMaxPoints)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"identifier", "123"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
+    mock("WebRequestMock")
+        .expectOneCall("sendChunked")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json");
+
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query) { return nullptr; }, {}, {},
+                    {},
+                    []([[maybe_unused]] const ReadingsQuery &query) -> IWebRequest::Filler
+                    {
+                        auto sent = std::make_shared<bool>(false);
+                        return [sent](uint8_t *buffer, std::size_t maxLen) -> std::size_t
+                        {
+                            if (*sent || maxLen < 2)
+                            {
+                                return 0;
+                            }
+                            *sent = true;
+                            buffer[0] = '{';  // NOLINT
+                            buffer[1] = '}';  // NOLINT
+                            return 2;
+                        };
+                    });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+
+    STRCMP_EQUAL("{}", webRequestMock.receiveChunked(16).c_str());
+}
+
+TEST(WebPageMainTest, getSensorDataSendsDownsampledSelectionAtOnce)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams
+        = {{"identifier", "123"}, {"maxPoints", "300"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
+    mock("WebRequestMock")
+        .expectOneCall("send")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json")
+        .withParameter("content", R"({"some": "data"})");
+
+    sut.startServer(
+        []([[maybe_unused]] const ReadingsQuery &query)
+        { return std::make_shared<const std::string>(R"({"some": "data"})"); },
+        {}, {}, {},
+        []([[maybe_unused]] const ReadingsQuery &query) -> IWebRequest::Filler
+        {
+            FAIL("downsampled selection isn't streamed");
+            return {};
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+}
+
+TEST(WebPageMainTest, getSensorDataInEncodingFromAcceptHeader)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"identifier", "123"}};
+    std::string accept = "application/x-unknown, application/octet-stream;q=0.9, */*";
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock")
+        .expectOneCall("getHeader")
+        .withParameter("name", "Accept")
+        .andReturnValue(&accept);
+    expectVaryOnAccept();
+    mock("WebRequestMock")
+        .expectOneCall("send")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/octet-stream")
+        .withParameter("content", "packed");
+
+    ReadingsQuery receivedQuery{};
+    sut.startServer(
+        [&receivedQuery](const ReadingsQuery &query)
+        {
+            receivedQuery = query;
+            return std::make_shared<const std::string>("packed");
+        },
+        {}, {}, {},
+        []([[maybe_unused]] const ReadingsQuery &query) -> IWebRequest::Filler
+        {
+            FAIL("only JSON is streamed");
+            return {};
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+
+    CHECK_TRUE(receivedQuery.encoding == ReadingsQuery::Encoding::PACKED);
+}
+
+TEST(WebPageMainTest, getAllSensorsDataInOneResponse)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams
+        = {{"from", "1000"}, {"maxPoints", "300"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
+    mock("ConfStorageMock")
+        .expectOneCall("getSensorsMapping")
+        .andReturnValue(R"({"1":"kitchen","2":"garden"})");
+    mock("WebRequestMock")
+        .expectOneCall("sendChunked")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json");
+
+    std::vector<ReadingsQuery> receivedQueries;
+    sut.startServer(
+        [&receivedQueries](const ReadingsQuery &query)
+        {
+            receivedQueries.push_back(query);
+            return std::make_shared<const std::string>(
+                R"({"identifier":)" + std::to_string(query.identifier) + "}");
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData/all", webRequestMock);
+
+    STRCMP_EQUAL(
+        R"({"names":{"1":"kitchen","2":"garden"},"sensors":[{"identifier":1},{"identifier":2}]})",
+        webRequestMock.receiveChunked(3).c_str());
+    CHECK_EQUAL(2, receivedQueries.size());
+    CHECK_EQUAL(1000, receivedQueries[1].from.value());
+    CHECK_EQUAL(300, receivedQueries[1].maxPoints.value());
+}
+
+TEST(WebPageMainTest, getAllSensorsDataSkipsBadIdentifiers)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    expectVaryOnAccept();
+    mock("ConfStorageMock")
+        .expectOneCall("getSensorsMapping")
+        .andReturnValue(R"({"1":"kitchen","x":"bad","99999999999999999999":"big"})");
+    mock("WebRequestMock")
+        .expectOneCall("sendChunked")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json");
+
+    std::vector<ReadingsQuery> receivedQueries;
+    sut.startServer(
+        [&receivedQueries](const ReadingsQuery &query)
+        {
+            receivedQueries.push_back(query);
+            return std::make_shared<const std::string>("{}");
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData/all", webRequestMock);
+
+    webRequestMock.receiveChunked(3);
+    CHECK_EQUAL(1, receivedQueries.size());
+    CHECK_EQUAL(1, receivedQueries[0].identifier);
+}
+
+TEST(WebPageMainTest, getAllSensorsDataPackedWithLengths)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"maxPoints", "300"}};
+    std::string accept = "application/octet-stream";
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock")
+        .expectOneCall("getHeader")
+        .withParameter("name", "Accept")
+        .andReturnValue(&accept);
+    expectVaryOnAccept();
+    mock("ConfStorageMock").expectOneCall("getSensorsMapping").andReturnValue(R"({"7":"a"})");
+    mock("WebRequestMock")
+        .expectOneCall("sendChunked")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/octet-stream");
+
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query)
+                    { return std::make_shared<const std::string>("packed"); });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData/all", webRequestMock);
+
+    const std::string expected = std::string("\x09\0\0\0", 4) + R"({"7":"a"})"
+                                 + std::string("\x06\0\0\0", 4) + "packed";
+    CHECK_TRUE(expected == webRequestMock.receiveChunked(5));
+}
+
+TEST(WebPageMainTest, NotGetSensorDataWhenMaxPointsIsZero)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams
+        = {{"identifier", "123"}, {"maxPoints", "0"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_BAD_REQ);
+
+    sut.startServer(
+        []([[maybe_unused]] const ReadingsQuery &query)
         {
-            return R"({"some": "data"})";
+            return std::make_shared<const std::string>(R"({"some": "data"})");
         });
 
     WebRequestMock webRequestMock;
     webServerMock->callGet("/sensorData", webRequestMock);
 }
+
+TEST(WebPageMainTest, NotGetSensorDataWhenResolutionIsUnknown)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams
+        = {{"identifier", "123"}, {"resolution", "fortnight"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_BAD_REQ);
+
+    sut.startServer(
+        []([[maybe_unused]] const ReadingsQuery &query)
+        {
+            return std::make_shared<const std::string>(R"({"some": "data"})");
+        });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/sensorData", webRequestMock);
+}
+
+TEST(WebPageMainTest, getSensorStats)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"identifier", "123"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock")
+        .expectOneCall("send")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json")
+        .withParameter("content", R"({"stats": "data"})");
+
+    IDType receivedIdentifier = 0;
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query) { return nullptr; },
+                    [&receivedIdentifier](IDType identifier)
+                    {
+                        receivedIdentifier = identifier;
+                        return R"({"stats": "data"})";
+                    });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/stats", webRequestMock);
+
+    CHECK_EQUAL(123, receivedIdentifier);
+}
+
+TEST(WebPageMainTest, NotGetSensorStatsWhenIdentifierIsWrong)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"identifier", "abc"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_BAD_REQ);
+
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query) { return nullptr; },
+                    []([[maybe_unused]] IDType identifier) { return std::string(); });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/stats", webRequestMock);
+}
+
+TEST(WebPageMainTest, getSensorQuantiles)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"identifier", "123"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock")
+        .expectOneCall("send")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json")
+        .withParameter("content", R"({"quantiles": "data"})");
+
+    IDType receivedIdentifier = 0;
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query) { return nullptr; },
+                    []([[maybe_unused]] IDType identifier) { return std::string(); },
+                    [&receivedIdentifier](IDType identifier)
+                    {
+                        receivedIdentifier = identifier;
+                        return R"({"quantiles": "data"})";
+                    });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/quantiles", webRequestMock);
+
+    CHECK_EQUAL(123, receivedIdentifier);
+}
+
+TEST(WebPageMainTest, getSensorHeatmap)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"identifier", "123"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock")
+        .expectOneCall("send")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json")
+        .withParameter("content", R"({"heatmap": "data"})");
+
+    IDType receivedIdentifier = 0;
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query) { return nullptr; },
+                    {}, {},
+                    [&receivedIdentifier](IDType identifier)
+                    {
+                        receivedIdentifier = identifier;
+                        return R"({"heatmap": "data"})";
+                    });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/heatmap", webRequestMock);
+
+    CHECK_EQUAL(123, receivedIdentifier);
+}
+
+TEST(WebPageMainTest, getArchiveStreamsRawJsonOfRange)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams
+        = {{"identifier", "123"}, {"from", "1000"}, {"to", "2000"}, {"resolution", "day"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("getHeader").withParameter("name", "Accept");
+    mock("WebRequestMock")
+        .expectOneCall("sendChunked")
+        .withParameter("code", HTML_OK)
+        .withParameter("contentType", "application/json");
+
+    ReadingsQuery receivedQuery{};
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query) { return nullptr; }, {}, {},
+                    {}, {}, {},
+                    [&receivedQuery](const ReadingsQuery &query) -> IWebRequest::Filler
+                    {
+                        receivedQuery = query;
+                        return [](uint8_t *, std::size_t) -> std::size_t { return 0; };
+                    });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/archive", webRequestMock);
+
+    CHECK_EQUAL(123, receivedQuery.identifier);
+    CHECK_EQUAL(1000, receivedQuery.from.value());
+    CHECK_EQUAL(2000, receivedQuery.to.value());
+    CHECK_TRUE(receivedQuery.resolution == ReadingsQuery::Resolution::RAW);
+}
+
+TEST(WebPageMainTest, getArchiveWithoutIdentifierIsBadRequest)  // NOLINT
+{
+    WebPageMain sut(arduino32AdpMock, webServerMock, std::make_unique<ResourcesMock>(),
+                    confStorageMock);
+
+    mockOnGetAndOnPostCalls();
+
+    std::map<std::string, std::string> htmlGetRequestParams = {{"from", "1000"}};
+
+    mock("WebServerMock").expectOneCall("setupEventsSource").ignoreOtherParameters();
+    mock("WebServerMock").expectOneCall("start").ignoreOtherParameters();
+    mock("WebRequestMock").expectOneCall("getParams").andReturnValue(&htmlGetRequestParams);
+    mock("WebRequestMock").expectOneCall("send").withParameter("code", HTML_BAD_REQ);
+
+    sut.startServer([]([[maybe_unused]] const ReadingsQuery &query) { return nullptr; }, {}, {},
+                    {}, {}, {},
+                    []([[maybe_unused]] const ReadingsQuery &query) -> IWebRequest::Filler
+                    { return {}; });
+
+    WebRequestMock webRequestMock;
+    webServerMock->callGet("/archive", webRequestMock);
+}